@@ -10,6 +10,9 @@ IO_SOURCES = \
 	$(IO_SRC_DIR)/BufferedLineReader.cpp \
 	$(IO_SRC_DIR)/FileDescriptor.cxx \
 	$(IO_SRC_DIR)/FileReader.cxx \
+	$(IO_SRC_DIR)/uring/Ring.cpp \
+	$(IO_SRC_DIR)/uring/ReadAhead.cpp \
+	$(IO_SRC_DIR)/ReadAheadReader.cpp \
 	$(IO_SRC_DIR)/BufferedOutputStream.cxx \
 	$(IO_SRC_DIR)/FileOutputStream.cxx \
 	$(IO_SRC_DIR)/GunzipReader.cxx \
@@ -178,6 +178,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Task/RoutePlannerGlue.cpp \
 	$(SRC)/Task/ProtectedRoutePlanner.cpp \
 	$(SRC)/Task/TaskStore.cpp \
+	$(SRC)/Task/TaskIndex.cpp \
 	$(SRC)/Task/TypeStrings.cpp \
 	$(SRC)/Task/ValidationErrorStrings.cpp \
 	\
@@ -243,9 +244,9 @@ XCSOAR_SOURCES := \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
-	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/FLARM/Friends.cpp \
 	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
 	$(SRC)/FLARM/Global.cpp \
 	$(SRC)/FLARM/Glue.cpp \
 	$(SRC)/Computer/CuComputer.cpp \
@@ -256,13 +257,19 @@ XCSOAR_SOURCES := \
 	$(SRC)/Computer/ContestComputer.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/WarningThread.cpp \
 	$(SRC)/Computer/ThermalLocator.cpp \
 	$(SRC)/Computer/ThermalBase.cpp \
 	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/LiftMap.cpp \
+	$(SRC)/Computer/LiftMapFile.cpp \
+	$(SRC)/Computer/LiftMapGlue.cpp \
+	$(SRC)/Computer/LiftMapComputer.cpp \
 	$(SRC)/Computer/LogComputer.cpp \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioCalculator.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/AdaptiveSchedule.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
 	$(SRC)/Computer/GlideComputerAirData.cpp \
@@ -285,6 +292,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/util/MD5.cpp \
 	$(SRC)/Logger/NMEALogger.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/Logger/ExternalLogger.cpp \
 	$(SRC)/Logger/FlightLogger.cpp \
 	$(SRC)/Logger/GlueFlightLogger.cpp \
@@ -318,6 +326,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/TeamActions.cpp \
 	$(SRC)/Waypoint/WaypointList.cpp \
 	$(SRC)/Waypoint/WaypointListBuilder.cpp \
+	$(SRC)/Waypoint/WaypointListQuery.cpp \
 	$(SRC)/Waypoint/WaypointFilter.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
 	$(SRC)/Waypoint/SaveGlue.cpp \
@@ -439,6 +448,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Renderer/ChartRenderer.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
+	$(SRC)/Renderer/TerrainTileCache.cpp \
 	$(SRC)/Renderer/FAITriangleAreaRenderer.cpp \
 	$(SRC)/Renderer/OZRenderer.cpp \
 	$(SRC)/Renderer/TaskPointRenderer.cpp \
@@ -446,6 +456,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceVertexCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -503,6 +514,7 @@ XCSOAR_SOURCES := \
 	\
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/Rasp/RaspMapCache.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/Weather/Rasp/Providers.cpp \
@@ -632,6 +644,9 @@ XCSOAR_SOURCES := \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	\
 	$(SRC)/Repository/FileRepository.cpp \
 	$(SRC)/Repository/Parser.cpp \
@@ -645,6 +660,7 @@ XCSOAR_SOURCES := \
 	$(SRC)/Math/SunEphemeris.cpp \
 	\
 	$(SRC)/Screen/Layout.cpp \
+	$(SRC)/Screen/RenderProfiler.cpp \
 	$(SRC)/ui/control/TerminalWindow.cpp \
 	\
 	$(SRC)/Look/FontDescription.cpp \
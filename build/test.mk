@@ -86,6 +86,7 @@ $(call link-program,$(1),$(1))
 endef
 
 $(foreach name,$(HARNESS_PROGRAMS),$(eval $(call link-harness-program,$(name))))
+$(eval $(call link-harness-program,BenchmarkTaskEngine))
 
 TEST_NAMES = \
 	test_fixed \
@@ -102,8 +103,21 @@ TEST_NAMES = \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
 	TestLogger TestGRecord TestClimbAvCalc \
+	TestAdaptiveSchedule \
+	TestAsyncOutputStream \
+	TestReadAheadReader \
+	TestLineSplitter \
 	TestWaypointReader TestThermalBase \
+	TestThermalLocator \
+	TestLiftMap \
+	TestTaskIndex \
+	TestWaypointListQuery \
+	TestInputConfig \
+	TestXMLPullParser \
+	TestAudioAlgorithms \
+	TestTripleBuffer \
 	TestFlarmNet \
+	TestFlarmTrafficStore \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
@@ -151,6 +165,7 @@ $(eval $(call link-program,TestCRC,TEST_CRC))
 
 TEST_LEASTSQUARES_SOURCES = \
 	$(SRC)/Math/LeastSquares.cpp \
+	$(SRC)/Math/ConvexFilter.cpp \
 	$(SRC)/Math/XYDataStore.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLeastSquares.cpp
@@ -173,6 +188,7 @@ $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFE
 
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixReader.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestIGCParser.cpp
 TEST_IGC_PARSER_DEPENDS = MATH UTIL
@@ -345,6 +361,9 @@ TEST_REPLAY_TASK_SOURCES = \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(SRC)/Atmosphere/AirDensity.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
@@ -411,6 +430,15 @@ TEST_FLARM_NET_SOURCES = \
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_FLARM_TRAFFIC_STORE_SOURCES = \
+	$(SRC)/FLARM/TrafficStore.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmTrafficStore.cpp
+TEST_FLARM_TRAFFIC_STORE_DEPENDS = UTIL
+$(eval $(call link-program,TestFlarmTrafficStore,TEST_FLARM_TRAFFIC_STORE))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -424,6 +452,12 @@ TEST_CLIMB_AV_CALC_SOURCES = \
 TEST_CLIMB_AV_CALC_DEPENDS = MATH
 $(eval $(call link-program,TestClimbAvCalc,TEST_CLIMB_AV_CALC))
 
+TEST_ADAPTIVE_SCHEDULE_SOURCES = \
+	$(SRC)/Computer/AdaptiveSchedule.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAdaptiveSchedule.cpp
+$(eval $(call link-program,TestAdaptiveSchedule,TEST_ADAPTIVE_SCHEDULE))
+
 TEST_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -574,6 +608,87 @@ TEST_THERMALBASE_SOURCES = \
 TEST_THERMALBASE_DEPENDS = GEO MATH THREAD
 $(eval $(call link-program,TestThermalBase,TEST_THERMALBASE))
 
+TEST_THERMAL_LOCATOR_SOURCES = \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestThermalLocator.cpp
+TEST_THERMAL_LOCATOR_DEPENDS = GEO MATH
+$(eval $(call link-program,TestThermalLocator,TEST_THERMAL_LOCATOR))
+
+TEST_LIFT_MAP_SOURCES = \
+	$(SRC)/Computer/LiftMap.cpp \
+	$(SRC)/Computer/LiftMapFile.cpp \
+	$(SRC)/Computer/LiftMapComputer.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/MoreData.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLiftMap.cpp
+TEST_LIFT_MAP_DEPENDS = IO OS GEO MATH TIME UTIL
+$(eval $(call link-program,TestLiftMap,TEST_LIFT_MAP))
+
+TEST_TASK_INDEX_SOURCES = \
+	$(SRC)/Task/TaskIndex.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTaskIndex.cpp
+TEST_TASK_INDEX_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestTaskIndex,TEST_TASK_INDEX))
+
+TEST_WAYPOINT_LIST_QUERY_SOURCES = \
+	$(SRC)/Waypoint/WaypointFilter.cpp \
+	$(SRC)/Waypoint/WaypointList.cpp \
+	$(SRC)/Waypoint/WaypointListBuilder.cpp \
+	$(SRC)/Waypoint/WaypointListQuery.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointListQuery.cpp
+TEST_WAYPOINT_LIST_QUERY_DEPENDS = TASK ROUTE GLIDE WAYPOINT GEO TIME MATH UTIL
+$(eval $(call link-program,TestWaypointListQuery,TEST_WAYPOINT_LIST_QUERY))
+
+TEST_INPUT_CONFIG_SOURCES = \
+	$(SRC)/Input/InputKeys.cpp \
+	$(SRC)/Input/InputConfig.cpp \
+	$(SRC)/Input/InputParser.cpp \
+	$(SRC)/Menu/MenuData.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestInputConfig.cpp
+TEST_INPUT_CONFIG_CPPFLAGS = $(SCREEN_CPPFLAGS)
+TEST_INPUT_CONFIG_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestInputConfig,TEST_INPUT_CONFIG))
+
+TEST_XML_PULL_PARSER_SOURCES = \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestXMLPullParser.cpp
+TEST_XML_PULL_PARSER_DEPENDS = IO OS GEO MATH UTIL
+$(eval $(call link-program,TestXMLPullParser,TEST_XML_PULL_PARSER))
+
+TEST_AUDIO_ALGORITHMS_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAudioAlgorithms.cpp
+TEST_AUDIO_ALGORITHMS_DEPENDS = MATH
+$(eval $(call link-program,TestAudioAlgorithms,TEST_AUDIO_ALGORITHMS))
+
+TEST_TRIPLE_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestTripleBuffer.cpp
+TEST_TRIPLE_BUFFER_DEPENDS = THREAD
+$(eval $(call link-program,TestTripleBuffer,TEST_TRIPLE_BUFFER))
+
 TEST_EARTH_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestEarth.cpp
@@ -620,6 +735,7 @@ $(eval $(call link-program,TestRadixTree,TEST_RADIX_TREE))
 TEST_LOGGER_SOURCES = \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -632,9 +748,29 @@ TEST_LOGGER_SOURCES = \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestLogger.cpp
-TEST_LOGGER_DEPENDS = IO OS GEO MATH UTIL
+TEST_LOGGER_DEPENDS = IO OS THREAD GEO MATH UTIL
 $(eval $(call link-program,TestLogger,TEST_LOGGER))
 
+TEST_ASYNC_OUTPUT_STREAM_SOURCES = \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestAsyncOutputStream.cpp
+TEST_ASYNC_OUTPUT_STREAM_DEPENDS = IO OS THREAD UTIL
+$(eval $(call link-program,TestAsyncOutputStream,TEST_ASYNC_OUTPUT_STREAM))
+
+TEST_READ_AHEAD_READER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestReadAheadReader.cpp
+TEST_READ_AHEAD_READER_DEPENDS = IO OS UTIL
+$(eval $(call link-program,TestReadAheadReader,TEST_READ_AHEAD_READER))
+
+TEST_LINE_SPLITTER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLineSplitter.cpp
+TEST_LINE_SPLITTER_DEPENDS = UTIL
+$(eval $(call link-program,TestLineSplitter,TEST_LINE_SPLITTER))
+
 TEST_GRECORD_SOURCES = \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/util/MD5.cpp \
@@ -654,7 +790,6 @@ TEST_DRIVER_SOURCES = \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/FLARM/Traffic.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
-	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/NMEA/Info.cpp \
 	$(SRC)/NMEA/GPSState.cpp \
 	$(SRC)/NMEA/Attitude.cpp \
@@ -709,10 +844,11 @@ TEST_TRACE_SOURCES = \
 	$(SRC)/Engine/Trace/Point.cpp \
 	$(SRC)/Engine/Trace/Trace.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixReader.cpp \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
 	$(TEST_SRC_DIR)/Printing.cpp \
 	$(TEST_SRC_DIR)/TestTrace.cpp
-TEST_TRACE_DEPENDS = IO OS GEO MATH UTIL
+TEST_TRACE_DEPENDS = OS IO GEO MATH UTIL
 $(eval $(call link-program,TestTrace,TEST_TRACE))
 
 FLIGHT_TABLE_SOURCES = \
@@ -735,6 +871,12 @@ DEBUG_PROGRAM_NAMES = \
 	FlightTable \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkIGCParser \
+	BenchmarkLineSplitter \
+	BenchmarkAudio \
+	BenchmarkFlarmTraffic \
+	BenchmarkXMLParser \
+	BenchmarkTaskEngine \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -848,6 +990,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixReader.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -921,6 +1064,75 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_IGC_PARSER_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCFixReader.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIGCParser.cpp
+BENCHMARK_IGC_PARSER_DEPENDS = OS IO GEO MATH UTIL
+$(eval $(call link-program,BenchmarkIGCParser,BENCHMARK_IGC_PARSER))
+
+BENCHMARK_LINE_SPLITTER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(TEST_SRC_DIR)/BenchmarkLineSplitter.cpp
+BENCHMARK_LINE_SPLITTER_DEPENDS = OS IO UTIL
+$(eval $(call link-program,BenchmarkLineSplitter,BENCHMARK_LINE_SPLITTER))
+
+BENCHMARK_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/Device/Driver/FLARM/StaticParser.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/GPSState.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/FLARM/TrafficStore.cpp \
+	$(SRC)/FLARM/FlarmDetails.cpp \
+	$(SRC)/FLARM/Friends.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetRecord.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/Projection/Projection.cpp \
+	$(SRC)/Projection/WindowProjection.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FlarmTrafficGenerator.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFlarmTraffic.cpp
+BENCHMARK_FLARM_TRAFFIC_DEPENDS = GEO MATH OS IO UTIL TIME
+$(eval $(call link-program,BenchmarkFlarmTraffic,BENCHMARK_FLARM_TRAFFIC))
+
+BENCHMARK_XML_PARSER_SOURCES = \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
+	$(TEST_SRC_DIR)/BenchmarkXMLParser.cpp
+BENCHMARK_XML_PARSER_DEPENDS = IO OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkXMLParser,BENCHMARK_XML_PARSER))
+
+BENCHMARK_AUDIO_SOURCES = \
+	$(SRC)/Audio/ToneSynthesiser.cpp \
+	$(SRC)/Audio/VarioSynthesiser.cpp \
+	$(TEST_SRC_DIR)/BenchmarkAudio.cpp
+BENCHMARK_AUDIO_DEPENDS = OS MATH UTIL
+$(eval $(call link-program,BenchmarkAudio,BENCHMARK_AUDIO))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1310,7 +1522,6 @@ RUN_DEVICE_DRIVER_SOURCES = \
 	$(SRC)/NMEA/Checksum.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/IGC/Generator.cpp \
-	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
@@ -1556,12 +1767,12 @@ $(eval $(call link-program,lxn2igc,LXN2IGC))
 RUN_IGC_WRITER_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(SRC)/Version.cpp \
-	$(SRC)/FLARM/FlarmCalculations.cpp \
 	$(SRC)/Computer/ClimbAverageCalculator.cpp \
 	$(SRC)/IGC/IGCFix.cpp \
 	$(SRC)/IGC/IGCWriter.cpp \
 	$(SRC)/IGC/IGCString.cpp \
 	$(SRC)/IGC/Generator.cpp \
+	$(SRC)/Logger/AsyncOutputStream.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/GRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
@@ -1654,6 +1865,9 @@ RUN_TASK_SOURCES = \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(SRC)/Engine/Util/Gradient.cpp \
 	$(DEBUG_REPLAY_SOURCES) \
 	$(TEST_SRC_DIR)/FakeTerrain.cpp \
@@ -1807,12 +2021,14 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/TransparentRendererCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
 	$(SRC)/Renderer/BackgroundRenderer.cpp \
+	$(SRC)/Renderer/TerrainTileCache.cpp \
 	$(SRC)/LocalPath.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Projection/CompareProjection.cpp \
 	$(SRC)/Weather/Rasp/RaspStore.cpp \
 	$(SRC)/Weather/Rasp/RaspCache.cpp \
+	$(SRC)/Weather/Rasp/RaspMapCache.cpp \
 	$(SRC)/Weather/Rasp/RaspRenderer.cpp \
 	$(SRC)/Weather/Rasp/RaspStyle.cpp \
 	$(SRC)/MapWindow/MapWindow.cpp \
@@ -1828,6 +2044,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowTraffic.cpp \
 	$(SRC)/MapWindow/MapWindowTrail.cpp \
 	$(SRC)/MapWindow/MapWindowWaypoints.cpp \
+	$(SRC)/Screen/RenderProfiler.cpp \
 	$(SRC)/MapWindow/MapCanvas.cpp \
 	$(SRC)/MapWindow/StencilMapCanvas.cpp \
 	$(SRC)/Renderer/FAITriangleAreaRenderer.cpp \
@@ -1837,6 +2054,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRenderer.cpp \
 	$(SRC)/Renderer/AirspaceRendererGL.cpp \
+	$(SRC)/Renderer/AirspaceVertexCache.cpp \
 	$(SRC)/Renderer/AirspaceRendererOther.cpp \
 	$(SRC)/Renderer/AirspaceLabelList.cpp \
 	$(SRC)/Renderer/AirspaceLabelRenderer.cpp \
@@ -1921,6 +2139,9 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/RadioFrequency.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
@@ -2290,6 +2511,9 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/XML/Parser.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(SRC)/Dialogs/WidgetDialog.cpp \
 	$(SRC)/Dialogs/dlgAnalysis.cpp \
 	$(SRC)/Dialogs/DialogSettings.cpp \
@@ -2323,9 +2547,13 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Computer/ContestComputer.cpp \
 	$(SRC)/Computer/TraceComputer.cpp \
 	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/WarningThread.cpp \
 	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/LiftMap.cpp \
+	$(SRC)/Computer/LiftMapComputer.cpp \
 	$(SRC)/Computer/AverageVarioComputer.cpp \
 	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/AdaptiveSchedule.cpp \
 	$(SRC)/Computer/GlideComputer.cpp \
 	$(SRC)/Computer/GlideComputerBlackboard.cpp \
 	$(SRC)/Computer/TaskComputer.cpp \
@@ -2574,8 +2802,9 @@ EMULATE_DEVICE_SOURCES = \
 	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
 	$(TEST_SRC_DIR)/DebugPort.cpp \
+	$(TEST_SRC_DIR)/FlarmTrafficGenerator.cpp \
 	$(TEST_SRC_DIR)/EmulateDevice.cpp
-EMULATE_DEVICE_DEPENDS = PORT ASYNC LIBNET IO OS THREAD TIME UTIL
+EMULATE_DEVICE_DEPENDS = PORT ASYNC LIBNET IO OS THREAD TIME GEO MATH UTIL
 $(eval $(call link-program,EmulateDevice,EMULATE_DEVICE))
 
 FEED_FLYNET_DATA_SOURCES = \
@@ -2601,6 +2830,9 @@ TASK_INFO_SOURCES = \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
 	$(TEST_SRC_DIR)/TaskInfo.cpp
 TASK_INFO_DEPENDS = TASK ROUTE GLIDE WAYPOINT IO OS GEO TIME MATH UTIL
@@ -2615,6 +2847,9 @@ DUMP_TASK_FILE_SOURCES = \
 	$(SRC)/XML/Writer.cpp \
 	$(SRC)/XML/DataNode.cpp \
 	$(SRC)/XML/DataNodeXML.cpp \
+	$(SRC)/XML/PullParser.cpp \
+	$(SRC)/XML/FlatDocument.cpp \
+	$(SRC)/XML/DataNodeFlat.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/Task/Serialiser.cpp \
 	$(SRC)/Task/Deserialiser.cpp \
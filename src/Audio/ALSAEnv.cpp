@@ -37,9 +37,12 @@ namespace ALSAEnv
 
 static constexpr char ALSA_DEVICE_ENV[] = "ALSA_DEVICE";
 static constexpr char ALSA_LATENCY_ENV[] = "ALSA_LATENCY";
+static constexpr char ALSA_PERIODS_ENV[] = "ALSA_PERIODS";
 
 static constexpr char DEFAULT_ALSA_DEVICE[] = "default";
 static constexpr unsigned DEFAULT_ALSA_LATENCY = 100000;
+static constexpr unsigned DEFAULT_ALSA_PERIODS = 4;
+static constexpr unsigned MIN_ALSA_PERIODS = 2;
 
 
 static const char *InitALSADeviceName()
@@ -64,7 +67,7 @@ static unsigned InitALSALatency()
     latency = ParseUnsigned(latency_env_value, &p);
     if (*p != '\0') {
       LogFormat("Invalid %s value \"%s\"", ALSA_LATENCY_ENV, latency_env_value);
-      return false;
+      latency = DEFAULT_ALSA_LATENCY;
     }
   }
   LogFormat("Using ALSA PCM latency %u μs (use environment variable "
@@ -72,6 +75,23 @@ static unsigned InitALSALatency()
   return latency;
 }
 
+static unsigned InitALSAPeriods()
+{
+  unsigned periods = DEFAULT_ALSA_PERIODS;
+  const char *periods_env_value = getenv(ALSA_PERIODS_ENV);
+  if ((nullptr != periods_env_value) && ('\0' != *periods_env_value)) {
+    char *p;
+    periods = ParseUnsigned(periods_env_value, &p);
+    if (*p != '\0' || periods < MIN_ALSA_PERIODS) {
+      LogFormat("Invalid %s value \"%s\"", ALSA_PERIODS_ENV, periods_env_value);
+      periods = DEFAULT_ALSA_PERIODS;
+    }
+  }
+  LogFormat("Using %u ALSA PCM periods per buffer (use environment variable "
+                "%s to override)", periods, ALSA_PERIODS_ENV);
+  return periods;
+}
+
 const char *GetALSADeviceName()
 {
   static const char *alsa_device = InitALSADeviceName();
@@ -85,4 +105,10 @@ unsigned GetALSALatency()
   return alsa_latency;
 }
 
+unsigned GetALSAPeriods()
+{
+  static unsigned alsa_periods = InitALSAPeriods();
+  return alsa_periods;
+}
+
 }
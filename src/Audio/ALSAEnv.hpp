@@ -50,6 +50,18 @@ namespace ALSAEnv
    * unsigned, or 10000 if not set, or unparsable. The unit is μs.
    */
   unsigned GetALSALatency();
+
+  /**
+   * Get the desired number of ALSA periods per buffer.  The period
+   * time is the latency divided by this value; it determines how
+   * often the audio thread wakes up, and how late a parameter change
+   * can be heard at most.  More periods mean more wakeups, but less
+   * delay between a SetVario() call and the speaker.
+   *
+   * @return Value of the environment variable "ALSA_PERIODS", parsed
+   * as unsigned, or 4 if not set, unparsable or less than 2.
+   */
+  unsigned GetALSAPeriods();
 }
 
 #endif
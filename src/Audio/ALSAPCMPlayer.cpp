@@ -45,13 +45,22 @@ ALSAPCMPlayer::~ALSAPCMPlayer()
   Stop();
 }
 
+void
+ALSAPCMPlayer::CountXrun(std::atomic<unsigned> &xrun_count)
+{
+  const unsigned n = xrun_count.fetch_add(1, std::memory_order_relaxed) + 1;
+  if ((n & (n - 1)) == 0)
+    LogFormat("ALSA PCM buffer underrun (%u so far)", n);
+}
+
 bool
-ALSAPCMPlayer::TryRecoverFromError(snd_pcm_t &alsa_handle, int error)
+ALSAPCMPlayer::TryRecoverFromError(snd_pcm_t &alsa_handle, int error,
+                                   std::atomic<unsigned> &xrun_count)
 {
   assert(error < 0);
 
   if (-EPIPE == error)
-    LogFormat("ALSA PCM buffer underrun");
+    CountXrun(xrun_count);
   else if ((-EINTR == error) || (-ESTRPIPE == error))
     LogFormat("ALSA PCM error: %s - trying to recover",
               snd_strerror(error));
@@ -64,7 +73,8 @@ ALSAPCMPlayer::TryRecoverFromError(snd_pcm_t &alsa_handle, int error)
 
   int recover_error = snd_pcm_recover(&alsa_handle, error, 1);
   if (0 == recover_error) {
-    LogFormat("ALSA PCM successfully recovered");
+    if (-EPIPE != error)
+      LogFormat("ALSA PCM successfully recovered");
     return true;
   } else {
     LogFormat("snd_pcm_recover(0x%p, %d, 1) failed: %d - %s",
@@ -78,7 +88,7 @@ ALSAPCMPlayer::TryRecoverFromError(snd_pcm_t &alsa_handle, int error)
 
 bool
 ALSAPCMPlayer::WriteFrames(snd_pcm_t &alsa_handle, int16_t *buffer,
-                           size_t n, bool try_recover_on_error)
+                           size_t n, std::atomic<unsigned> *xrun_count)
 {
   assert(n > 0);
   assert(nullptr != buffer);
@@ -87,8 +97,9 @@ ALSAPCMPlayer::WriteFrames(snd_pcm_t &alsa_handle, int16_t *buffer,
       snd_pcm_writei(&alsa_handle, buffer, static_cast<snd_pcm_uframes_t>(n));
   if (write_ret < static_cast<snd_pcm_sframes_t>(n)) {
     if (write_ret < 0) {
-      if (try_recover_on_error) {
-        return TryRecoverFromError(alsa_handle, static_cast<int>(write_ret));
+      if (nullptr != xrun_count) {
+        return TryRecoverFromError(alsa_handle, static_cast<int>(write_ret),
+                                   *xrun_count);
       } else {
         LogFormat("snd_pcm_writei(0x%p, 0x%p, %u) failed: %d - %s",
                   &alsa_handle,
@@ -152,7 +163,7 @@ ALSAPCMPlayer::OnSocketReady(unsigned) noexcept
 bool
 ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
                              bool big_endian_source, unsigned latency,
-                             unsigned &channels) {
+                             unsigned periods, unsigned &channels) {
   /* adoption of alsa-libs's snd_pcm_set_params() function, which is not
    * available on SALSA, with a few detail enhancements. */
 
@@ -241,7 +252,7 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
                                                       &latency,
                                                       nullptr);
   if (0 != alsa_error) {
-    unsigned period_time = latency / 4;
+    unsigned period_time = latency / periods;
     alsa_error = snd_pcm_hw_params_set_period_time_near(&alsa_handle,
                                                         hw_params,
                                                         &period_time,
@@ -270,7 +281,7 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
       return false;
     }
 
-    buffer_size = period_size * 4;
+    buffer_size = period_size * periods;
     alsa_error = snd_pcm_hw_params_set_buffer_size_near(&alsa_handle,
                                                         hw_params,
                                                         &buffer_size);
@@ -320,7 +331,7 @@ ALSAPCMPlayer::SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
       return false;
     }
 
-    unsigned period_time = latency / 4;
+    unsigned period_time = latency / periods;
     alsa_error = snd_pcm_hw_params_set_period_time_near(&alsa_handle,
                                                         hw_params,
                                                         &period_time,
@@ -430,6 +441,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
 
       switch (snd_pcm_state(alsa_handle.get())) {
       case SND_PCM_STATE_XRUN:
+        CountXrun(xrun_count);
         if (0 != snd_pcm_prepare(alsa_handle.get()))
           return;
         else {
@@ -485,11 +497,12 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   }
 
   unsigned latency = ALSAEnv::GetALSALatency();
+  unsigned periods = ALSAEnv::GetALSAPeriods();
 
   channels = 1;
   bool big_endian_source = _source.IsBigEndian();
   if (!SetParameters(*new_alsa_handle, new_sample_rate, big_endian_source,
-                     latency, channels))
+                     latency, periods, channels))
     return false;
 
   snd_pcm_sframes_t n_available = snd_pcm_avail(new_alsa_handle.get());
@@ -528,7 +541,7 @@ ALSAPCMPlayer::Start(PCMDataSource &_source)
   }
 
   if (!WriteFrames(*new_alsa_handle, buffer.get(),
-                   static_cast<size_t>(n_available), false))
+                   static_cast<size_t>(n_available), nullptr))
     return false;
 
   alsa_handle = std::move(new_alsa_handle);
@@ -557,4 +570,21 @@ ALSAPCMPlayer::Stop()
   });
 
   source = nullptr;
+
+  const unsigned n_xruns = GetXrunCount();
+  if (n_xruns > 0)
+    LogFormat("ALSA PCM: %u buffer underruns so far", n_xruns);
+}
+
+unsigned
+ALSAPCMPlayer::GetDelayFrames() const noexcept
+{
+  if (!alsa_handle)
+    return 0;
+
+  snd_pcm_sframes_t delay;
+  if (snd_pcm_delay(alsa_handle.get(), &delay) != 0 || delay < 0)
+    return 0;
+
+  return static_cast<unsigned>(delay);
 }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "event/SocketEvent.hxx"
 #include "util/Compiler.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -63,27 +64,48 @@ class ALSAPCMPlayer : public PCMPlayer {
 
   std::forward_list<SocketEvent> poll_events;
 
+  /**
+   * The number of buffer underruns since construction.  Written by
+   * the event loop thread, may be read by any thread.
+   */
+  std::atomic<unsigned> xrun_count{0};
+
   void StopEventHandling();
 
-  static bool TryRecoverFromError(snd_pcm_t &alsa_handle, int error);
+  /**
+   * Count one buffer underrun and log it.  To avoid flooding the log
+   * when the system is overloaded, only the first and every
+   * power-of-two occurrence are logged.
+   */
+  static void CountXrun(std::atomic<unsigned> &xrun_count);
+
+  static bool TryRecoverFromError(snd_pcm_t &alsa_handle, int error,
+                                  std::atomic<unsigned> &xrun_count);
+
   bool TryRecoverFromError(int error) {
     assert(alsa_handle);
-    return TryRecoverFromError(*alsa_handle, error);
+    return TryRecoverFromError(*alsa_handle, error, xrun_count);
   }
 
+  /**
+   * @param xrun_count if not nullptr, then try to recover from
+   * errors, and count buffer underruns there
+   */
   static bool WriteFrames(snd_pcm_t &alsa_handle, int16_t *buffer,
-                          size_t n, bool try_recover_on_error = true);
-  bool WriteFrames(size_t n, bool try_recover_on_error = true) {
+                          size_t n,
+                          std::atomic<unsigned> *xrun_count);
+
+  bool WriteFrames(size_t n) {
     assert(alsa_handle);
     assert(buffer);
-    return WriteFrames(*alsa_handle, buffer.get(), n, try_recover_on_error);
+    return WriteFrames(*alsa_handle, buffer.get(), n, &xrun_count);
   }
 
   bool OnEvent();
 
   static bool SetParameters(snd_pcm_t &alsa_handle, unsigned sample_rate,
                             bool big_endian_source, unsigned latency,
-                            unsigned &channels);
+                            unsigned periods, unsigned &channels);
 
 public:
   explicit ALSAPCMPlayer(EventLoop &event_loop) noexcept;
@@ -93,6 +115,26 @@ public:
   bool Start(PCMDataSource &source) override;
   void Stop() override;
 
+  /**
+   * Returns the number of buffer underruns since this object was
+   * constructed.  May be called from any thread.
+   */
+  gcc_pure
+  unsigned GetXrunCount() const noexcept {
+    return xrun_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the number of frames which have been written to the
+   * device, but have not been played yet, i.e. the time a sample
+   * written now will take until it becomes audible.  Must be called
+   * from the event loop thread, e.g. from PCMDataSource::GetData().
+   *
+   * @return the delay in frames, or 0 if not playing
+   */
+  gcc_pure
+  unsigned GetDelayFrames() const noexcept;
+
 private:
   void OnSocketReady(unsigned events) noexcept;
 };
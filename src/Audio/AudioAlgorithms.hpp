@@ -35,6 +35,14 @@ Copyright_License {
 #include <cstddef>
 #include <cstdint>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
 /* Algorithms for processing audio data */
 
 /**
@@ -70,35 +78,157 @@ inline int16_t Clip(int32_t value) {
 }
 
 /**
- * Mix PCM data from a data source (which is read using the provided source
- * reader function) to a destination buffer (which already contains PCM data).
- *
- * The audio volume is lowered to the given percentage value.
- *
- * Performs cipping, if necessary.
+ * Convert a volume percentage to a gain factor for ApplyGainPCM()
+ * (fixed point, 1.0 = 32768).
  */
-template<typename SrcReadFuncT>
-inline void MixPCM(int16_t *dest, size_t num_frames,
-                   unsigned vol_percent, SrcReadFuncT src_reader) {
-  if (0 == vol_percent) {
-    std::fill(dest, dest + num_frames, 0);
-    return;
+constexpr int32_t
+VolumeToGain(unsigned vol_percent)
+{
+  return static_cast<int32_t>(vol_percent) * 32768 / 100;
+}
+
+/**
+ * Portable implementation of ApplyGainPCM(); also used for the
+ * remainder which the SIMD implementations leave over.
+ */
+template<bool byte_swap, bool mix>
+inline void
+ApplyGainPCMPortable(int16_t *dest, const int16_t *src, size_t n,
+                     int32_t gain)
+{
+  for (size_t i = 0; i < n; ++i) {
+    int32_t value = byte_swap
+      ? static_cast<int16_t>(GenericByteSwap16(src[i]))
+      : src[i];
+    value = (value * gain) >> 15;
+    if (mix)
+      value += dest[i];
+    dest[i] = Clip(value);
+  }
+}
+
+#ifdef __SSE2__
+
+template<bool byte_swap, bool mix, bool unity>
+gcc_always_inline
+inline void
+ApplyGainPCMSSE2(int16_t *dest, const int16_t *src, size_t n,
+                 int32_t gain)
+{
+  const __m128i v_gain = _mm_set1_epi16(static_cast<int16_t>(gain));
+
+  for (size_t i = 0; i < n; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    if (byte_swap)
+      v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+    if (!unity) {
+      /* 16x16 -> 32 bit products, scaled back and packed with
+         saturation */
+      const __m128i lo = _mm_mullo_epi16(v, v_gain);
+      const __m128i hi = _mm_mulhi_epi16(v, v_gain);
+      const __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+      const __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+      v = _mm_packs_epi32(p0, p1);
+    }
+
+    if (mix)
+      v = _mm_adds_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + i)));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), v);
   }
+}
+
+#endif
+
+#ifdef __ARM_NEON__
+
+template<bool byte_swap, bool mix, bool unity>
+gcc_always_inline
+inline void
+ApplyGainPCMNEON(int16_t *dest, const int16_t *src, size_t n,
+                 int32_t gain)
+{
+  const int16x4_t v_gain = vdup_n_s16(static_cast<int16_t>(gain));
+
+  for (size_t i = 0; i < n; i += 8) {
+    int16x8_t v = vld1q_s16(src + i);
+    if (byte_swap)
+      v = vreinterpretq_s16_u8(vrev16q_u8(vreinterpretq_u8_s16(v)));
+
+    if (!unity) {
+      const int32x4_t p0 = vshrq_n_s32(vmull_s16(vget_low_s16(v), v_gain), 15);
+      const int32x4_t p1 = vshrq_n_s32(vmull_s16(vget_high_s16(v), v_gain), 15);
+      v = vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1));
+    }
+
+    if (mix)
+      v = vqaddq_s16(v, vld1q_s16(dest + i));
 
-  for (size_t i = 0; i < num_frames; ++i) {
-    dest[i] += Clip(src_reader(i) * static_cast<int32_t>(vol_percent) / 100);
+    vst1q_s16(dest + i, v);
   }
 }
 
+#endif
+
+/**
+ * Scale PCM samples with a gain factor (see VolumeToGain()) and
+ * store (or mix) them into the destination buffer, with clipping.
+ * Uses SSE2 or NEON if available.
+ *
+ * @param byte_swap swap the byte order of the source samples
+ * @param mix add to the samples in the destination buffer instead
+ * of overwriting them
+ * @param dest the destination buffer; may be equal to #src
+ */
+template<bool byte_swap, bool mix>
+inline void
+ApplyGainPCM(int16_t *dest, const int16_t *src, size_t n, int32_t gain)
+{
+  assert(gain >= 0 && gain <= 32768);
+
+#if defined(__SSE2__) || defined(__ARM_NEON__)
+  /* the SIMD implementations process 8 samples at a time */
+  const size_t no = n & ~size_t(7);
+
+#ifdef __SSE2__
+  if (gain == 32768)
+    /* the gain does not fit into a 16 bit lane */
+    ApplyGainPCMSSE2<byte_swap, mix, true>(dest, src, no, gain);
+  else
+    ApplyGainPCMSSE2<byte_swap, mix, false>(dest, src, no, gain);
+#else
+  if (gain == 32768)
+    ApplyGainPCMNEON<byte_swap, mix, true>(dest, src, no, gain);
+  else
+    ApplyGainPCMNEON<byte_swap, mix, false>(dest, src, no, gain);
+#endif
+
+  dest += no;
+  src += no;
+  n -= no;
+#endif
+
+  ApplyGainPCMPortable<byte_swap, mix>(dest, src, n, gain);
+}
+
 /**
  * Mix PCM data from a given data source to a destination buffer
  * (which already contains PCM data).
  *
- * Performs cipping, if necessary.
+ * The audio volume is lowered to the given percentage value.
+ *
+ * Performs clipping, if necessary.
  */
 inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
                    unsigned vol_percent) {
-  MixPCM(dest, num_frames, vol_percent, [&src](size_t i) { return src[i]; });
+  if (0 == vol_percent) {
+    std::fill(dest, dest + num_frames, 0);
+    return;
+  }
+
+  ApplyGainPCM<false, true>(dest, src, num_frames,
+                            VolumeToGain(vol_percent));
 }
 
 /**
@@ -109,14 +239,17 @@ inline void MixPCM(int16_t *dest, const int16_t *src, size_t num_frames,
  * Use this function, if the source is big endian and the destination
  * is little endian, or vice versa.
  *
- * Performs cipping, if necessary.
+ * Performs clipping, if necessary.
  */
 inline void ByteSwapAndMixPCM(int16_t *dest, const int16_t *src,
                               size_t num_frames, unsigned vol_percent) {
-  MixPCM(dest, num_frames, vol_percent,
-         [&src](size_t i) {
-           return static_cast<int32_t>(GenericByteSwap16(src[i]));
-         });
+  if (0 == vol_percent) {
+    std::fill(dest, dest + num_frames, 0);
+    return;
+  }
+
+  ApplyGainPCM<true, true>(dest, src, num_frames,
+                           VolumeToGain(vol_percent));
 }
 
 /**
@@ -129,11 +262,11 @@ inline void LowerVolume(int16_t *buffer, size_t num_frames,
     return;
   }
 
-  for (size_t i = 0; i < num_frames; ++i) {
-    buffer[i] =
-        static_cast<int16_t>(
-            (static_cast<int32_t>(vol_percent) * buffer[i]) / 100);
-  }
+  if (100 == vol_percent)
+    return;
+
+  ApplyGainPCM<false, false>(buffer, buffer, num_frames,
+                             VolumeToGain(vol_percent));
 }
 
 /**
@@ -147,13 +280,8 @@ inline void ByteSwapAndLowerVolume(int16_t *buffer, size_t num_frames,
     return;
   }
 
-  for (size_t i = 0; i < num_frames; ++i) {
-    buffer[i] =
-        static_cast<int16_t>(
-            static_cast<int32_t>(vol_percent) *
-                static_cast<int32_t>(GenericByteSwap16(buffer[i])) /
-                100);
-  }
+  ApplyGainPCM<true, false>(buffer, buffer, num_frames,
+                            VolumeToGain(vol_percent));
 }
 
 #endif
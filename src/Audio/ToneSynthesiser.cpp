@@ -25,33 +25,52 @@ Copyright_License {
 #include "Math/FastTrig.hpp"
 #include "util/Macros.hpp"
 
-#include <cassert>
+#include <math.h>
+
+/**
+ * The number of phase bits which select a #SINETABLE entry.
+ */
+static constexpr unsigned TABLE_BITS = 12;
+static_assert(ARRAY_SIZE(SINETABLE) == 1u << TABLE_BITS,
+              "Wrong SINETABLE size");
+
+static constexpr uint32_t FRACTION_MASK = (1u << (32 - TABLE_BITS)) - 1;
+static constexpr double FRACTION_SCALE = 1. / (1u << (32 - TABLE_BITS));
 
 void
 ToneSynthesiser::SetTone(unsigned tone_hz)
 {
-  increment = ARRAY_SIZE(ISINETABLE) * tone_hz / sample_rate;
+  increment = (((uint64_t)tone_hz << 32) + sample_rate / 2) / sample_rate;
 }
 
 void
 ToneSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
+  const double _amplitude = amplitude;
+  const uint32_t _increment = increment;
+  uint32_t _phase = phase;
 
   for (int16_t *end = buffer + n; buffer != end; ++buffer) {
-    *buffer = ISINETABLE[angle] * (32767 / 1024) * (int)volume / 100;
-    angle = (angle + increment) & (ARRAY_SIZE(ISINETABLE) - 1);
+    /* linear interpolation between two table entries, weighted with
+       the fractional phase bits */
+    const unsigned i = _phase >> (32 - TABLE_BITS);
+    const double a = SINETABLE[i];
+    const double b = SINETABLE[(i + 1) & (ARRAY_SIZE(SINETABLE) - 1)];
+    const double fraction = (_phase & FRACTION_MASK) * FRACTION_SCALE;
+
+    *buffer = (int16_t)lrint((a + (b - a) * fraction) * _amplitude);
+    _phase += _increment;
   }
+
+  phase = _phase;
 }
 
 unsigned
 ToneSynthesiser::ToZero() const
 {
-  assert(angle < ARRAY_SIZE(ISINETABLE));
-
-  if (angle < increment)
+  if (phase < increment || increment == 0)
     /* close enough */
     return 0;
 
-  return (ARRAY_SIZE(ISINETABLE) - angle) / increment;
+  return (0u - phase) / increment;
 }
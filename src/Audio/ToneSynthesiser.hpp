@@ -27,11 +27,23 @@ Copyright_License {
 #include "PCMSynthesiser.hpp"
 #include "util/Compiler.h"
 
+#include <cstdint>
+
 /**
  * This class generates tones with a sine wave.
+ *
+ * The wave is looked up in #SINETABLE with a 32 bit phase
+ * accumulator; the upper bits select the table entry, and the lower
+ * bits keep the fractional part, so the tone frequency is exact
+ * instead of being rounded to a multiple of sample_rate/4096.
  */
 class ToneSynthesiser : public PCMSynthesiser {
-  unsigned volume = 100, angle = 0, increment = 0;
+  /**
+   * The amplitude of the wave, derived from the volume.
+   */
+  double amplitude = 32767;
+
+  uint32_t phase = 0, increment = 0;
 
 public:
   explicit ToneSynthesiser(unsigned _sample_rate) : sample_rate(_sample_rate) {
@@ -48,7 +60,7 @@ public:
    * means full volume
    */
   void SetVolume(unsigned _volume) {
-    volume = _volume;
+    amplitude = 32767. * _volume / 100;
   }
 
   void SetTone(unsigned tone_hz);
@@ -70,7 +82,7 @@ protected:
    * Start a new period.
    */
   void Restart() {
-    angle = 0;
+    phase = 0;
   }
 };
 
@@ -22,7 +22,6 @@ Copyright_License {
 */
 
 #include "VarioSynthesiser.hpp"
-#include "Math/FastMath.hpp"
 #include "util/Clamp.hpp"
 
 #include <algorithm>
@@ -35,8 +34,12 @@ Copyright_License {
 static constexpr int min_vario = -500, max_vario = 500;
 
 unsigned
-VarioSynthesiser::VarioToFrequency(int ivario)
+VarioSynthesiser::VarioToFrequency(const Settings &settings, int ivario)
 {
+  const unsigned min_frequency = settings.min_frequency;
+  const unsigned zero_frequency = settings.zero_frequency;
+  const unsigned max_frequency = settings.max_frequency;
+
   return ivario > 0
     ? (zero_frequency + (unsigned)ivario * (max_frequency - zero_frequency)
        / (unsigned)max_vario)
@@ -46,26 +49,29 @@ VarioSynthesiser::VarioToFrequency(int ivario)
 void
 VarioSynthesiser::SetVario(double vario)
 {
-  const std::lock_guard<Mutex> lock(mutex);
-
   const int ivario = Clamp((int)(vario * 100), min_vario, max_vario);
+  vario_channel.Publish({ivario, false});
+}
 
-  if (dead_band_enabled && InDeadBand(ivario)) {
+void
+VarioSynthesiser::ApplyVario(const Settings &settings, int ivario)
+{
+  if (settings.dead_band_enabled && settings.InDeadBand(ivario)) {
     /* inside the "dead band" */
-    UnsafeSetSilence();
+    ApplySilence();
     return;
   }
 
   /* update the ToneSynthesiser base class */
-  SetTone(VarioToFrequency(ivario));
+  SetTone(VarioToFrequency(settings, ivario));
 
   if (ivario > 0) {
     /* while climbing, the vario sound gets interrupted by silence
        periodically */
 
     const unsigned period_ms = sample_rate
-      * (min_period_ms + (max_vario - ivario)
-         * (max_period_ms - min_period_ms) / max_vario)
+      * (settings.min_period_ms + (max_vario - ivario)
+         * (settings.max_period_ms - settings.min_period_ms) / max_vario)
       / 1000;
 
     silence_count = period_ms / 3;
@@ -87,15 +93,13 @@ VarioSynthesiser::SetVario(double vario)
 }
 
 void
-VarioSynthesiser::SetSilence()
+VarioSynthesiser::ApplySilence()
 {
-  const std::lock_guard<Mutex> lock(mutex);
-  UnsafeSetSilence();
-}
+  if (audible_count == 0)
+    /* already silent; don't cut off the sine wave which is being
+       finished by Synthesise() */
+    return;
 
-void
-VarioSynthesiser::UnsafeSetSilence()
-{
   audible_count = 0;
   silence_count = 1;
 
@@ -108,11 +112,31 @@ VarioSynthesiser::UnsafeSetSilence()
   silence_remaining = 0;
 }
 
+void
+VarioSynthesiser::ReceiveUpdates()
+{
+  const bool new_settings = settings_channel.Update();
+  const bool new_vario = vario_channel.Update();
+  if (!new_settings && !new_vario)
+    return;
+
+  const Settings &settings = settings_channel.GetFront();
+  if (new_settings)
+    ToneSynthesiser::SetVolume(settings.volume);
+
+  /* re-apply the vario value after a settings change, because the
+     frequencies and periods depend on both */
+  const VarioValue &value = vario_channel.GetFront();
+  if (value.silence)
+    ApplySilence();
+  else
+    ApplyVario(settings, value.ivario);
+}
 
 void
 VarioSynthesiser::Synthesise(int16_t *buffer, size_t n)
 {
-  const std::lock_guard<Mutex> lock(mutex);
+  ReceiveUpdates();
 
   assert(audible_count > 0 || silence_count > 0);
 
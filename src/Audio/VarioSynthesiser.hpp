@@ -25,18 +25,81 @@ Copyright_License {
 #define XCSOAR_AUDIO_VARIO_SYNTHESISER_HPP
 
 #include "ToneSynthesiser.hpp"
-#include "thread/Mutex.hxx"
+#include "util/TripleBuffer.hxx"
 #include "util/Compiler.h"
 
 /**
  * This class generates vario sound.
+ *
+ * The public setters may be called from any thread while the PCM
+ * player invokes Synthesise() from its real-time thread.  Values are
+ * passed to the audio thread through two lock-free #TripleBuffer
+ * channels, so Synthesise() never blocks: one channel for the vario
+ * value (single producer: the thread calling SetVario() and
+ * SetSilence()) and one for the settings (single producer: the
+ * thread calling the other setters).
  */
 class VarioSynthesiser final : public ToneSynthesiser {
+  struct Settings {
+    unsigned volume = 100;
+
+    bool dead_band_enabled = false;
+
+    /**
+     * The tone frequency for #min_vario.
+     */
+    unsigned min_frequency = 200;
+
+    /**
+     * The tone frequency for stationary altitude.
+     */
+    unsigned zero_frequency = 500;
+
+    /**
+     * The tone frequency for #max_vario.
+     */
+    unsigned max_frequency = 1500;
+
+    /**
+     * The minimum silence+audible period for #max_vario.
+     */
+    unsigned min_period_ms = 150;
+
+    /**
+     * The maximum silence+audible period for #min_vario.
+     */
+    unsigned max_period_ms = 600;
+
+    /**
+     * The vario range of the "dead band" during which no sound is
+     * emitted [cm/s].
+     */
+    int min_dead = -30, max_dead = 10;
+
+    bool InDeadBand(int ivario) const {
+      return ivario >= min_dead && ivario <= max_dead;
+    }
+  };
+
+  struct VarioValue {
+    /**
+     * The clamped vario value [cm/s].
+     */
+    int ivario;
+
+    bool silence;
+  };
+
   /**
-   * This mutex protects all atttributes below.  It is locked
-   * automatically by all public methods.
+   * Producer-side copy of the settings; modified by the setters and
+   * then published to #settings_channel.
    */
-  Mutex mutex;
+  Settings pending_settings;
+
+  TripleBuffer<Settings> settings_channel;
+  TripleBuffer<VarioValue> vario_channel;
+
+  /* the following attributes are only accessed by Synthesise() */
 
   /**
    * The number of audible samples in each period.
@@ -56,48 +119,13 @@ class VarioSynthesiser final : public ToneSynthesiser {
    */
   size_t audible_remaining, silence_remaining;
 
-  bool dead_band_enabled;
-
-  /**
-   * The tone frequency for #min_vario.
-   */
-  unsigned min_frequency;
-
-  /**
-   * The tone frequency for stationary altitude.
-   */
-  unsigned zero_frequency;
-
-  /**
-   * The tone frequency for #max_vario.
-   */
-  unsigned max_frequency;
-
-  /**
-   * The minimum silence+audible period for #max_vario.
-   */
-  unsigned min_period_ms;
-
-  /**
-   * The maximum silence+audible period for #min_vario.
-   */
-  unsigned max_period_ms;
-
-  /**
-   * The vario range of the "dead band" during which no sound is emitted
-   * [cm/s].
-   */
-  int min_dead, max_dead;
-
 public:
   explicit VarioSynthesiser(unsigned sample_rate)
     :ToneSynthesiser(sample_rate),
+     settings_channel(Settings()),
+     vario_channel(VarioValue{0, true}),
      audible_count(0), silence_count(1),
-     audible_remaining(0), silence_remaining(0),
-     dead_band_enabled(false),
-     min_frequency(200), zero_frequency(500), max_frequency(1500),
-     min_period_ms(150), max_period_ms(600),
-     min_dead(-30), max_dead(10) {}
+     audible_remaining(0), silence_remaining(0) {}
 
   /**
    * Update the vario value.  This calculates a new tone frequency and
@@ -110,60 +138,79 @@ public:
   /**
    * Produce silence from now on.
    */
-  void SetSilence();
+  void SetSilence() {
+    vario_channel.Publish({0, true});
+  }
+
+  /**
+   * Set the volume (0..100).  This hides
+   * ToneSynthesiser::SetVolume(), which is not thread-safe.
+   */
+  void SetVolume(unsigned volume) {
+    pending_settings.volume = volume;
+    PublishSettings();
+  }
 
   /**
    * Enable/disable the dead band silence
    */
   void SetDeadBand(bool enabled) {
-    dead_band_enabled = enabled;
+    pending_settings.dead_band_enabled = enabled;
+    PublishSettings();
   }
 
   /**
    * Set the base frequencies for minimum, zero and maximum lift
    */
   void SetFrequencies(unsigned min, unsigned zero, unsigned max) {
-    min_frequency = min;
-    zero_frequency = zero;
-    max_frequency = max;
+    pending_settings.min_frequency = min;
+    pending_settings.zero_frequency = zero;
+    pending_settings.max_frequency = max;
+    PublishSettings();
   }
 
   /**
    * Set the time periods for minimum and maximum lift
    */
   void SetPeriods(unsigned min, unsigned max) {
-    min_period_ms = min;
-    max_period_ms = max;
+    pending_settings.min_period_ms = min;
+    pending_settings.max_period_ms = max;
+    PublishSettings();
   }
 
   /**
    * Set the vario range of the "dead band" during which no sound is emitted
    */
   void SetDeadBandRange(double min, double max) {
-    min_dead = (int)(min * 100);
-    max_dead = (int)(max * 100);
+    pending_settings.min_dead = (int)(min * 100);
+    pending_settings.max_dead = (int)(max * 100);
+    PublishSettings();
   }
 
   /* methods from class PCMSynthesiser */
   virtual void Synthesise(int16_t *buffer, size_t n);
 
 private:
+  void PublishSettings() {
+    settings_channel.Publish(pending_settings);
+  }
+
   /**
-   * Same as SetSilence(), but doesn't lock the mutex.
+   * Apply new values from the channels.  Called by Synthesise()
+   * before generating samples.
    */
-  void UnsafeSetSilence();
+  void ReceiveUpdates();
+
+  void ApplyVario(const Settings &settings, int ivario);
+  void ApplySilence();
 
   /**
    * Convert a vario value to a tone frequency.
    *
    * @param ivario the current vario value [cm/s]
    */
-  gcc_const
-  unsigned VarioToFrequency(int ivario);
-
-  bool InDeadBand(int ivario) {
-    return ivario >= min_dead && ivario <= max_dead;
-  }
+  gcc_pure
+  static unsigned VarioToFrequency(const Settings &settings, int ivario);
 };
 
 #endif
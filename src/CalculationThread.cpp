@@ -95,6 +95,10 @@ CalculationThread::Tick() noexcept
     // perform idle call if time advanced and slow calculations need to be updated
     do_idle |= glide_computer.ProcessGPS(force);
 
+  /* pick up the results of the WarningThread, which may have
+     triggered this iteration */
+  const bool warnings_updated = glide_computer.ReadAirspaceWarnings();
+
   // values changed, so copy them back now: ONLY CALCULATED INFO
   // should be changed in DoCalculations, so we only need to write
   // that one back (otherwise we may write over new data)
@@ -104,7 +108,7 @@ CalculationThread::Tick() noexcept
   }
 
   // if (new GPS data)
-  if (gps_updated || force)
+  if (gps_updated || force || warnings_updated)
     // inform map new data is ready
     TriggerCalculatedUpdate();
 
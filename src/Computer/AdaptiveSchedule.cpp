@@ -0,0 +1,64 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AdaptiveSchedule.hpp"
+
+#include <algorithm>
+
+AdaptiveSchedule::Duration
+AdaptiveSchedule::GetPeriod(bool circling) const noexcept
+{
+  /* the period at which the measured cost uses up the budget */
+  Duration period = cost * 100 / budget_percent;
+
+  const unsigned factor = circling ? circling_factor : 1;
+  period *= factor;
+
+  return std::clamp(period, min_period, max_period * factor);
+}
+
+bool
+AdaptiveSchedule::Record(Stamp start, Stamp end) noexcept
+{
+  const Duration duration = end - start;
+
+  /* low-pass filter, but follow increases quickly, so a sudden
+     expensive calculation (e.g. after loading a task) throttles the
+     rate right away */
+  if (cost == Duration::zero())
+    cost = duration;
+  else if (duration > cost)
+    cost = (cost + duration) / 2;
+  else
+    cost = (cost * 7 + duration) / 8;
+
+  last_start = start;
+
+  /* even at the maximum period, this calculation would exceed its
+     budget */
+  const bool missed = cost * 100 / budget_percent > max_period;
+  if (missed)
+    ++missed_deadlines;
+
+  return missed;
+}
@@ -0,0 +1,117 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_ADAPTIVE_SCHEDULE_HPP
+#define XCSOAR_ADAPTIVE_SCHEDULE_HPP
+
+#include <chrono>
+
+/**
+ * Decides how often an expensive periodic calculation may run.  The
+ * period adapts to the measured cost of the calculation, so that it
+ * never uses more than the configured share of the CPU; it is
+ * stretched further while circling, when the calculation's result is
+ * less urgent.
+ *
+ * If the calculation is so expensive that it would exceed its budget
+ * even at the maximum period, the run is counted as a missed
+ * deadline.
+ */
+class AdaptiveSchedule {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+  using Stamp = Clock::time_point;
+
+private:
+  /**
+   * The shortest and the longest allowed period.
+   */
+  const Duration min_period, max_period;
+
+  /**
+   * The maximum share of the CPU [%] this calculation may use.
+   */
+  const unsigned budget_percent;
+
+  /**
+   * The factor applied to the period while circling.
+   */
+  const unsigned circling_factor;
+
+  /**
+   * A low-pass filtered duration of the recent runs.
+   */
+  Duration cost;
+
+  Stamp last_start;
+
+  unsigned missed_deadlines;
+
+public:
+  AdaptiveSchedule(Duration _min_period, Duration _max_period,
+                   unsigned _budget_percent,
+                   unsigned _circling_factor=1) noexcept
+    :min_period(_min_period), max_period(_max_period),
+     budget_percent(_budget_percent), circling_factor(_circling_factor) {
+    Reset();
+  }
+
+  void Reset() noexcept {
+    cost = Duration::zero();
+    last_start = Stamp();
+    missed_deadlines = 0;
+  }
+
+  /**
+   * Returns the current period between two runs.
+   */
+  [[gnu::pure]]
+  Duration GetPeriod(bool circling) const noexcept;
+
+  Duration GetCost() const noexcept {
+    return cost;
+  }
+
+  unsigned GetMissedDeadlines() const noexcept {
+    return missed_deadlines;
+  }
+
+  /**
+   * Shall the calculation be run now?
+   */
+  [[gnu::pure]]
+  bool IsDue(Stamp now, bool circling) const noexcept {
+    return last_start == Stamp() || now >= last_start + GetPeriod(circling);
+  }
+
+  /**
+   * Record one run of the calculation.
+   *
+   * @return true if the deadline was missed, i.e. the calculation
+   * can't run at its maximum period within its budget
+   */
+  bool Record(Stamp start, Stamp end) noexcept;
+};
+
+#endif
@@ -27,6 +27,9 @@ Copyright_License {
 #include "ConditionMonitor/ConditionMonitors.hpp"
 #include "GlideComputerInterface.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
+#include "LogFile.hpp"
+
+using std::chrono::milliseconds;
 
 static PeriodClock last_team_code_update;
 
@@ -40,7 +43,11 @@ GlideComputer::GlideComputer(const ComputerSettings &_settings,
    task_computer(task, _airspace_database, &warning_computer.GetManager()),
    waypoints(_way_points),
    retrospective(_way_points),
-   team_code_ref_id(-1)
+   team_code_ref_id(-1),
+   /* the contest is not urgent; it is stretched while circling,
+      when the trace changes little */
+   contest_schedule(milliseconds(500), std::chrono::seconds(5), 20, 2),
+   task_idle_schedule(milliseconds(500), std::chrono::seconds(2), 10)
 {
   ReadComputerSettings(_settings);
   events.SetComputer(*this);
@@ -60,7 +67,11 @@ GlideComputer::ResetFlight(const bool full)
   cu_computer.Reset();
   warning_computer.Reset();
 
+  contest_schedule.Reset();
+  task_idle_schedule.Reset();
+
   trace_history_time.Reset();
+  lift_map_computer.Reset();
 }
 
 void
@@ -147,12 +158,46 @@ GlideComputer::ProcessGPS(bool force)
       calculated.trace_history.clear();
   }
 
+  UpdateLiftMap();
+
   CalculateVarioScale();
 
   // Update the ConditionMonitors
   ConditionMonitorsUpdate(Basic(), Calculated(), settings);
 
-  return idle_clock.CheckUpdate(std::chrono::milliseconds(500));
+  return idle_clock.CheckUpdate(milliseconds(500));
+}
+
+/**
+ * Run the given calculation if its schedule says it is due (or if
+ * forced), and feed its cost back into the schedule.
+ *
+ * @param now the time this idle pass started; all schedules are
+ * checked against the same time, so the cost of one calculation does
+ * not delay the next one
+ */
+template<typename F>
+static void
+RunScheduled(AdaptiveSchedule &schedule, const char *name,
+             AdaptiveSchedule::Stamp now,
+             bool circling, bool force, F &&f)
+{
+  if (!force && !schedule.IsDue(now, circling))
+    return;
+
+  const auto start = AdaptiveSchedule::Clock::now();
+  f();
+  const auto duration = AdaptiveSchedule::Clock::now() - start;
+
+  if (schedule.Record(now, now + duration)) {
+    /* log only the 1st, 2nd, 4th, 8th, ... miss */
+    const unsigned n = schedule.GetMissedDeadlines();
+    if ((n & (n - 1)) == 0)
+      LogFormat("%s calculation exceeds its CPU budget: %u ms per run, %u misses",
+                name,
+                unsigned(std::chrono::duration_cast<milliseconds>(schedule.GetCost()).count()),
+                n);
+  }
 }
 
 void
@@ -160,16 +205,28 @@ GlideComputer::ProcessIdle(bool exhaustive)
 {
   const MoreData &basic = Basic();
   DerivedInfo &calculated = SetCalculated();
+  const ComputerSettings &settings = GetComputerSettings();
+  const auto now = AdaptiveSchedule::Clock::now();
 
   // Log GPS fixes for internal usage
   // (snail trail, stats, contest, ...)
   stats_computer.DoLogging(basic, calculated);
-  log_computer.Run(basic, calculated, GetComputerSettings().logger);
-
-  task_computer.ProcessIdle(basic, calculated, GetComputerSettings(),
-                            exhaustive);
-
-  warning_computer.Update(GetComputerSettings(), basic,
+  log_computer.Run(basic, calculated, settings.logger);
+
+  RunScheduled(contest_schedule, "Contest", now,
+               calculated.circling, exhaustive,
+               [&]{
+                 task_computer.ProcessContest(basic, calculated, settings,
+                                              exhaustive);
+               });
+
+  RunScheduled(task_idle_schedule, "Task", now,
+               calculated.circling, exhaustive,
+               [&]{
+                 task_computer.ProcessTaskIdle(basic, calculated);
+               });
+
+  warning_computer.Update(settings, basic,
                           calculated, calculated.airspace_warnings);
 
   // Calculate summary of flight
@@ -337,6 +394,14 @@ GlideComputer::SetTerrain(RasterTerrain* _terrain)
   task_computer.SetTerrain(_terrain);
 }
 
+void
+GlideComputer::UpdateLiftMap()
+{
+  const DerivedInfo &calculated = Calculated();
+  lift_map_computer.Update(lift_map, Basic(), calculated.flight,
+                           calculated.circling);
+}
+
 void
 GlideComputer::CalculateWorkingBand()
 {
@@ -33,6 +33,9 @@ Copyright_License {
 #include "LogComputer.hpp"
 #include "WarningComputer.hpp"
 #include "CuComputer.hpp"
+#include "AdaptiveSchedule.hpp"
+#include "LiftMap.hpp"
+#include "LiftMapComputer.hpp"
 #include "util/Compiler.h"
 #include "Engine/Contest/Solvers/Retrospective.hpp"
 
@@ -63,12 +66,26 @@ class GlideComputer : public GlideComputerBlackboard
 
   PeriodClock idle_clock;
 
+  /**
+   * Rate control for the expensive calculations in ProcessIdle().
+   */
+  AdaptiveSchedule contest_schedule, task_idle_schedule;
+
   /**
    * This object is used to check whether to update
    * DerivedInfo::trace_history.
    */
   DeltaTime trace_history_time;
 
+  /**
+   * The lift encountered while circling.  Unlike most other
+   * attributes, it is not cleared by ResetFlight(); it accumulates
+   * over many flights.
+   */
+  LiftMap lift_map;
+
+  LiftMapComputer lift_map_computer;
+
 public:
   GlideComputer(const ComputerSettings &_settings,
                 const Waypoints &_way_points,
@@ -134,6 +151,35 @@ public:
     return warning_computer.GetManager();
   }
 
+  /**
+   * Evaluate airspace warnings in a dedicated #WarningThread.
+   *
+   * @param callback invoked in the #WarningThread after a new
+   * warning has been published; it should schedule a call to
+   * ReadAirspaceWarnings()
+   */
+  void EnableWarningThread(std::function<void()> &&callback) {
+    warning_computer.EnableThread(std::move(callback));
+  }
+
+  void DisableWarningThread() {
+    warning_computer.DisableThread();
+  }
+
+  WarningThread *GetWarningThread() {
+    return warning_computer.GetThread();
+  }
+
+  /**
+   * Copy the most recent result of the #WarningThread to
+   * DerivedInfo::airspace_warnings.
+   *
+   * @return true if there is a new warning
+   */
+  bool ReadAirspaceWarnings() {
+    return warning_computer.ReadResult(SetCalculated().airspace_warnings);
+  }
+
   const TraceComputer &GetTraceComputer() const {
     return task_computer.GetTraceComputer();
   }
@@ -154,6 +200,14 @@ public:
     return stats_computer.GetFlightStats();
   }
 
+  LiftMap &GetLiftMap() {
+    return lift_map;
+  }
+
+  const LiftMap &GetLiftMap() const {
+    return lift_map;
+  }
+
   const Retrospective &GetRetrospective() const {
     return retrospective;
   }
@@ -189,6 +243,8 @@ private:
    */
   void CalculateOwnTeamCode();
 
+  void UpdateLiftMap();
+
   void CalculateWorkingBand();
   void CalculateVarioScale();
 };
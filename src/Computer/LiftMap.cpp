@@ -0,0 +1,208 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LiftMap.hpp"
+#include "Geo/FAISphere.hpp"
+#include "Math/Angle.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include <math.h>
+
+/**
+ * The angular size of a grid cell.
+ */
+static constexpr double CELL_ANGLE = LiftMap::CELL_SIZE / FAISphere::REARTH;
+
+/**
+ * Grid positions are within this range on both axes.
+ */
+static constexpr int GRID_LIMIT = int(M_PI / CELL_ANGLE) + 2;
+
+/**
+ * After this many seconds, the score of a cell is halved.
+ */
+static constexpr double SCORE_HALF_LIFE = 30 * 24 * 3600;
+
+/**
+ * The minimum weight of a new sample in the moving average of
+ * #Cell::lift.
+ */
+static constexpr double LIFT_ALPHA = 0.1;
+
+double
+LiftMap::Cell::GetScore(int64_t now) const noexcept
+{
+  const double age = std::max<int64_t>(now - time, 0);
+  return n * exp2(-age / SCORE_HALF_LIFE);
+}
+
+LiftMap::LiftMap() noexcept
+{
+  /* a fixed rectangle which covers the whole grid, so the tree never
+     needs to be rescanned */
+  cells.SetBounds({-GRID_LIMIT, -GRID_LIMIT, GRID_LIMIT, GRID_LIMIT});
+}
+
+void
+LiftMap::Clear() noexcept
+{
+  cells.Clear();
+  cells.SetBounds({-GRID_LIMIT, -GRID_LIMIT, GRID_LIMIT, GRID_LIMIT});
+}
+
+LiftMap::CellTree::Point
+LiftMap::ToGrid(const GeoPoint &location) noexcept
+{
+  const int y = (int)floor(location.latitude.Radians() / CELL_ANGLE);
+
+  /* cells are approximately square: scale the longitude with the
+     cosine of the latitude of the cell's row */
+  const double row_latitude = (y + 0.5) * CELL_ANGLE;
+  const int x = (int)floor(location.longitude.Radians() * cos(row_latitude)
+                           / CELL_ANGLE);
+
+  return {x, y};
+}
+
+unsigned
+LiftMap::ToGridDistance(double distance) noexcept
+{
+  return (unsigned)ceil(distance / CELL_SIZE);
+}
+
+void
+LiftMap::Add(const GeoPoint &location, double lift, int64_t time) noexcept
+{
+  const auto position = ToGrid(location);
+
+  const auto found = cells.FindNearestIf(position, 0, [position](const Cell &cell){
+    return cell.x == position.x && cell.y == position.y;
+  });
+
+  if (found.first != cells.end()) {
+    Cell cell = *found.first;
+    ++cell.n;
+
+    const double alpha = std::max(1. / cell.n, LIFT_ALPHA);
+    cell.lift += (lift - cell.lift) * alpha;
+    cell.location = cell.location.Interpolate(location, alpha);
+    cell.time = std::max(cell.time, time);
+
+    cells.Replace(found.first, cell);
+    return;
+  }
+
+  if (cells.size() >= MAX_CELLS)
+    Shrink(time);
+
+  Cell cell;
+  cell.x = position.x;
+  cell.y = position.y;
+  cell.location = location;
+  cell.lift = lift;
+  cell.n = 1;
+  cell.time = time;
+  cells.Add(cell);
+}
+
+void
+LiftMap::Insert(Cell cell) noexcept
+{
+  assert(cell.location.IsValid());
+
+  const auto position = ToGrid(cell.location);
+  cell.x = position.x;
+  cell.y = position.y;
+
+  const auto found = cells.FindNearestIf(position, 0, [position](const Cell &other){
+    return other.x == position.x && other.y == position.y;
+  });
+
+  if (found.first != cells.end()) {
+    cells.Replace(found.first, cell);
+    return;
+  }
+
+  if (cells.size() >= MAX_CELLS)
+    Shrink(cell.time);
+
+  cells.Add(cell);
+}
+
+void
+LiftMap::Shrink(int64_t now) noexcept
+{
+  std::vector<double> scores;
+  scores.reserve(cells.size());
+  for (const auto &i : cells)
+    scores.push_back(i.GetScore(now));
+
+  /* discard a quarter of all cells at once, so this O(n) operation
+     is rare */
+  const auto nth = scores.begin() + scores.size() / 4;
+  std::nth_element(scores.begin(), nth, scores.end());
+  const double threshold = *nth;
+
+  /* cells scoring exactly the threshold are discarded only until
+     the quota is reached, in case many cells have the same score */
+  const unsigned quota = nth - scores.begin() + 1;
+  const unsigned n_below = std::count_if(scores.begin(), scores.end(),
+                                         [threshold](double score){
+                                           return score < threshold;
+                                         });
+  unsigned n_equal = quota - n_below;
+
+  cells.EraseIf([now, threshold, &n_equal](const Cell &cell){
+    const double score = cell.GetScore(now);
+    if (score < threshold)
+      return true;
+
+    if (score == threshold && n_equal > 0) {
+      --n_equal;
+      return true;
+    }
+
+    return false;
+  });
+
+  if (cells.IsEmpty())
+    Clear();
+}
+
+const LiftMap::Cell *
+LiftMap::FindNearest(const GeoPoint &location, double range,
+                     double min_lift, int64_t min_time) const noexcept
+{
+  const auto found =
+    cells.FindNearestIf(ToGrid(location), ToGridDistance(range),
+                        [min_lift, min_time](const Cell &cell){
+                          return cell.lift >= min_lift &&
+                            cell.time >= min_time;
+                        });
+  return found.first != cells.end()
+    ? &*found.first
+    : nullptr;
+}
@@ -0,0 +1,186 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LIFT_MAP_HPP
+#define XCSOAR_LIFT_MAP_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "util/QuadTree.hxx"
+#include "thread/Mutex.hxx"
+
+#include <cstdint>
+
+/**
+ * A spatially indexed map of the lift encountered while circling.
+ * Climb samples are collected in grid cells of roughly 200 m, which
+ * are kept in a #QuadTree for O(log n) nearest-lift queries.
+ *
+ * The number of cells is bounded; when the map is full, the cells
+ * with the lowest score (based on the number of samples and their
+ * age) are discarded.  The map is meant to outlive a single flight;
+ * see LiftMapFile.hpp.
+ */
+class LiftMap {
+public:
+  /**
+   * The maximum number of cells.
+   */
+  static constexpr unsigned MAX_CELLS = 8192;
+
+  /**
+   * The size of a grid cell [m], approximately.
+   */
+  static constexpr double CELL_SIZE = 217;
+
+  struct Cell {
+    /**
+     * The position of this cell in the grid.
+     */
+    int x, y;
+
+    /**
+     * The mean location of all samples in this cell.
+     */
+    GeoPoint location;
+
+    /**
+     * The climb rate [m/s]; this is a moving average which gives
+     * more weight to recent samples.
+     */
+    double lift;
+
+    /**
+     * The number of samples merged into this cell.
+     */
+    unsigned n;
+
+    /**
+     * The time of the most recent sample [UNIX time, UTC].
+     */
+    int64_t time;
+
+    /**
+     * The score used for discarding cells when the map is full.
+     */
+    [[gnu::pure]]
+    double GetScore(int64_t now) const noexcept;
+  };
+
+private:
+  struct CellAccessor {
+    int GetX(const Cell &cell) const noexcept {
+      return cell.x;
+    }
+
+    int GetY(const Cell &cell) const noexcept {
+      return cell.y;
+    }
+  };
+
+  using CellTree = QuadTree<Cell, CellAccessor>;
+
+  CellTree cells;
+
+public:
+  /**
+   * Protects all attributes.  The CalculationThread writes, the
+   * renderers read.
+   */
+  mutable Mutex mutex;
+
+  LiftMap() noexcept;
+
+  bool IsEmpty() const noexcept {
+    return cells.IsEmpty();
+  }
+
+  unsigned size() const noexcept {
+    return cells.size();
+  }
+
+  void Clear() noexcept;
+
+  /**
+   * Add a climb sample.
+   *
+   * @param location the aircraft location
+   * @param lift the climb rate [m/s]
+   * @param time the time of the sample [UNIX time, UTC]
+   */
+  void Add(const GeoPoint &location, double lift, int64_t time) noexcept;
+
+  /**
+   * Insert a complete cell, e.g. when loading from a file.  The
+   * grid position is calculated from Cell::location (the attributes
+   * Cell::x and Cell::y are ignored), and an existing cell at the
+   * same position is replaced.
+   */
+  void Insert(Cell cell) noexcept;
+
+  /**
+   * Find the nearest cell with at least the specified climb rate
+   * which was updated after the specified time.
+   *
+   * @param range the maximum distance [m]
+   * @return the cell or nullptr if there is none
+   */
+  [[gnu::pure]]
+  const Cell *FindNearest(const GeoPoint &location, double range,
+                          double min_lift,
+                          int64_t min_time=0) const noexcept;
+
+  /**
+   * Invoke the visitor for each cell within the specified range
+   * [m] of the location.
+   */
+  template<typename V>
+  void VisitWithinRange(const GeoPoint &location, double range,
+                        V &&visitor) const {
+    cells.VisitWithinRange(ToGrid(location), ToGridDistance(range),
+                           visitor);
+  }
+
+  /**
+   * Invoke the visitor for each cell.
+   */
+  template<typename V>
+  void VisitAll(V &&visitor) const {
+    for (const auto &i : cells)
+      visitor(i);
+  }
+
+private:
+  /**
+   * Discard the cells with the lowest score, to make room for new
+   * ones.
+   */
+  void Shrink(int64_t now) noexcept;
+
+  [[gnu::const]]
+  static CellTree::Point ToGrid(const GeoPoint &location) noexcept;
+
+  [[gnu::const]]
+  static unsigned ToGridDistance(double distance) noexcept;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LiftMapComputer.hpp"
+#include "LiftMap.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/FlyingState.hpp"
+
+#include <mutex>
+
+bool
+LiftMapComputer::Update(LiftMap &lift_map, const MoreData &basic,
+                        const FlyingState &flight, bool circling) noexcept
+{
+  if (!basic.time_available || !basic.location_available ||
+      !basic.date_time_utc.IsDatePlausible() ||
+      !flight.flying || !circling)
+    return false;
+
+  /* don't let replayed or simulated flights pollute the pilot's own
+     lift history */
+  if (basic.gps.replay || basic.gps.simulator)
+    return false;
+
+  /* one sample per second */
+  const auto dt = last_time.Update(basic.time, 1, 30);
+  if (dt <= 0)
+    return false;
+
+  const std::lock_guard<Mutex> lock(lift_map.mutex);
+  lift_map.Add(basic.location, basic.brutto_vario,
+               basic.date_time_utc.ToUnixTimeUTC());
+  return true;
+}
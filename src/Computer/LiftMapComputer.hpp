@@ -0,0 +1,55 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LIFT_MAP_COMPUTER_HPP
+#define XCSOAR_LIFT_MAP_COMPUTER_HPP
+
+#include "time/DeltaTime.hpp"
+
+class LiftMap;
+struct MoreData;
+struct FlyingState;
+
+/**
+ * Feeds the climb rate while circling into a #LiftMap, at most once
+ * per second.  The map is persistent and describes the pilot's own
+ * soaring sites, therefore replayed and simulated fixes are ignored.
+ */
+class LiftMapComputer {
+  DeltaTime last_time;
+
+public:
+  void Reset() noexcept {
+    last_time.Reset();
+  }
+
+  /**
+   * Lock the #LiftMap and add a sample if the current fix qualifies.
+   *
+   * @return true if a sample was added
+   */
+  bool Update(LiftMap &lift_map, const MoreData &basic,
+              const FlyingState &flight, bool circling) noexcept;
+};
+
+#endif
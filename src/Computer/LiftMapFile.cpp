@@ -0,0 +1,98 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LiftMapFile.hpp"
+#include "LiftMap.hpp"
+#include "io/LineReader.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "util/NumberParser.hpp"
+
+/**
+ * Each line describes one cell:
+ *
+ *   latitude longitude lift n time
+ *
+ * The angles are in degrees, the time in seconds since the UNIX
+ * epoch (UTC).
+ */
+
+static bool
+ParseCell(const char *line, LiftMap::Cell &cell)
+{
+  char *endptr;
+
+  const double latitude = ParseDouble(line, &endptr);
+  if (endptr == line || *endptr != ' ')
+    return false;
+
+  line = endptr + 1;
+  const double longitude = ParseDouble(line, &endptr);
+  if (endptr == line || *endptr != ' ')
+    return false;
+
+  cell.location = GeoPoint(Angle::Degrees(longitude),
+                           Angle::Degrees(latitude));
+  if (!cell.location.Check())
+    return false;
+
+  line = endptr + 1;
+  cell.lift = ParseDouble(line, &endptr);
+  if (endptr == line || *endptr != ' ')
+    return false;
+
+  line = endptr + 1;
+  cell.n = ParseUnsigned(line, &endptr);
+  if (endptr == line || *endptr != ' ' || cell.n == 0)
+    return false;
+
+  line = endptr + 1;
+  cell.time = ParseInt64(line, &endptr);
+  return endptr > line && *endptr == '\0';
+}
+
+void
+LoadLiftMapFile(NLineReader &reader, LiftMap &map)
+{
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (*line == '#')
+      continue;
+
+    LiftMap::Cell cell;
+    if (ParseCell(line, cell))
+      map.Insert(cell);
+  }
+}
+
+void
+SaveLiftMapFile(BufferedOutputStream &writer, const LiftMap &map)
+{
+  writer.Write("# XCSoar lift map v1\n");
+
+  map.VisitAll([&writer](const LiftMap::Cell &cell){
+    writer.Format("%.6f %.6f %.2f %u %lld\n",
+                  cell.location.latitude.Degrees(),
+                  cell.location.longitude.Degrees(),
+                  cell.lift, cell.n, (long long)cell.time);
+  });
+}
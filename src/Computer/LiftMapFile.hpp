@@ -21,24 +21,21 @@ Copyright_License {
 }
 */
 
-#ifndef XCSOAR_FLARM_CALCULATIONS_HPP
-#define XCSOAR_FLARM_CALCULATIONS_HPP
-
-#include "FLARM/FlarmId.hpp"
-#include "Computer/ClimbAverageCalculator.hpp"
-
-#include <map>
-
-class FlarmCalculations
-{
-private:
-  typedef std::map<FlarmId, ClimbAverageCalculator> AverageCalculatorMap;
-  AverageCalculatorMap averageCalculatorMap;
-
-public:
-  double Average30s(FlarmId flarmId, double curTime, double curAltitude);
-
-  void CleanUp(double now);
-};
+#ifndef XCSOAR_LIFT_MAP_FILE_HPP
+#define XCSOAR_LIFT_MAP_FILE_HPP
+
+class LiftMap;
+class NLineReader;
+class BufferedOutputStream;
+
+/**
+ * Load cells from a text file into the #LiftMap.  Malformed lines
+ * are ignored.
+ */
+void
+LoadLiftMapFile(NLineReader &reader, LiftMap &map);
+
+void
+SaveLiftMapFile(BufferedOutputStream &writer, const LiftMap &map);
 
 #endif
@@ -0,0 +1,65 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "LiftMapGlue.hpp"
+#include "LiftMap.hpp"
+#include "LiftMapFile.hpp"
+#include "LocalPath.hpp"
+#include "LogFile.hpp"
+#include "io/DataFile.hpp"
+#include "io/LineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+
+#include <mutex>
+
+static constexpr const TCHAR *LIFT_MAP_FILE = _T("xcsoar-lift.txt");
+
+void
+LoadLiftMap(LiftMap &map)
+try {
+  auto reader = OpenDataTextFileA(LIFT_MAP_FILE);
+
+  const std::lock_guard<Mutex> lock(map.mutex);
+  LoadLiftMapFile(*reader, map);
+  LogFormat("%u lift map cells loaded", map.size());
+} catch (...) {
+  LogError(std::current_exception());
+}
+
+void
+SaveLiftMap(const LiftMap &map)
+try {
+  FileOutputStream fos(LocalPath(LIFT_MAP_FILE));
+  BufferedOutputStream bos(fos);
+
+  {
+    const std::lock_guard<Mutex> lock(map.mutex);
+    SaveLiftMapFile(bos, map);
+  }
+
+  bos.Flush();
+  fos.Commit();
+} catch (...) {
+  LogError(std::current_exception());
+}
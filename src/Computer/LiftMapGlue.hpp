@@ -21,25 +21,21 @@ Copyright_License {
 }
 */
 
-#include "FLARM/FlarmCalculations.hpp"
+#ifndef XCSOAR_LIFT_MAP_GLUE_HPP
+#define XCSOAR_LIFT_MAP_GLUE_HPP
 
-double
-FlarmCalculations::Average30s(FlarmId id, double time, double altitude)
-{
-  ClimbAverageCalculator &item = averageCalculatorMap[id];
-  return item.GetAverage(time, altitude, 30);
-}
+class LiftMap;
 
+/**
+ * Load the lift map from xcsoar-lift.txt.
+ */
 void
-FlarmCalculations::CleanUp(double now)
-{
-  static constexpr double MAX_AGE = 60;
-
-  // Iterate through ClimbAverageCalculators and remove expired ones
-  for (auto it = averageCalculatorMap.begin(),
-       it_end = averageCalculatorMap.end(); it != it_end;)
-    if (it->second.Expired(now, MAX_AGE))
-      it = averageCalculatorMap.erase(it);
-    else
-      ++it;
-}
+LoadLiftMap(LiftMap &map);
+
+/**
+ * Save the lift map to xcsoar-lift.txt.
+ */
+void
+SaveLiftMap(const LiftMap &map);
+
+#endif
@@ -146,9 +146,9 @@ Predicted(const ContestSettings &settings,
 }
 
 void
-TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                          const ComputerSettings &settings_computer,
-                          bool exhaustive)
+TaskComputer::ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                             const ComputerSettings &settings_computer,
+                             bool exhaustive)
 {
   contest.SetPredicted(Predicted(settings_computer.contest, basic,
                                  calculated.task_stats.current_leg));
@@ -158,7 +158,12 @@ TaskComputer::ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
                             calculated.contest_stats);
   else
     contest.Solve(settings_computer.contest, calculated.contest_stats);
+}
 
+void
+TaskComputer::ProcessTaskIdle(const MoreData &basic,
+                              const DerivedInfo &calculated)
+{
   const AircraftState as = ToAircraftState(basic, calculated);
 
   ProtectedTaskManager::ExclusiveLease _task(task);
@@ -101,9 +101,18 @@ public:
    */
   void ProcessAutoTask(const NMEAInfo &basic, const DerivedInfo &calculated);
 
-  void ProcessIdle(const MoreData &basic, DerivedInfo &calculated,
-                   const ComputerSettings &settings_computer,
-                   bool exhaustive=false);
+  /**
+   * Run the contest optimiser.
+   */
+  void ProcessContest(const MoreData &basic, DerivedInfo &calculated,
+                      const ComputerSettings &settings_computer,
+                      bool exhaustive=false);
+
+  /**
+   * Run the task manager's idle calculations (e.g. the AAT and
+   * start point optimisation).
+   */
+  void ProcessTaskIdle(const MoreData &basic, const DerivedInfo &calculated);
 };
 
 #endif
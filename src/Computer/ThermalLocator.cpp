@@ -24,7 +24,6 @@ Copyright_License {
 #include "ThermalLocator.hpp"
 #include "Geo/Math.hpp"
 #include "Geo/SpeedVector.hpp"
-#include "Geo/Flat/FlatProjection.hpp"
 #include "Math/FastMath.hpp"
 #include "NMEA/ThermalLocator.hpp"
 
@@ -32,22 +31,6 @@ Copyright_License {
 
 #include <cassert>
 
-inline void
-ThermalLocator::Point::Drift(double t, const FlatProjection &projection,
-                             const GeoPoint& wind_drift)
-{
-  const auto dt = t - t_0;
-
-  // thermal decay function is located in GenerateSineTables.cpp
-  recency_weight = thermal_recency_fn((unsigned)fabs(dt));
-  lift_weight = w*recency_weight;
-
-  GeoPoint p = location + wind_drift * dt;
-
-  // convert to flat earth coordinates
-  loc_drift = projection.ProjectFloat(p);
-}
-
 void
 ThermalLocator::Reset()
 {
@@ -56,12 +39,15 @@ ThermalLocator::Reset()
 }
 
 inline void
-ThermalLocator::AddPoint(const double t, const GeoPoint &location, const double w)
+ThermalLocator::AddPoint(const double t, const GeoPoint &location, const double _w)
 {
-  points[n_index].location = location;
-  points[n_index].t_0 = t;
-  points[n_index].w = std::max(w, -0.1);
-  // lift_weight and recency_weight are set by Drift()
+  if (n_points == 0)
+    reference = location;
+
+  latitude[n_index] = (location.latitude - reference.latitude).AsDelta().Native();
+  longitude[n_index] = (location.longitude - reference.longitude).AsDelta().Native();
+  t_0[n_index] = t;
+  w[n_index] = std::max(_w, -0.1);
 
   n_index = (n_index + 1) % TLOCATOR_NMAX;
 
@@ -70,7 +56,7 @@ ThermalLocator::AddPoint(const double t, const GeoPoint &location, const double
 }
 
 void
-ThermalLocator::Update(const double t_0,
+ThermalLocator::Update(const double t,
                        const GeoPoint &location_0,
                        const SpeedVector wind, 
                        ThermalLocatorInfo &therm)
@@ -82,19 +68,28 @@ ThermalLocator::Update(const double t_0,
 
   GeoPoint dloc = FindLatitudeLongitude(location_0, wind.bearing, wind.norm);
 
-  const FlatProjection projection(location_0);
-
-  // drift points 
-  Drift(t_0, projection, location_0 - dloc);
+  /* the distance the air mass drifts per second */
+  const GeoPoint traildrift = location_0 - dloc;
+  const double drift_latitude = traildrift.latitude.Native();
+  const double drift_longitude = traildrift.longitude.Native();
 
-  FlatPoint av = glider_average();
-  // find thermal center relative to glider's average position
+  /* thermal decay function is located in GenerateSineTables.cpp;
+     look up all weights first, so the loop below has no calls */
+  double recency_weight[TLOCATOR_NMAX];
+  for (unsigned i = 0; i < n_points; ++i)
+    recency_weight[i] = thermal_recency_fn((unsigned)fabs(t - t_0[i]));
 
-  FlatPoint f0(0, 0);
-  double acc = 0;
+  /* find the thermal center: the lift-weighted average of the
+     drifted sample locations; this is done in angular coordinates,
+     because the flat projection used for that previously is linear
+     at this scale */
+  double sum_latitude = 0, sum_longitude = 0, acc = 0;
   for (unsigned i = 0; i < n_points; ++i) {
-    f0 += (points[i].loc_drift-av)*points[i].lift_weight;
-    acc += points[i].lift_weight;
+    const double dt = t - t_0[i];
+    const double lift_weight = w[i] * recency_weight[i];
+    sum_latitude += (latitude[i] + drift_latitude * dt) * lift_weight;
+    sum_longitude += (longitude[i] + drift_longitude * dt) * lift_weight;
+    acc += lift_weight;
   }
 
   // if sufficient data, estimate location
@@ -103,43 +98,13 @@ ThermalLocator::Update(const double t_0,
     therm.estimate_valid = false;
     return;
   }
-  f0 = f0 * (1. / acc) + av;
 
-  therm.estimate_location = projection.Unproject(f0);
+  therm.estimate_location =
+    GeoPoint((reference.longitude + Angle::Native(sum_longitude / acc)).AsDelta(),
+             (reference.latitude + Angle::Native(sum_latitude / acc)).AsDelta());
   therm.estimate_valid = true;
 }
 
-inline FlatPoint
-ThermalLocator::glider_average()
-{
-  FlatPoint result(0, 0);
-  assert(n_points>0);
-  if (n_points == 0)
-    return result;
-
-  // find glider's average position
-  double acc = 0;
-  for (unsigned i = 0; i < n_points; ++i) {
-    result += points[i].loc_drift*points[i].recency_weight;
-    acc += points[i].recency_weight;
-  }
-
-  if (acc > 0) {
-    result.x /= acc;
-    result.y /= acc;
-  }
-
-  return result;
-}
-
-inline void
-ThermalLocator::Drift(const double t_0, const FlatProjection &projection,
-                      const GeoPoint& traildrift)
-{
-  for (unsigned i = 0; i < n_points; ++i)
-    points[i].Drift(t_0, projection, traildrift);
-}
-
 void
 ThermalLocator::Process(const bool circling, const double time,
                         const GeoPoint &location, const double w,
@@ -25,10 +25,8 @@ Copyright_License {
 #define THERMALLOCATOR_H
 
 #include "Geo/GeoPoint.hpp"
-#include "Geo/Flat/FlatPoint.hpp"
 
 struct SpeedVector;
-class FlatProjection;
 struct ThermalLocatorInfo;
 
 /**
@@ -41,36 +39,24 @@ public:
   static constexpr unsigned TLOCATOR_NMAX = 60;
 
 private:
-  /** Class used to hold thermal estimate samples */
-  struct Point 
-  {
-    /** 
-     * Calculate drifted, weighted values of point
-     * 
-     * @param t Current time
-     * @param location_0 Initial location
-     * @param wind_drift Wind drift offset
-     * @param decay decay factor for weighting
-     */
-    void Drift(double t, const FlatProjection &projection,
-               const GeoPoint& wind_drift);
-
-    /** Actual location of sample */
-    GeoPoint location;
-    /** Projected/drifted sample */
-    FlatPoint loc_drift;
-    /** Time of sample (s) */
-    double t_0;
-    /** Scaled updraft value of sample */
-    double w;
-    /** Lift weighting used for this point */
-    double lift_weight;
-    /** Recency weighting used for this point */
-    double recency_weight;
-  };
-
-  /** Circular buffer of points */
-  Point points[TLOCATOR_NMAX];
+  /**
+   * The location of the first sample after Reset().  All sample
+   * locations are stored relative to this point, which keeps them
+   * small and allows averaging them without projecting each one.
+   */
+  GeoPoint reference;
+
+  /*
+   * Circular buffer of samples, stored as a structure of arrays, so
+   * Update() can process them in a vectorisable loop.
+   */
+
+  /** Location of sample relative to #reference (radians) */
+  double latitude[TLOCATOR_NMAX], longitude[TLOCATOR_NMAX];
+  /** Time of sample (s) */
+  double t_0[TLOCATOR_NMAX];
+  /** Scaled updraft value of sample */
+  double w[TLOCATOR_NMAX];
 
   /** Index of next point to add */
   unsigned n_index;
@@ -99,14 +85,9 @@ public:
   void Reset();
 
 private:
-  FlatPoint glider_average();
-
   void AddPoint(double t, const GeoPoint &location, double w);
   void Update(double t_0, const GeoPoint &location_0,
               SpeedVector wind, ThermalLocatorInfo &therm);
-
-  void Drift(double t_0, const FlatProjection &projection,
-             const GeoPoint &traildrift);
 };
 
 #endif
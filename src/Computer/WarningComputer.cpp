@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "WarningComputer.hpp"
+#include "WarningThread.hpp"
 #include "Settings.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "NMEA/MoreData.hpp"
@@ -29,6 +30,8 @@ Copyright_License {
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
 
+#include <cassert>
+
 WarningComputer::WarningComputer(const AirspaceWarningConfig &_config,
                                  Airspaces &_airspaces)
   :airspaces(_airspaces),
@@ -37,6 +40,43 @@ WarningComputer::WarningComputer(const AirspaceWarningConfig &_config,
 {
 }
 
+WarningComputer::~WarningComputer()
+{
+  DisableThread();
+}
+
+void
+WarningComputer::EnableThread(std::function<void()> &&callback)
+{
+  assert(!thread);
+
+  thread = std::make_unique<WarningThread>(protected_manager,
+                                           std::move(callback));
+}
+
+void
+WarningComputer::DisableThread()
+{
+  if (thread) {
+    thread->LockStop();
+    thread.reset();
+  }
+}
+
+bool
+WarningComputer::ReadResult(AirspaceWarningsInfo &result)
+{
+  if (!thread)
+    return false;
+
+  const AirspaceWarningsInfo new_result = thread->GetResult();
+  if (new_result.latest == result.latest)
+    return false;
+
+  result = new_result;
+  return true;
+}
+
 void
 WarningComputer::Update(const ComputerSettings &settings_computer,
                         const MoreData &basic,
@@ -63,13 +103,28 @@ WarningComputer::Update(const ComputerSettings &settings_computer,
       !basic.location_available || !basic.NavAltitudeAvailable()) {
     if (initialised) {
       initialised = false;
-      protected_manager.Clear();
+
+      if (thread)
+        thread->Clear();
+      else
+        protected_manager.Clear();
     }
 
     return;
   }
 
   const AircraftState as = ToAircraftState(basic, calculated);
+
+  if (thread) {
+    thread->Submit(as, settings_computer.airspace.warnings,
+                   settings_computer.polar.glide_polar_task,
+                   calculated.task_stats,
+                   calculated.circling,
+                   uround(dt), !initialised, basic.clock);
+    initialised = true;
+    return;
+  }
+
   ProtectedAirspaceWarningManager::ExclusiveLease lease(protected_manager);
 
   lease->SetConfig(settings_computer.airspace.warnings);
@@ -28,7 +28,11 @@ Copyright_License {
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
 #include "time/DeltaTime.hpp"
 
+#include <functional>
+#include <memory>
+
 class Airspaces;
+class WarningThread;
 struct ComputerSettings;
 struct MoreData;
 struct DerivedInfo;
@@ -45,11 +49,36 @@ class WarningComputer {
   AirspaceWarningManager manager;
   ProtectedAirspaceWarningManager protected_manager;
 
+  /**
+   * If set, then AirspaceWarningManager::Update() is performed in
+   * this thread instead of the caller's.
+   */
+  std::unique_ptr<WarningThread> thread;
+
   bool initialised;
 
 public:
   WarningComputer(const AirspaceWarningConfig &_config,
                   Airspaces &_airspaces);
+  ~WarningComputer();
+
+  /**
+   * Move the warning evaluation to a dedicated #WarningThread.
+   *
+   * @param callback invoked in the #WarningThread after a new
+   * warning has been published
+   */
+  void EnableThread(std::function<void()> &&callback);
+
+  /**
+   * Stop the #WarningThread (if any) and return to synchronous
+   * evaluation.
+   */
+  void DisableThread();
+
+  WarningThread *GetThread() {
+    return thread.get();
+  }
 
   ProtectedAirspaceWarningManager &GetManager() {
     return protected_manager;
@@ -59,11 +88,23 @@ public:
     return protected_manager;
   }
 
+  /**
+   * Copy the most recent result published by the #WarningThread.
+   *
+   * @return true if there is a new warning
+   */
+  bool ReadResult(AirspaceWarningsInfo &result);
+
   void Reset() {
     delta_time.Reset();
     initialised = false;
   }
 
+  /**
+   * Update the airspace warnings.  If the #WarningThread is enabled,
+   * this only submits the new state to it; call ReadResult() to
+   * obtain the result.
+   */
   void Update(const ComputerSettings &settings_computer,
               const MoreData &basic,
               const DerivedInfo &calculated,
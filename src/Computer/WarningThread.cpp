@@ -0,0 +1,136 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WarningThread.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "system/Clock.hpp"
+
+#include <algorithm>
+
+WarningThread::WarningThread(ProtectedAirspaceWarningManager &_manager,
+                             std::function<void()> &&_callback)
+  :StandbyThread("Warning"), manager(_manager),
+   callback(std::move(_callback))
+{
+  result.Clear();
+  stats.Clear();
+}
+
+void
+WarningThread::Submit(const AircraftState &state,
+                      const AirspaceWarningConfig &config,
+                      const GlidePolar &glide_polar,
+                      const TaskStats &task_stats,
+                      bool circling, unsigned dt, bool reset,
+                      double clock) noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  if (update_pending) {
+    /* the previous request has not been processed yet; replace it,
+       but keep its time step for the state filters */
+    ++stats.n_dropped;
+    dt += next.dt;
+  }
+
+  next.state = state;
+  next.config = config;
+  next.glide_polar = glide_polar;
+  next.task_stats = task_stats;
+  next.clock = clock;
+  next.submit_time = MonotonicClockFloat();
+  next.dt = dt;
+  next.circling = circling;
+
+  update_pending = true;
+  if (reset)
+    reset_pending = true;
+
+  StandbyThread::Trigger();
+}
+
+void
+WarningThread::Clear() noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+
+  update_pending = reset_pending = false;
+  clear_pending = true;
+
+  StandbyThread::Trigger();
+}
+
+void
+WarningThread::Tick() noexcept
+{
+  bool changed = false;
+
+  while ((clear_pending || update_pending) && !IsStopped()) {
+    if (clear_pending) {
+      clear_pending = false;
+
+      const ScopeUnlock unlock(mutex);
+      manager.Clear();
+      continue;
+    }
+
+    const Request request = next;
+    const bool reset = reset_pending;
+    update_pending = reset_pending = false;
+
+    bool updated;
+
+    {
+      const ScopeUnlock unlock(mutex);
+
+      ProtectedAirspaceWarningManager::ExclusiveLease lease(manager);
+      lease->SetConfig(request.config);
+
+      if (reset)
+        lease->Reset(request.state);
+
+      updated = lease->Update(request.state, request.glide_polar,
+                              request.task_stats, request.circling,
+                              request.dt);
+    }
+
+    const double latency = MonotonicClockFloat() - request.submit_time;
+
+    ++stats.n_updates;
+    stats.latency = latency;
+    stats.max_latency = std::max(stats.max_latency, latency);
+
+    if (updated) {
+      stats.warning_latency = latency;
+      result.latest.Update(request.clock);
+      changed = true;
+    }
+  }
+
+  /* notify the client about the new warning */
+  if (changed && callback) {
+    const ScopeUnlock unlock(mutex);
+    callback();
+  }
+}
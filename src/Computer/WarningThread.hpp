@@ -0,0 +1,185 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WARNING_THREAD_HPP
+#define XCSOAR_WARNING_THREAD_HPP
+
+#include "thread/StandbyThread.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Airspace/AirspaceWarningConfig.hpp"
+#include "Engine/GlideSolvers/GlidePolar.hpp"
+#include "Engine/Task/Stats/TaskStats.hpp"
+#include "NMEA/Derived.hpp"
+
+#include <functional>
+
+class ProtectedAirspaceWarningManager;
+
+/**
+ * A thread which evaluates airspace warnings in background, so a
+ * large airspace database does not delay the other calculations.
+ * The #CalculationThread submits #AircraftState snapshots; this
+ * thread updates the #AirspaceWarningManager and publishes the
+ * result as #AirspaceWarningsInfo.
+ */
+class WarningThread final : private StandbyThread {
+  ProtectedAirspaceWarningManager &manager;
+
+  /**
+   * This callback is invoked (without holding the mutex) after a
+   * new warning has been published.
+   */
+  const std::function<void()> callback;
+
+  /**
+   * The parameters for the next AirspaceWarningManager::Update()
+   * call.  Protected by #mutex.
+   */
+  struct Request {
+    AircraftState state;
+    AirspaceWarningConfig config;
+    GlidePolar glide_polar;
+    TaskStats task_stats;
+
+    /**
+     * The NMEAInfo::clock value of the fix this request was created
+     * from.  This is virtual time during replay; it is only used to
+     * stamp the result.
+     */
+    double clock;
+
+    /**
+     * The MonotonicClockFloat() value when this request was
+     * submitted; the latency is measured against this.
+     */
+    double submit_time;
+
+    /**
+     * The accumulated time step [s] since the last request that was
+     * processed.  Requests which are superseded before the thread
+     * picks them up add their time step to the next one.
+     */
+    unsigned dt;
+
+    bool circling;
+  } next;
+
+  bool update_pending = false;
+
+  /**
+   * Reset the manager before the next update?
+   */
+  bool reset_pending = false;
+
+  /**
+   * Clear the manager and discard the pending update?
+   */
+  bool clear_pending = false;
+
+  AirspaceWarningsInfo result;
+
+public:
+  struct Stats {
+    /**
+     * The number of AirspaceWarningManager::Update() calls.
+     */
+    unsigned n_updates;
+
+    /**
+     * The number of requests which were superseded by a newer one
+     * before the thread was able to process them.
+     */
+    unsigned n_dropped;
+
+    /**
+     * The delay [s] between submitting the most recent update and
+     * finishing its evaluation, and the maximum of this value.
+     */
+    double latency, max_latency;
+
+    /**
+     * The latency [s] of the most recent update which produced a
+     * new warning.
+     */
+    double warning_latency;
+
+    void Clear() {
+      n_updates = n_dropped = 0;
+      latency = max_latency = warning_latency = 0;
+    }
+  };
+
+private:
+  Stats stats;
+
+public:
+  WarningThread(ProtectedAirspaceWarningManager &_manager,
+                std::function<void()> &&_callback);
+
+  using StandbyThread::LockStop;
+
+  /**
+   * Wait until all pending requests have been processed.
+   */
+  using StandbyThread::LockWaitDone;
+
+  /**
+   * Schedule an update with the given aircraft state.  If the thread
+   * is still busy with the previous one, the new request replaces
+   * the pending one.
+   *
+   * @param reset reset the manager to the given state first
+   * @param clock the NMEAInfo::clock value of the fix
+   */
+  void Submit(const AircraftState &state,
+              const AirspaceWarningConfig &config,
+              const GlidePolar &glide_polar,
+              const TaskStats &task_stats,
+              bool circling, unsigned dt, bool reset,
+              double clock) noexcept;
+
+  /**
+   * Schedule clearing the warning list and discard the pending
+   * update.
+   */
+  void Clear() noexcept;
+
+  /**
+   * Returns the most recently published result.
+   */
+  AirspaceWarningsInfo GetResult() noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return result;
+  }
+
+  Stats GetStats() noexcept {
+    const std::lock_guard<Mutex> lock(mutex);
+    return stats;
+  }
+
+private:
+  /* virtual methods from class StandbyThread*/
+  void Tick() noexcept override;
+};
+
+#endif
@@ -151,12 +151,34 @@ CirclingWind::CalcWind()
   if ((samples.back().time - samples[0].time) / (samples.size() - 1) > 2)
     return Result(0);
 
+  const unsigned n = samples.size();
+
+  /* copy the speeds to a contiguous array, twice, so the circular
+     correlation below can index it without modulo arithmetic */
+  double norm[2 * MAX_SAMPLES];
+
   // find average
   double av = 0;
-  for (unsigned i = 0; i < samples.size(); i++)
-    av += samples[i].vector.norm;
+  for (unsigned i = 0; i < n; i++) {
+    norm[i] = norm[n + i] = samples[i].vector.norm;
+    av += norm[i];
+  }
 
-  av /= samples.size();
+  av /= n;
+
+  /* for each start sample j, the sum of all speeds weighted with
+     their (circular) distance from j; this is evaluated for all j at
+     once, so the inner loop vectorises without changing the order of
+     the additions for each j */
+  double rthisp[MAX_SAMPLES];
+  std::fill_n(rthisp, n, 0.);
+
+  for (unsigned i = 1; i < n; i++) {
+    const double idiff = i > n / 2 ? n - i : i;
+    const double *src = norm + i;
+    for (unsigned j = 0; j < n; j++)
+      rthisp[j] += src[j] * idiff;
+  }
 
   // find zero time for times above average
   double rthismax = 0;
@@ -164,26 +186,14 @@ CirclingWind::CalcWind()
   int jmax = -1;
   int jmin = -1;
 
-  for (unsigned j = 0; j < samples.size(); j++) {
-    double rthisp = 0;
-
-    for (unsigned i = 1; i < samples.size(); i++) {
-      const unsigned ithis = (i + j) % samples.size();
-      unsigned idiff = i;
-
-      if (idiff > samples.size() / 2)
-        idiff = samples.size() - idiff;
-
-      rthisp += samples[ithis].vector.norm * idiff;
-    }
-
-    if ((rthisp < rthismax) || (jmax == -1)) {
-      rthismax = rthisp;
+  for (unsigned j = 0; j < n; j++) {
+    if ((rthisp[j] < rthismax) || (jmax == -1)) {
+      rthismax = rthisp[j];
       jmax = j;
     }
 
-    if ((rthisp > rthismin) || (jmin == -1)) {
-      rthismin = rthisp;
+    if ((rthisp[j] > rthismin) || (jmin == -1)) {
+      rthismin = rthisp[j];
       jmin = j;
     }
   }
@@ -36,6 +36,8 @@ struct CirclingInfo;
  */
 class CirclingWind
 {
+  static constexpr unsigned MAX_SAMPLES = 50;
+
   /**
    * The windanalyser analyses the list of flightsamples looking for
    * windspeed and direction.
@@ -60,7 +62,7 @@ class CirclingWind
 
   Angle last_track;
 
-  StaticArray<Sample, 50> samples;
+  StaticArray<Sample, MAX_SAMPLES> samples;
 
 public:
   struct Result
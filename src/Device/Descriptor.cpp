@@ -1240,9 +1240,15 @@ DeviceDescriptor::DataReceived(const void *data, size_t length) noexcept
     return true;
   }
 
-  if (!IsNMEAOut())
+  if (!IsNMEAOut()) {
     PortLineSplitter::DataReceived(data, length);
 
+    if (merge_pending) {
+      merge_pending = false;
+      device_blackboard->ScheduleMerge();
+    }
+  }
+
   return true;
 }
 
@@ -1255,7 +1261,7 @@ DeviceDescriptor::LineReceived(const char *line) noexcept
     dispatcher->LineReceived(line);
 
   if (ParseLine(line))
-    device_blackboard->ScheduleMerge();
+    merge_pending = true;
 
   return true;
 }
@@ -241,6 +241,15 @@ class DeviceDescriptor final : PortListener, PortLineSplitter {
    */
   bool borrowed;
 
+  /**
+   * Set by LineReceived() when a line has updated the device
+   * blackboard; DataReceived() schedules one merge for all lines it
+   * has received.
+   *
+   * This attribute is only accessed from the port's receive thread.
+   */
+  bool merge_pending = false;
+
 public:
   DeviceDescriptor(EventLoop &_event_loop, Cares::Channel &_cares,
                    unsigned index, PortListener *port_listener);
@@ -22,10 +22,9 @@ Copyright_License {
 */
 
 #include "LineSplitter.hpp"
-#include "util/TextFile.hxx"
 #include "util/StringStrip.hxx"
 
-#include <algorithm>
+#include <cassert>
 
 #include <string.h>
 
@@ -37,12 +36,31 @@ IsInsaneChar(char ch)
 }
 
 /**
- * Replace all control characters with a regular space character.
+ * Append data to the current line, replacing all control characters
+ * with a regular space character.
  */
-static void
-SanitiseLine(char *const begin, char *const end)
+inline void
+PortLineSplitter::Append(const char *src, const char *const end) noexcept
 {
-  std::replace_if(begin, end, IsInsaneChar, ' ');
+  if (line_length + (end - src) > MAX_LINE_LENGTH) {
+    /* overflow: discard this line to recover quickly */
+    overflow = true;
+    return;
+  }
+
+  char *dest = line + line_length;
+  for (; src != end; ++src) {
+    const char ch = *src;
+    if (ch == 0)
+      /* if there are NUL bytes in the line, skip to after the last
+         one, to avoid conflicts with NUL terminated C strings due to
+         binary garbage */
+      dest = line;
+    else
+      *dest++ = IsInsaneChar(ch) ? ' ' : ch;
+  }
+
+  line_length = dest - line;
 }
 
 bool
@@ -51,48 +69,36 @@ PortLineSplitter::DataReceived(const void *_data, size_t length) noexcept
   assert(_data != nullptr);
   assert(length > 0);
 
-  const char *data = (const char *)_data, *end = data + length;
-
-  do {
-    /* append new data to buffer, as much as fits there */
-    auto range = buffer.Write();
-    if (range.empty()) {
-      /* overflow: reset buffer to recover quickly */
-      buffer.Clear();
-      continue;
+  const char *data = (const char *)_data, *const end = data + length;
+
+  while (true) {
+    /* memchr() is vectorised by the C library */
+    const char *newline = (const char *)memchr(data, '\n', end - data);
+    if (newline == nullptr) {
+      /* no newline here: keep the partial line and wait for more
+         data */
+      if (!overflow)
+        Append(data, end);
+      return true;
     }
 
-    size_t nbytes = std::min(size_t(range.size), size_t(end - data));
-    memcpy(range.data, data, nbytes);
-    data += nbytes;
-    buffer.Append(nbytes);
-
-    while (true) {
-      /* read data from the buffer, to see if there's a newline
-         character */
-      char *line = ReadBufferedLine(buffer);
-      if (line == nullptr)
-        /* no newline here: wait for more data */
-        break;
-
-      char *end = line + strlen(line);
+    if (!overflow)
+      Append(data, newline);
 
-      /* remove trailing whitespace, such as '\r' */
-      end = StripRight(line, end);
+    data = newline + 1;
 
-      SanitiseLine(line, end);
-
-      /* if there are NUL bytes in the line, skip to after the last
-         one, to avoid conflicts with NUL terminated C strings due to
-         binary garbage */
-      void *nul;
-      while ((nul = memchr(line, 0, end - line)) != nullptr)
-        line = (char *)nul + 1;
-
-      if (!LineReceived(line))
-        return false;
+    if (overflow) {
+      overflow = false;
+      line_length = 0;
+      continue;
     }
-  } while (data < end);
 
-  return true;
+    /* remove trailing whitespace, such as '\r' (which was converted
+       to a space by Append()) */
+    line[StripRight(line, line_length)] = 0;
+    line_length = 0;
+
+    if (!LineReceived(line))
+      return false;
+  }
 }
@@ -26,16 +26,42 @@ Copyright_License {
 
 #include "io/DataHandler.hpp"
 #include "LineHandler.hpp"
-#include "util/StaticFifoBuffer.hxx"
 
+#include <cstddef>
+
+/**
+ * Splits the received data into lines and passes each one to
+ * PortLineHandler::LineReceived().  The received buffer is scanned in
+ * place for line feeds; each line is copied only once (and sanitised
+ * on the way) to make it a null-terminated string, and all complete
+ * lines of one DataReceived() call are handled in one batch.
+ */
 class PortLineSplitter : public DataHandler, protected PortLineHandler {
-  typedef StaticFifoBuffer<char, 256u> Buffer;
+  /**
+   * Longer lines are discarded.
+   */
+  static constexpr std::size_t MAX_LINE_LENGTH = 255;
+
+  /**
+   * The line being assembled; it may be incomplete, i.e. waiting for
+   * more data.
+   */
+  char line[MAX_LINE_LENGTH + 1];
 
-  Buffer buffer;
+  std::size_t line_length = 0;
+
+  /**
+   * The current line was too long; discard everything until the next
+   * line feed.
+   */
+  bool overflow = false;
 
 public:
   /* virtual methods from class DataHandler */
   bool DataReceived(const void *data, size_t length) noexcept override;
+
+private:
+  void Append(const char *src, const char *end) noexcept;
 };
 
 #endif
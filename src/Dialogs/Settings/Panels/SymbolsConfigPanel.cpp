@@ -42,6 +42,7 @@ enum ControlIndex {
   AIRCRAFT_SYMBOL,
   WIND_ARROW_STYLE,
   SKYLINES_TRAFFIC_MAP_MODE,
+  SHOW_LIFT_MAP,
 };
 
 class SymbolsConfigPanel final
@@ -197,6 +198,12 @@ SymbolsConfigPanel::Prepare(ContainerWindow &parent,
           _("Show the SkyLines traffic symbols/names on the map, downloaded from the SkyLines server."),
           skylines_map_mode_list, (unsigned)settings_map.skylines_traffic_map_mode);
 
+  AddBoolean(_("Lift history"),
+             _("Mark the places where lift of at least 1 m/s was found on earlier flights "
+               "(up to 30 days ago). Shown at close map scales only."),
+             settings_map.show_lift_map);
+  SetExpertRow(SHOW_LIFT_MAP);
+
   ShowTrailControls(settings_map.trail.length != TrailSettings::Length::OFF);
 }
 
@@ -232,6 +239,9 @@ SymbolsConfigPanel::Save(bool &_changed) noexcept
   changed |= SaveValueEnum(SKYLINES_TRAFFIC_MAP_MODE, ProfileKeys::SkyLinesTrafficMapMode,
                            settings_map.skylines_traffic_map_mode);
 
+  changed |= SaveValue(SHOW_LIFT_MAP, ProfileKeys::ShowLiftMap,
+                       settings_map.show_lift_map);
+
   _changed |= changed;
 
   return true;
@@ -64,7 +64,7 @@ class TaskListPanel final
   std::unique_ptr<OrderedTask> &active_task;
   bool *task_modified;
 
-  TaskStore task_store;
+  TaskStore task_store{[this]{ OnTaskStoreUpdated(); }};
   unsigned serial;
 
   /**
@@ -109,6 +109,11 @@ public:
 
   void OnMoreClicked();
 
+  /**
+   * The #TaskStore has parsed more task files in the background.
+   */
+  void OnTaskStoreUpdated() noexcept;
+
   void Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept override;
   void Show(const PixelRect &rc) noexcept override;
   void Hide() noexcept override;
@@ -319,6 +324,22 @@ TaskListPanel::OnMoreClicked()
   RefreshView();
 }
 
+void
+TaskListPanel::OnTaskStoreUpdated() noexcept
+{
+  auto &list = GetList();
+  const unsigned cursor = task_store.ReceiveResults(list.GetCursorIndex());
+
+  if (!list.IsVisible())
+    /* Show() will refresh the view */
+    return;
+
+  list.SetLength(task_store.Size());
+  list.SetCursorIndex(cursor);
+  list.Invalidate();
+  RefreshView();
+}
+
 void
 TaskListPanel::Prepare(ContainerWindow &parent, const PixelRect &rc) noexcept
 {
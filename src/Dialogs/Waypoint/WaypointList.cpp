@@ -35,7 +35,7 @@ Copyright_License {
 #include "Profile/ProfileKeys.hpp"
 #include "Waypoint/LastUsed.hpp"
 #include "Waypoint/WaypointList.hpp"
-#include "Waypoint/WaypointListBuilder.hpp"
+#include "Waypoint/WaypointListQuery.hpp"
 #include "Waypoint/WaypointFilter.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "Components.hpp"
@@ -127,14 +127,18 @@ class WaypointListWidget final
 
   WaypointList items;
 
+  /**
+   * Remembers the filter which produced #items, so typing into the
+   * name field narrows the previous result instead of querying all
+   * waypoints again.
+   */
+  WaypointListQuery query;
+
   TwoTextRowsRenderer row_renderer;
 
   const GeoPoint location;
   Angle last_heading;
 
-  OrderedTask *const ordered_task;
-  const unsigned ordered_task_index;
-
 public:
   WaypointListWidget(WndForm &_dialog,
                      WaypointFilterWidget &_filter_widget,
@@ -143,9 +147,8 @@ public:
                      unsigned _ordered_task_index)
     :dialog(_dialog),
      filter_widget(_filter_widget),
-     location(_location), last_heading(_heading),
-     ordered_task(_ordered_task),
-     ordered_task_index(_ordered_task_index) {}
+     query(_location, _ordered_task, _ordered_task_index),
+     location(_location), last_heading(_heading) {}
 
   void UpdateList();
 
@@ -266,22 +269,19 @@ WaypointFilterWidget::Update(Angle _last_heading)
 }
 
 static void
-FillList(WaypointList &list, const Waypoints &src,
-         GeoPoint location, Angle heading, const WaypointListDialogState &state,
-         OrderedTask *ordered_task, unsigned ordered_task_index)
+FillList(WaypointList &list, WaypointListQuery &query, const Waypoints &src,
+         Angle heading, const WaypointListDialogState &state)
 {
-  if (!state.IsDefined() && src.size() >= 500)
+  if (!state.IsDefined() && src.size() >= 500) {
+    list.clear();
+    query.Invalidate();
     return;
+  }
 
   WaypointFilter filter;
   state.ToFilter(filter, heading);
 
-  WaypointListBuilder builder(filter, location, list,
-                              ordered_task, ordered_task_index);
-  builder.Visit(src);
-
-  if (filter.distance > 0 || !filter.direction.IsNegative())
-    list.SortByDistance(location);
+  query.Update(src, filter, list);
 }
 
 static void
@@ -301,15 +301,13 @@ FillLastUsedList(WaypointList &list,
 void
 WaypointListWidget::UpdateList()
 {
-  items.clear();
-
-  if (dialog_state.type_index == TypeFilter::LAST_USED)
+  if (dialog_state.type_index == TypeFilter::LAST_USED) {
+    items.clear();
+    query.Invalidate();
     FillLastUsedList(items, LastUsedWaypoints::GetList(),
                      way_points);
-  else
-    FillList(items, way_points, location, last_heading,
-             dialog_state,
-             ordered_task, ordered_task_index);
+  } else
+    FillList(items, query, way_points, last_heading, dialog_state);
 
   auto &list = GetList();
   list.SetLength(std::max(1u, (unsigned)items.size()));
@@ -41,6 +41,23 @@ DrawThread::Run() noexcept
   // circle until application is closed
   while (!_CheckStoppedOrSuspended(lock)) {
     if (!pending) {
+      if (map.HasPrefetchWork()) {
+        /* nothing to draw; use the idle time to prerender terrain
+           tiles which are likely to become visible soon */
+        bool prefetched;
+        {
+          const ScopeUnlock unlock(mutex);
+          prefetched = map.PrefetchTerrainTile();
+        }
+
+        /* if no tile could be rendered (the cache is full until the
+           next frame), fall through and wait instead of spinning;
+           but don't miss a command which arrived while the mutex
+           was unlocked */
+        if (prefetched || pending || _IsCommandPending())
+          continue;
+      }
+
       command_trigger.wait(lock);
       continue;
     }
@@ -53,7 +70,10 @@ DrawThread::Run() noexcept
     const ScopeLockCPU cpu;
 #endif
 
+    const RenderProfiler::ScopeFrame profile_frame(map.draw_sw);
+
     // Get data from the DeviceBlackboard
+    map.draw_sw.Mark("ExchangeBlackboard");
     map.ExchangeBlackboard();
 
     // Draw the moving map
@@ -23,136 +23,182 @@ Copyright_License {
 
 #include "FLARM/FlarmComputer.hpp"
 #include "FLARM/FlarmDetails.hpp"
+#include "FLARM/Data.hpp"
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 
+/**
+ * Remove targets from the store which have not been seen for this
+ * number of seconds.  This is the period of the climb rate history.
+ */
+static constexpr double MAX_AGE = 60;
+
+/**
+ * Derive climb rate, track, turn rate and speed from the previous
+ * update only if it is at most this old.
+ */
+static constexpr std::chrono::seconds MAX_PREVIOUS_AGE(5);
+
 void
-FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
-                       const NMEAInfo &basic)
+FlarmComputer::UpdateProjection(const GeoPoint &location)
 {
-  // Cleanup old calculation instances
-  if (basic.time_available)
-    flarm_calculations.CleanUp(basic.time);
-
-  // if (FLARM data is available)
-  if (!flarm.IsDetected())
+  if (location == projection_origin)
     return;
 
-  double north_to_latitude(0);
-  double east_to_longitude(0);
+  projection_origin = location;
+  north_to_latitude = east_to_longitude = 0;
 
-  if (basic.location_available) {
-    // Precalculate relative east and north projection to lat/lon
-    // for Location calculations of each target
-    constexpr Angle delta_lat = Angle::Degrees(0.01);
-    constexpr Angle delta_lon = Angle::Degrees(0.01);
+  // Precalculate relative east and north projection to lat/lon
+  // for Location calculations of each target
+  constexpr Angle delta_lat = Angle::Degrees(0.01);
+  constexpr Angle delta_lon = Angle::Degrees(0.01);
 
-    GeoPoint plat = basic.location;
-    plat.latitude += delta_lat;
-    GeoPoint plon = basic.location;
-    plon.longitude += delta_lon;
+  GeoPoint plat = location;
+  plat.latitude += delta_lat;
+  GeoPoint plon = location;
+  plon.longitude += delta_lon;
 
-    double dlat = basic.location.DistanceS(plat);
-    double dlon = basic.location.DistanceS(plon);
+  double dlat = location.DistanceS(plat);
+  double dlon = location.DistanceS(plon);
 
-    if (fabs(dlat) > 0 && fabs(dlon) > 0) {
-      north_to_latitude = delta_lat.Degrees() / dlat;
-      east_to_longitude = delta_lon.Degrees() / dlon;
-    }
+  if (fabs(dlat) > 0 && fabs(dlon) > 0) {
+    north_to_latitude = delta_lat.Degrees() / dlat;
+    east_to_longitude = delta_lon.Degrees() / dlon;
   }
+}
 
-  // for each item in traffic
-  for (auto &traffic : flarm.traffic.list) {
-    // if we don't know the target's name yet
-    if (!traffic.HasName()) {
-      // lookup the name of this target's id
-      const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
-      if (fname != NULL)
-        traffic.name = fname;
-    }
+void
+FlarmComputer::UpdateTraffic(FlarmTraffic &traffic,
+                             const FlarmTraffic &previous,
+                             ClimbAverageCalculator &climb_average,
+                             const NMEAInfo &basic) const
+{
+  // if we don't know the target's name yet
+  if (!traffic.HasName()) {
+    // lookup the name of this target's id
+    const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
+    if (fname != NULL)
+      traffic.name = fname;
+  }
+
+  // Calculate distance
+  traffic.distance = hypot(traffic.relative_north, traffic.relative_east);
+
+  // Calculate Location
+  traffic.location_available = basic.location_available;
+  if (traffic.location_available) {
+    traffic.location.latitude =
+        Angle::Degrees(traffic.relative_north * north_to_latitude) +
+        basic.location.latitude;
+
+    traffic.location.longitude =
+        Angle::Degrees(traffic.relative_east * east_to_longitude) +
+        basic.location.longitude;
+  }
+
+  // Calculate absolute altitude
+  traffic.altitude_available = basic.gps_altitude_available;
+  if (traffic.altitude_available)
+    traffic.altitude = traffic.relative_altitude + RoughAltitude(basic.gps_altitude);
+
+  // Calculate average climb rate
+  traffic.climb_rate_avg30s_available = traffic.altitude_available;
+  if (traffic.climb_rate_avg30s_available)
+    traffic.climb_rate_avg30s =
+      climb_average.GetAverage(basic.time, traffic.altitude, 30);
+
+  // The following calculations are only relevant for targets
+  // where information is missing
+  if (traffic.track_received && traffic.turn_rate_received &&
+      traffic.speed_received && traffic.climb_rate_received)
+    return;
+
+  // Check if the target has been seen before in the last seconds
+  if (!previous.valid)
+    return;
+
+  // Calculate the time difference between now and the last contact
+  const auto dt = traffic.valid.GetTimeDifference(previous.valid);
+  if (dt > MAX_PREVIOUS_AGE)
+    return;
+
+  if (dt.count() > 0) {
+    // Calculate the immediate climb rate
+    if (!traffic.climb_rate_received)
+      traffic.climb_rate =
+        (traffic.relative_altitude - previous.relative_altitude) / dt.count();
+  } else {
+    // Since the time difference is zero (or negative)
+    // we can just copy the old values
+    if (!traffic.climb_rate_received)
+      traffic.climb_rate = previous.climb_rate;
+  }
 
-    // Calculate distance
-    traffic.distance = hypot(traffic.relative_north, traffic.relative_east);
+  if (dt.count() > 0 &&
+      traffic.location_available &&
+      previous.location_available) {
+    // Calculate the GeoVector between now and the last contact
+    GeoVector vec = previous.location.DistanceBearing(traffic.location);
 
-    // Calculate Location
-    traffic.location_available = basic.location_available;
-    if (traffic.location_available) {
-      traffic.location.latitude =
-          Angle::Degrees(traffic.relative_north * north_to_latitude) +
-          basic.location.latitude;
+    if (!traffic.track_received)
+      traffic.track = vec.bearing;
 
-      traffic.location.longitude =
-          Angle::Degrees(traffic.relative_east * east_to_longitude) +
-          basic.location.longitude;
+    // Calculate the turn rate
+    if (!traffic.turn_rate_received) {
+      Angle turn_rate = traffic.track - previous.track;
+      traffic.turn_rate =
+        turn_rate.AsDelta().Degrees() / dt.count();
     }
 
-    // Calculate absolute altitude
-    traffic.altitude_available = basic.gps_altitude_available;
-    if (traffic.altitude_available)
-      traffic.altitude = traffic.relative_altitude + RoughAltitude(basic.gps_altitude);
-
-    // Calculate average climb rate
-    traffic.climb_rate_avg30s_available = traffic.altitude_available;
-    if (traffic.climb_rate_avg30s_available)
-      traffic.climb_rate_avg30s =
-        flarm_calculations.Average30s(traffic.id, basic.time, traffic.altitude);
-
-    // The following calculations are only relevant for targets
-    // where information is missing
-    if (traffic.track_received && traffic.turn_rate_received &&
-        traffic.speed_received && traffic.climb_rate_received)
-      continue;
+    // Calculate the speed [m/s]
+    if (!traffic.speed_received)
+      traffic.speed = vec.distance / dt.count();
+  } else {
+    // Since the time difference is zero (or negative)
+    // we can just copy the old values
+    if (!traffic.track_received)
+      traffic.track = previous.track;
+
+    if (!traffic.turn_rate_received)
+      traffic.turn_rate = previous.turn_rate;
+
+    if (!traffic.speed_received)
+      traffic.speed = previous.speed;
+  }
+}
 
-    // Check if the target has been seen before in the last seconds
-    const FlarmTraffic *last_traffic =
-      last_flarm.traffic.FindTraffic(traffic.id);
-    if (last_traffic == NULL || !last_traffic->valid)
+void
+FlarmComputer::Process(FlarmData &flarm, const NMEAInfo &basic)
+{
+  // Cleanup old calculation instances
+  if (basic.time_available && basic.time != last_expire) {
+    store.Expire(basic.time, MAX_AGE);
+    last_expire = basic.time;
+  }
+
+  // if (FLARM data is available)
+  if (!flarm.IsDetected())
+    return;
+
+  if (basic.location_available)
+    UpdateProjection(basic.location);
+
+  // for each item in traffic
+  for (auto &traffic : flarm.traffic.list) {
+    if (!traffic.id.IsDefined())
       continue;
 
-    // Calculate the time difference between now and the last contact
-    const auto dt = traffic.valid.GetTimeDifference(last_traffic->valid);
-    if (dt.count() > 0) {
-      // Calculate the immediate climb rate
-      if (!traffic.climb_rate_received)
-        traffic.climb_rate =
-          (traffic.relative_altitude - last_traffic->relative_altitude) / dt.count();
-    } else {
-      // Since the time difference is zero (or negative)
-      // we can just copy the old values
-      if (!traffic.climb_rate_received)
-        traffic.climb_rate = last_traffic->climb_rate;
+    FlarmTrafficStore::Entry &entry = store.Insert(traffic.id, basic.time);
+    if (entry.traffic.valid == traffic.valid) {
+      /* no new PFLAA sentence since the last call: restore the
+         derived values */
+      traffic = entry.traffic;
+      continue;
     }
 
-    if (dt.count() > 0 &&
-        traffic.location_available &&
-        last_traffic->location_available) {
-      // Calculate the GeoVector between now and the last contact
-      GeoVector vec = last_traffic->location.DistanceBearing(traffic.location);
-
-      if (!traffic.track_received)
-        traffic.track = vec.bearing;
-
-      // Calculate the turn rate
-      if (!traffic.turn_rate_received) {
-        Angle turn_rate = traffic.track - last_traffic->track;
-        traffic.turn_rate =
-          turn_rate.AsDelta().Degrees() / dt.count();
-      }
-
-      // Calculate the speed [m/s]
-      if (!traffic.speed_received)
-        traffic.speed = vec.distance / dt.count();
-    } else {
-      // Since the time difference is zero (or negative)
-      // we can just copy the old values
-      if (!traffic.track_received)
-        traffic.track = last_traffic->track;
-
-      if (!traffic.turn_rate_received)
-        traffic.turn_rate = last_traffic->turn_rate;
-
-      if (!traffic.speed_received)
-        traffic.speed = last_traffic->speed;
-    }
+    UpdateTraffic(traffic, entry.traffic, entry.climb_average, basic);
+
+    entry.traffic = traffic;
+    entry.last_update = basic.time;
   }
 }
@@ -24,21 +24,65 @@ Copyright_License {
 #ifndef XCSOAR_FLARM_COMPUTER_HPP
 #define XCSOAR_FLARM_COMPUTER_HPP
 
-#include "FLARM/FlarmCalculations.hpp"
+#include "FLARM/TrafficStore.hpp"
+#include "Geo/GeoPoint.hpp"
 
 struct FlarmData;
+struct FlarmTraffic;
 struct NMEAInfo;
 
 class FlarmComputer {
-  FlarmCalculations flarm_calculations;
+  /**
+   * The derived state of each target, from the last PFLAA sentence
+   * which was processed.
+   */
+  FlarmTrafficStore store;
+
+  /**
+   * The own time stamp of the last FlarmTrafficStore::Expire() call.
+   */
+  double last_expire = -1;
+
+  /**
+   * The own location for which #north_to_latitude and
+   * #east_to_longitude were calculated.
+   */
+  GeoPoint projection_origin = GeoPoint::Invalid();
+
+  /**
+   * Factors which convert relative north/east distances [m] to
+   * latitude/longitude [degrees] near #projection_origin.
+   */
+  double north_to_latitude = 0, east_to_longitude = 0;
 
 public:
   /**
    * Calculates location, altitude, average climb speed and
-   * looks up the callsign of each target
+   * looks up the callsign of each target.
+   *
+   * This is called on every merge, but the calculations are only
+   * done for targets which have received a new PFLAA sentence since
+   * the last call; all others get the derived values from the
+   * #FlarmTrafficStore.
+   */
+  void Process(FlarmData &flarm, const NMEAInfo &basic);
+
+  const FlarmTrafficStore &GetStore() const {
+    return store;
+  }
+
+private:
+  void UpdateProjection(const GeoPoint &location);
+
+  /**
+   * Derive all values of a target which has received new data.
+   *
+   * @param previous the state after the previous update of this
+   * target; its #valid attribute is cleared if there is none
    */
-  void Process(FlarmData &flarm, const FlarmData &last_flarm,
-               const NMEAInfo &basic);
+  void UpdateTraffic(FlarmTraffic &traffic, const FlarmTraffic &previous,
+                     ClimbAverageCalculator &climb_average,
+                     const NMEAInfo &basic) const;
 };
 
 #endif
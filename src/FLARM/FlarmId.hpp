@@ -65,6 +65,13 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Returns the raw id, to be mixed by hash table implementations.
+   */
+  constexpr uint32_t Hash() const noexcept {
+    return value;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
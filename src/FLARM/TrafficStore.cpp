@@ -0,0 +1,155 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/TrafficStore.hpp"
+
+#include <cassert>
+
+void
+FlarmTrafficStore::Clear() noexcept
+{
+  for (auto &key : keys)
+    key.Clear();
+
+  size = 0;
+}
+
+int
+FlarmTrafficStore::FindSlot(FlarmId id) const noexcept
+{
+  assert(id.IsDefined());
+
+  /* the table is never full, so this loop always finds an empty
+     slot */
+  for (unsigned i = GetHomeSlot(id);; i = NextSlot(i)) {
+    if (keys[i] == id)
+      return i;
+
+    if (!keys[i].IsDefined())
+      return -1;
+  }
+}
+
+FlarmTrafficStore::Entry *
+FlarmTrafficStore::Find(FlarmId id) noexcept
+{
+  const int i = FindSlot(id);
+  return i >= 0 ? &entries[i] : nullptr;
+}
+
+FlarmTrafficStore::Entry &
+FlarmTrafficStore::Insert(FlarmId id, double now) noexcept
+{
+  assert(id.IsDefined());
+
+  Entry *existing = Find(id);
+  if (existing != nullptr)
+    return *existing;
+
+  if (size >= MAX_SIZE)
+    EvictOldest();
+
+  unsigned i = GetHomeSlot(id);
+  while (keys[i].IsDefined())
+    i = NextSlot(i);
+
+  keys[i] = id;
+  ++size;
+
+  Entry &entry = entries[i];
+  entry.traffic.Clear();
+  entry.traffic.id = id;
+  entry.climb_average.Reset();
+  entry.last_update = now;
+  return entry;
+}
+
+void
+FlarmTrafficStore::RemoveSlot(unsigned i) noexcept
+{
+  assert(keys[i].IsDefined());
+  assert(size > 0);
+
+  /* backward shift deletion: move following entries of the same
+     probe sequence into the gap, so no tombstones are needed */
+  unsigned gap = i;
+  for (unsigned j = NextSlot(i); keys[j].IsDefined(); j = NextSlot(j)) {
+    const unsigned home = GetHomeSlot(keys[j]);
+
+    /* can the entry in slot j be moved to the gap?  Only if its home
+       slot is not (cyclically) between the gap and j */
+    const bool movable = gap <= j
+      ? (home <= gap || home > j)
+      : (home <= gap && home > j);
+    if (movable) {
+      keys[gap] = keys[j];
+      entries[gap] = entries[j];
+      gap = j;
+    }
+  }
+
+  keys[gap].Clear();
+  --size;
+}
+
+bool
+FlarmTrafficStore::Remove(FlarmId id) noexcept
+{
+  const int i = FindSlot(id);
+  if (i < 0)
+    return false;
+
+  RemoveSlot(i);
+  return true;
+}
+
+void
+FlarmTrafficStore::Expire(double now, double max_age) noexcept
+{
+  if (size == 0)
+    return;
+
+  for (unsigned i = 0; i < CAPACITY;) {
+    if (keys[i].IsDefined() &&
+        (now < entries[i].last_update ||
+         now > entries[i].last_update + max_age))
+      /* don't advance; RemoveSlot() may have moved another entry
+         into this slot */
+      RemoveSlot(i);
+    else
+      ++i;
+  }
+}
+
+void
+FlarmTrafficStore::EvictOldest() noexcept
+{
+  int oldest = -1;
+  for (unsigned i = 0; i < CAPACITY; ++i)
+    if (keys[i].IsDefined() &&
+        (oldest < 0 || entries[i].last_update < entries[oldest].last_update))
+      oldest = i;
+
+  if (oldest >= 0)
+    RemoveSlot(oldest);
+}
@@ -0,0 +1,151 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_STORE_HPP
+#define XCSOAR_FLARM_TRAFFIC_STORE_HPP
+
+#include "FLARM/Traffic.hpp"
+#include "Computer/ClimbAverageCalculator.hpp"
+#include "util/Compiler.h"
+
+#include <cstdint>
+
+/**
+ * The per-target state which #FlarmComputer keeps between two
+ * merges: the traffic object with all derived values, as calculated
+ * from the most recent PFLAA sentence, and the target's climb rate
+ * history.
+ *
+ * This is an open-addressing hash table (linear probing) keyed by
+ * #FlarmId with a fixed capacity.  The keys are stored in a separate
+ * compact array, so a lookup touches only one or two cache lines.
+ */
+class FlarmTrafficStore {
+  static constexpr unsigned CAPACITY_BITS = 6;
+
+public:
+  static constexpr unsigned CAPACITY = 1 << CAPACITY_BITS;
+
+  /**
+   * The maximum number of entries; keeping the load factor below 3/4
+   * keeps the probe sequences short.  If the table is full, the
+   * least recently updated entry is evicted.
+   */
+  static constexpr unsigned MAX_SIZE = CAPACITY * 3 / 4;
+
+  struct Entry {
+    /**
+     * The traffic object after FlarmComputer::Process() has derived
+     * all values.  Its #valid attribute identifies the PFLAA sentence
+     * it was derived from.
+     */
+    FlarmTraffic traffic;
+
+    ClimbAverageCalculator climb_average;
+
+    /**
+     * The own time stamp [s] of the last update, used by Expire().
+     */
+    double last_update;
+  };
+
+private:
+  /**
+   * The keys; FlarmId::Undefined() marks an empty slot.
+   */
+  FlarmId keys[CAPACITY];
+
+  Entry entries[CAPACITY];
+
+  unsigned size;
+
+public:
+  FlarmTrafficStore() noexcept {
+    Clear();
+  }
+
+  void Clear() noexcept;
+
+  unsigned GetSize() const noexcept {
+    return size;
+  }
+
+  bool IsEmpty() const noexcept {
+    return size == 0;
+  }
+
+  gcc_pure
+  Entry *Find(FlarmId id) noexcept;
+
+  gcc_pure
+  const Entry *Find(FlarmId id) const noexcept {
+    return const_cast<FlarmTrafficStore *>(this)->Find(id);
+  }
+
+  /**
+   * Look up an entry, and create a new one if it does not exist.  A
+   * new entry has a cleared #traffic object and an empty climb rate
+   * history.
+   *
+   * @param id a defined FLARM id
+   * @param now the current own time stamp [s]
+   */
+  Entry &Insert(FlarmId id, double now) noexcept;
+
+  /**
+   * Remove the entry with the specified id (if it exists).
+   *
+   * @return true if an entry was removed
+   */
+  bool Remove(FlarmId id) noexcept;
+
+  /**
+   * Remove all entries which have not been updated within the
+   * specified period, or which are in the future (time warp).
+   */
+  void Expire(double now, double max_age) noexcept;
+
+private:
+  gcc_const
+  static unsigned GetHomeSlot(FlarmId id) noexcept {
+    /* Fibonacci hashing: the upper bits of the product depend on all
+       bits of the id */
+    return (id.Hash() * UINT32_C(2654435769)) >> (32 - CAPACITY_BITS);
+  }
+
+  static constexpr unsigned NextSlot(unsigned i) noexcept {
+    return (i + 1) & (CAPACITY - 1);
+  }
+
+  gcc_pure
+  int FindSlot(FlarmId id) const noexcept;
+
+  void RemoveSlot(unsigned i) noexcept;
+
+  /**
+   * Remove the least recently updated entry.
+   */
+  void EvictOldest() noexcept;
+};
+
+#endif
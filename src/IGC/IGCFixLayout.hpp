@@ -0,0 +1,68 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_FIX_LAYOUT_HPP
+#define XCSOAR_IGC_FIX_LAYOUT_HPP
+
+#include "util/TrivialArray.hxx"
+
+#include <cstdint>
+
+struct IGCFix;
+
+/**
+ * The column layout of the "B" record extensions announced by an
+ * "I" record, resolved once into #IGCFix attributes.  This avoids
+ * comparing the three-letter extension codes for each fix.
+ *
+ * Use IGCCompileFixLayout() to build it from #IGCExtensions.
+ */
+struct IGCFixLayout {
+  struct Field {
+    /**
+     * The first column (zero-based) of the value.
+     */
+    uint8_t offset;
+
+    /**
+     * The number of digits to be decoded.
+     */
+    uint8_t length;
+
+    /**
+     * The minimum line length required for this field; shorter lines
+     * don't contain it.
+     */
+    uint8_t end;
+
+    int16_t IGCFix::*value;
+  };
+
+  TrivialArray<Field, 16> fields;
+
+  void Clear() noexcept {
+    fields.clear();
+  }
+};
+
+#endif
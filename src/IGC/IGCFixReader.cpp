@@ -0,0 +1,133 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCFixReader.hpp"
+#include "IGCParser.hpp"
+#include "IGCExtensions.hpp"
+#include "IGCFix.hpp"
+#include "util/StringView.hxx"
+
+#include <algorithm>
+
+#include <string.h>
+
+/**
+ * Copy a (non-fix) line to a null-terminated buffer for the parsers
+ * which need one.  Those records are rare, so this doesn't matter.
+ */
+template<size_t size>
+static const char *
+CopyLine(char (&buffer)[size], StringView line) noexcept
+{
+  const size_t length = std::min(line.size, size - 1);
+  std::copy_n(line.data, length, buffer);
+  buffer[length] = 0;
+  return buffer;
+}
+
+IGCFixReader::IGCFixReader(ConstBuffer<void> buffer) noexcept
+  :position((const char *)buffer.data),
+   end(position + buffer.size)
+{
+  layout.Clear();
+}
+
+StringView
+IGCFixReader::NextLine() noexcept
+{
+  const char *start = position;
+  const char *newline = (const char *)memchr(start, '\n', end - start);
+  const char *line_end;
+  if (newline != nullptr) {
+    line_end = newline;
+    position = newline + 1;
+  } else {
+    line_end = position = end;
+  }
+
+  if (line_end > start && line_end[-1] == '\r')
+    --line_end;
+
+  return {start, line_end};
+}
+
+void
+IGCFixReader::ParseExtensions(StringView line) noexcept
+{
+  char buffer[256];
+  IGCExtensions extensions;
+  extensions.clear();
+
+  /* like the line based parsers, this keeps the extensions which
+     were parsed before an error */
+  IGCParseExtensions(CopyLine(buffer, line), extensions);
+  IGCCompileFixLayout(extensions, layout);
+}
+
+void
+IGCFixReader::ParseDate(StringView line) noexcept
+{
+  char buffer[64];
+  BrokenDate value;
+  if (IGCParseDateRecord(CopyLine(buffer, line), value))
+    date = value;
+}
+
+unsigned
+IGCFixReader::Read(IGCFix *fixes, unsigned max) noexcept
+{
+  unsigned n = 0;
+
+  while (n < max && position < end) {
+    const char *const line_start = position;
+    const StringView line = NextLine();
+    if (line.empty())
+      continue;
+
+    switch (line.front()) {
+    case 'B':
+      if (IGCParseFix(line, layout, fixes[n]))
+        ++n;
+      break;
+
+    case 'H':
+      if (line.StartsWith("HFDTE")) {
+        if (n > 0) {
+          /* finish this batch first; the new date applies only to
+             the following fixes */
+          position = line_start;
+          return n;
+        }
+
+        ParseDate(line);
+      }
+      break;
+
+    case 'I':
+      ParseExtensions(line);
+      break;
+    }
+  }
+
+  return n;
+}
@@ -0,0 +1,85 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_FIX_READER_HPP
+#define XCSOAR_IGC_FIX_READER_HPP
+
+#include "IGCFixLayout.hpp"
+#include "time/BrokenDate.hpp"
+#include "util/ConstBuffer.hxx"
+
+struct IGCFix;
+struct StringView;
+
+/**
+ * Parses the "B" records of an IGC file which is already in memory,
+ * usually a #FileMapping.  Lines are parsed in place without copying,
+ * and fixes are returned in batches.  "I" records update the
+ * extension layout of the following fixes, "HFDTE" records update
+ * GetDate().
+ */
+class IGCFixReader {
+  const char *position;
+  const char *const end;
+
+  IGCFixLayout layout;
+
+  BrokenDate date = BrokenDate::Invalid();
+
+public:
+  explicit IGCFixReader(ConstBuffer<void> buffer) noexcept;
+
+  /**
+   * Parse the next fixes into the given array.  Fixes with invalid
+   * GPS data are returned, too (see IGCFix::gps_valid); malformed
+   * "B" records are skipped.
+   *
+   * A batch ends early before a "HFDTE" record, so GetDate() is valid
+   * for all fixes of one batch.
+   *
+   * @return the number of fixes, 0 at the end of the file
+   */
+  unsigned Read(IGCFix *fixes, unsigned max) noexcept;
+
+  /**
+   * Returns the date of the most recent "HFDTE" record; may be
+   * invalid if there was none.
+   */
+  const BrokenDate &GetDate() const noexcept {
+    return date;
+  }
+
+  /**
+   * Returns the number of bytes which have not been parsed yet.
+   */
+  size_t GetRemaining() const noexcept {
+    return end - position;
+  }
+
+private:
+  StringView NextLine() noexcept;
+  void ParseExtensions(StringView line) noexcept;
+  void ParseDate(StringView line) noexcept;
+};
+
+#endif
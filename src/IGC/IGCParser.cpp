@@ -25,11 +25,13 @@ Copyright_License {
 #include "IGCHeader.hpp"
 #include "IGCFix.hpp"
 #include "IGCExtensions.hpp"
+#include "IGCFixLayout.hpp"
 #include "IGCDeclaration.hpp"
 #include "time/BrokenDate.hpp"
 #include "time/BrokenTime.hpp"
 #include "util/CharUtil.hxx"
 #include "util/StringAPI.hxx"
+#include "util/StringView.hxx"
 
 #include <stdlib.h>
 
@@ -295,6 +297,163 @@ IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix)
   return true;
 }
 
+/**
+ * The "B" record extensions which are stored in #IGCFix.
+ */
+static constexpr struct {
+  char code[4];
+
+  /**
+   * The number of leading digits to be parsed; 0 means the whole
+   * column.  See ParseExtensionValueN().
+   */
+  uint8_t length;
+
+  int16_t IGCFix::*value;
+} igc_fix_extensions[] = {
+  { "ENL", 0, &IGCFix::enl },
+  { "RPM", 0, &IGCFix::rpm },
+  { "HDM", 0, &IGCFix::hdm },
+  { "HDT", 0, &IGCFix::hdt },
+  { "TRM", 0, &IGCFix::trm },
+  { "TRT", 0, &IGCFix::trt },
+  { "GSP", 3, &IGCFix::gsp },
+  { "IAS", 3, &IGCFix::ias },
+  { "TAS", 3, &IGCFix::tas },
+  { "SIU", 0, &IGCFix::siu },
+};
+
+void
+IGCCompileFixLayout(const IGCExtensions &extensions, IGCFixLayout &layout)
+{
+  layout.Clear();
+
+  for (const IGCExtension &extension : extensions) {
+    assert(extension.start > 0);
+    assert(extension.finish >= extension.start);
+
+    for (const auto &i : igc_fix_extensions) {
+      if (!StringIsEqual(extension.code, i.code))
+        continue;
+
+      const unsigned width = extension.finish - extension.start + 1;
+      if (i.length > width)
+        /* column is too short */
+        break;
+
+      IGCFixLayout::Field &field = layout.fields.append();
+      field.offset = extension.start - 1;
+      field.length = i.length > 0 ? i.length : width;
+      field.end = extension.finish;
+      field.value = i.value;
+      break;
+    }
+  }
+}
+
+/**
+ * Decode a fixed number of decimal digits.  Instead of branching on
+ * each character, invalid characters are accumulated in #invalid
+ * which is checked once by the caller.
+ */
+static inline unsigned
+DecodeDigits(const char *p, unsigned n, unsigned &invalid) noexcept
+{
+  unsigned value = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned digit = unsigned(p[i]) - unsigned('0');
+    invalid |= digit > 9;
+    value = value * 10 + digit;
+  }
+
+  return value;
+}
+
+/**
+ * Decode a five-column altitude, which may be negative ("-0012").
+ */
+static inline int
+DecodeAltitude(const char *p, unsigned &invalid) noexcept
+{
+  if (p[0] == '-')
+    return -int(DecodeDigits(p + 1, 4, invalid));
+
+  return DecodeDigits(p, 5, invalid);
+}
+
+bool
+IGCParseFix(StringView line, const IGCFixLayout &layout, IGCFix &fix)
+{
+  /* "B" HHMMSS DDMMmmm[NS] DDDMMmmm[EW] [AV] PPPPP GGGGG */
+  if (line.size < 35 || line.front() != 'B')
+    return false;
+
+  const char *p = line.data;
+  unsigned invalid = 0;
+
+  const unsigned hour = DecodeDigits(p + 1, 2, invalid);
+  const unsigned minute = DecodeDigits(p + 3, 2, invalid);
+  const unsigned second = DecodeDigits(p + 5, 2, invalid);
+
+  const unsigned lat_degrees = DecodeDigits(p + 7, 2, invalid);
+  const unsigned lat_minutes = DecodeDigits(p + 9, 5, invalid);
+  const char lat_char = p[14];
+  const unsigned lon_degrees = DecodeDigits(p + 15, 3, invalid);
+  const unsigned lon_minutes = DecodeDigits(p + 18, 5, invalid);
+  const char lon_char = p[23];
+
+  const char valid_char = p[24];
+  const int pressure_altitude = DecodeAltitude(p + 25, invalid);
+  const int gps_altitude = DecodeAltitude(p + 30, invalid);
+
+  invalid |= lat_degrees >= 90;
+  invalid |= lat_minutes >= 60000;
+  invalid |= (lat_char != 'N') & (lat_char != 'S');
+  invalid |= lon_degrees >= 180;
+  invalid |= lon_minutes >= 60000;
+  invalid |= (lon_char != 'E') & (lon_char != 'W');
+  invalid |= (valid_char != 'A') & (valid_char != 'V');
+
+  if (invalid)
+    return false;
+
+  const BrokenTime time(hour, minute, second);
+  if (!time.IsPlausible())
+    return false;
+
+  fix.time = time;
+
+  fix.location.latitude = Angle::Degrees(lat_degrees +
+                                         lat_minutes / 60000.);
+  if (lat_char == 'S')
+    fix.location.latitude.Flip();
+
+  fix.location.longitude = Angle::Degrees(lon_degrees +
+                                          lon_minutes / 60000.);
+  if (lon_char == 'W')
+    fix.location.longitude.Flip();
+
+  fix.gps_valid = valid_char == 'A';
+  fix.gps_altitude = gps_altitude;
+  fix.pressure_altitude = pressure_altitude;
+
+  fix.ClearExtensions();
+
+  for (const IGCFixLayout::Field &field : layout.fields) {
+    if (field.end > line.size)
+      /* exceeds the input line length */
+      continue;
+
+    unsigned field_invalid = 0;
+    const unsigned value = DecodeDigits(p + field.offset, field.length,
+                                        field_invalid);
+    if (field_invalid == 0)
+      fix.*field.value = value;
+  }
+
+  return true;
+}
+
 bool
 IGCParseLocation(const char *buffer, GeoPoint &location)
 {
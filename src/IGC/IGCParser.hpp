@@ -27,11 +27,13 @@ Copyright_License {
 struct IGCFix;
 struct IGCHeader;
 struct IGCExtensions;
+struct IGCFixLayout;
 struct IGCDeclarationHeader;
 struct IGCDeclarationTurnpoint;
 struct BrokenDate;
 struct BrokenTime;
 struct GeoPoint;
+struct StringView;
 
 /**
  * Parse an IGC "A" record.
@@ -73,6 +75,25 @@ IGCParseLocation(const char *buffer, GeoPoint &location);
 bool
 IGCParseFix(const char *buffer, const IGCExtensions &extensions, IGCFix &fix);
 
+/**
+ * Resolve the extensions of an "I" record to the #IGCFix attributes
+ * they are stored in.  Unknown extensions are omitted.
+ */
+void
+IGCCompileFixLayout(const IGCExtensions &extensions, IGCFixLayout &layout);
+
+/**
+ * Parse an IGC "B" record which does not need to be null-terminated.
+ * Unlike the #IGCExtensions overload, this one decodes the fixed
+ * columns directly without sscanf(), and it is stricter: all numeric
+ * columns must consist of digits only (the altitudes may have a
+ * leading minus sign).
+ *
+ * @return true on success, false if the line was not recognized
+ */
+bool
+IGCParseFix(StringView line, const IGCFixLayout &layout, IGCFix &fix);
+
 /**
  * Parse a time in IGC file format (HHMMSS).
  *
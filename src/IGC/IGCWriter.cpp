@@ -35,13 +35,22 @@ IGCWriter::IGCWriter(Path path)
         /* we use CREATE_VISIBLE here so the user can recover partial
            IGC files after a crash/battery failure/etc. */
         FileOutputStream::Mode::CREATE_VISIBLE),
-   buffered(file)
+   async(file),
+   buffered(async)
 {
   fix.Clear();
 
   grecord.Initialize();
 }
 
+void
+IGCWriter::Close()
+{
+  buffered.Flush();
+  async.Close();
+  file.Commit();
+}
+
 void
 IGCWriter::CommitLine(char *line)
 {
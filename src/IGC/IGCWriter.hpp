@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_IGC_WRITER_HPP
 
 #include "Logger/GRecord.hpp"
+#include "Logger/AsyncOutputStream.hpp"
 #include "IGCFix.hpp"
 #include "io/FileOutputStream.hxx"
 #include "io/BufferedOutputStream.hxx"
@@ -43,6 +44,13 @@ class IGCWriter {
   };
 
   FileOutputStream file;
+
+  /**
+   * Passes the data to the file on an I/O thread, so a slow storage
+   * device does not block the caller.
+   */
+  AsyncOutputStream async;
+
   BufferedOutputStream buffered;
 
   GRecord grecord;
@@ -57,10 +65,26 @@ public:
    */
   explicit IGCWriter(Path path);
 
+  /**
+   * Pass all buffered data to the I/O thread.  This does not block.
+   */
   void Flush() {
     buffered.Flush();
   }
 
+  /**
+   * Write all data to the file and close it.  This may block until
+   * the I/O thread is done.  No other method may be called after
+   * this one.
+   *
+   * Throws on I/O error.
+   */
+  void Close();
+
+  AsyncOutputStream::Stats GetWriteStats() noexcept {
+    return async.GetStats();
+  }
+
   void Sign();
 
 private:
@@ -43,6 +43,7 @@ InputConfig::SetDefaults()
   std::fill_n(&Key2EventFF00[0][0], MAX_MODE * MAX_KEY, 0);
 #endif
 
+  std::fill_n(&ShortGesture2Event[0], N_SHORT_GESTURES, 0);
   Gesture2Event.Clear();
 
   std::fill_n(&GC2Event[0], ARRAY_SIZE(GC2Event), 0);
@@ -54,6 +54,20 @@ struct InputConfig {
 #endif
   static constexpr unsigned MAX_EVENTS = 2048;
 
+  /**
+   * Gestures up to this length are dispatched through the dense
+   * #ShortGesture2Event array; longer ones through the
+   * #Gesture2Event tree.
+   */
+  static constexpr unsigned MAX_SHORT_GESTURE = 6;
+
+  /**
+   * The number of distinct gestures (strings of "U", "D", "R", "L")
+   * with 1 to #MAX_SHORT_GESTURE characters.
+   */
+  static constexpr unsigned N_SHORT_GESTURES =
+    ((1u << (2 * (MAX_SHORT_GESTURE + 1))) - 4) / 3;
+
   typedef void (*pt2Event)(const TCHAR *);
 
   // Events - What do you want to DO
@@ -86,6 +100,14 @@ struct InputConfig {
   unsigned short Key2EventFF00[MAX_MODE][MAX_KEY];
 #endif
 
+  /**
+   * Gesture map to Event, indexed by GetShortGestureIndex().
+   */
+  unsigned short ShortGesture2Event[N_SHORT_GESTURES];
+
+  /**
+   * Gestures which are too long for #ShortGesture2Event.
+   */
   RadixTree<unsigned> Gesture2Event;
 
   // Glide Computer Events
@@ -198,6 +220,62 @@ struct InputConfig {
       key_2_event[mode][key_code] = event_id;
   }
 
+  /**
+   * Calculate the #ShortGesture2Event index of the specified
+   * gesture: each direction is one base-4 digit, and the gestures of
+   * each length occupy their own range, shortest first.
+   *
+   * @return the index or -1 if the gesture is empty, too long or
+   * contains characters other than "U", "D", "R", "L"
+   */
+  gcc_pure
+  static int GetShortGestureIndex(const TCHAR *gesture) noexcept {
+    unsigned value = 0, offset = 0, n = 1;
+
+    for (unsigned length = 0; gesture[length] != _T('\0'); ++length) {
+      if (length >= MAX_SHORT_GESTURE)
+        return -1;
+
+      unsigned digit;
+      switch (gesture[length]) {
+      case _T('U'): digit = 0; break;
+      case _T('D'): digit = 1; break;
+      case _T('R'): digit = 2; break;
+      case _T('L'): digit = 3; break;
+      default: return -1;
+      }
+
+      offset += n;
+      n *= 4;
+      value = value * 4 + digit;
+    }
+
+    if (offset == 0)
+      return -1;
+
+    return offset - 1 + value;
+  }
+
+  void SetGestureEvent(const TCHAR *gesture, unsigned event_id) {
+    int i = GetShortGestureIndex(gesture);
+    if (i >= 0) {
+      ShortGesture2Event[i] = event_id;
+    } else {
+      // One entry per key: delete old, create new
+      Gesture2Event.Remove(gesture);
+      Gesture2Event.Add(gesture, event_id);
+    }
+  }
+
+  gcc_pure
+  unsigned GetGestureEvent(const TCHAR *gesture) const noexcept {
+    int i = GetShortGestureIndex(gesture);
+    if (i >= 0)
+      return ShortGesture2Event[i];
+
+    return Gesture2Event.Get(gesture, 0);
+  }
+
   gcc_pure
   const MenuItem &GetMenuItem(unsigned mode, unsigned location) const {
     assert(mode < MAX_MODE);
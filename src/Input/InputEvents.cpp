@@ -71,6 +71,7 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include <tchar.h>
 #include <stdio.h>
 #include <memory>
+#include <algorithm>
 
 namespace InputEvents {
 
@@ -85,6 +86,14 @@ static Mode current_mode = InputEvents::MODE_DEFAULT;
  */
 static Mode overlay_mode = MODE_DEFAULT;
 
+/**
+ * The overlay mode of each mode for the current #flavour
+ * (#MODE_DEFAULT if there is none), so switching modes does not need
+ * to look up the flavoured mode name.  Rebuilt by
+ * UpdateFlavourModes().
+ */
+static Mode flavour_modes[InputConfig::MAX_MODE];
+
 static unsigned MenuTimeOut = 0;
 
 /**
@@ -96,6 +105,9 @@ gcc_pure
 static Mode
 getModeID() noexcept;
 
+static void
+UpdateFlavourModes() noexcept;
+
 static void
 UpdateOverlayMode() noexcept;
 
@@ -134,6 +146,8 @@ InputEvents::readFile()
   auto reader = OpenConfiguredTextFile(ProfileKeys::InputFile);
   if (reader)
     ::ParseInputFile(input_config, *reader);
+
+  UpdateFlavourModes();
 }
 
 void
@@ -171,7 +185,13 @@ InputEvents::SetFlavour(const TCHAR *_flavour) noexcept
     /* optimised default case */
     return;
 
+  if (flavour != NULL && _flavour != NULL &&
+      StringIsEqual(flavour, _flavour))
+    /* unchanged */
+    return;
+
   flavour = _flavour;
+  UpdateFlavourModes();
 
   const Mode old_overlay_mode = overlay_mode;
   UpdateOverlayMode();
@@ -244,26 +264,31 @@ InputEvents::getModeID() noexcept
 }
 
 void
-InputEvents::UpdateOverlayMode() noexcept
+InputEvents::UpdateFlavourModes() noexcept
 {
-  if (flavour != NULL) {
-    /* build the "flavoured" mode name from the current "major" mode
-       and the flavour name */
+  std::fill_n(flavour_modes, InputConfig::MAX_MODE, MODE_DEFAULT);
+
+  if (flavour == NULL)
+    return;
+
+  for (unsigned i = 0, n = input_config.modes.size(); i < n; ++i) {
+    /* build the "flavoured" mode name from the "major" mode and the
+       flavour name */
     StaticString<InputConfig::MAX_MODE_STRING + 32> name;
-    name.Format(_T("%s.%s"), input_config.modes[current_mode].c_str(),
-                flavour);
+    name.Format(_T("%s.%s"), input_config.modes[i].c_str(), flavour);
 
-    /* see if it exists */
+    /* see if it exists; if not, the magic value "MODE_DEFAULT"
+       disables the overlay */
     int new_mode = input_config.LookupMode(name.c_str());
     if (new_mode >= 0)
-      /* yep, it does */
-      overlay_mode = (Mode)new_mode;
-    else
-      /* not defined, disable the overlay with the magic value
-         "MODE_DEFAULT" */
-      overlay_mode = MODE_DEFAULT;
-  } else
-    overlay_mode = MODE_DEFAULT;
+      flavour_modes[i] = (Mode)new_mode;
+  }
+}
+
+void
+InputEvents::UpdateOverlayMode() noexcept
+{
+  overlay_mode = flavour_modes[current_mode];
 }
 
 // -----------------------------------------------------------------------
@@ -378,13 +403,13 @@ InputEvents::processKey(unsigned key_code) noexcept
 unsigned
 InputEvents::gesture_to_event(const TCHAR *data) noexcept
 {
-  return input_config.Gesture2Event.Get(data, 0);
+  return input_config.GetGestureEvent(data);
 }
 
 bool
 InputEvents::IsGesture(const TCHAR *data) noexcept
 {
-  return (Lua::IsGesture(data)) || (gesture_to_event(data) != 0);
+  return gesture_to_event(data) != 0 || Lua::IsGesture(data);
 }
 
 bool
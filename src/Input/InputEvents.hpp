@@ -162,6 +162,7 @@ void eventNearestMapItems(const TCHAR *misc);
 void eventNull(const TCHAR *misc);
 void eventPage(const TCHAR *misc);
 void eventPan(const TCHAR *misc);
+void eventRenderProfile(const TCHAR *misc);
 void eventPlaySound(const TCHAR *misc);
 void eventProfileLoad(const TCHAR *misc);
 void eventProfileSave(const TCHAR *misc);
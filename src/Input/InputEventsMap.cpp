@@ -35,6 +35,9 @@ Copyright_License {
 #include "Pan.hpp"
 #include "PageActions.hpp"
 #include "util/Clamp.hpp"
+#include "LocalPath.hpp"
+#include "LogFile.hpp"
+#include "system/Path.hpp"
 
 // eventAutoZoom - Turn on|off|toggle AutoZoom
 // misc:
@@ -150,6 +153,48 @@ InputEvents::eventPan(const TCHAR *misc)
   XCSoarInterface::SendMapSettings(true);
 }
 
+/**
+ * Control the render profiler of the map, which measures the
+ * duration of each map layer.
+ *
+ *  on             Start profiling and show the timings on the map
+ *  off            Stop profiling
+ *  toggle         Toggle profiling
+ *  export         Write all recorded frames to "render_trace.json"
+ *                 (Chrome trace event format)
+ */
+void
+InputEvents::eventRenderProfile(const TCHAR *misc)
+{
+  GlueMapWindow *map_window = UIGlobals::GetMap();
+  if (map_window == nullptr)
+    return;
+
+  RenderProfiler &profiler = map_window->GetRenderProfiler();
+
+  if (StringIsEqual(misc, _T("on")))
+    profiler.SetEnabled(true);
+  else if (StringIsEqual(misc, _T("off")))
+    profiler.SetEnabled(false);
+  else if (StringIsEqual(misc, _T("toggle")))
+    profiler.SetEnabled(!profiler.IsEnabled());
+  else if (StringIsEqual(misc, _T("export"))) {
+    const auto path = LocalPath(_T("render_trace.json"));
+
+    try {
+      profiler.ExportTrace(path);
+      Message::AddMessage(_("Render trace saved"), path.c_str());
+    } catch (...) {
+      LogError(std::current_exception(), "Failed to write render trace");
+      Message::AddMessage(_("Failed to write render trace"));
+    }
+
+    return;
+  }
+
+  map_window->QuickRedraw();
+}
+
 void
 InputEvents::sub_PanCursor(int dx, int dy)
 {
@@ -31,6 +31,7 @@ Copyright_License {
 #include "Profile/ProfileKeys.hpp"
 #include "Profile/Settings.hpp"
 #include "Profile/Current.hpp"
+#include "Profile/Map.hpp"
 #include "util/Macros.hpp"
 #include "util/EnumCast.hpp"
 #include "Units/Units.hpp"
@@ -258,12 +259,24 @@ void
 InputEvents::eventProfileLoad(const TCHAR *misc)
 {
   if (!StringIsEmpty(misc)) {
+    const unsigned serial = Profile::map.GetSerial();
     Profile::LoadFile(Path(misc));
 
-    MapFileChanged = true;
-    WaypointFileChanged = true;
-    AirspaceFileChanged = true;
-    AirfieldFileChanged = true;
+    if (Profile::map.GetSerial() == serial)
+      /* nothing has changed */
+      return;
+
+    const auto &map = Profile::map;
+    MapFileChanged = map.IsModifiedSince(ProfileKeys::MapFile, serial);
+    WaypointFileChanged =
+      map.IsModifiedSince(ProfileKeys::WaypointFile, serial) ||
+      map.IsModifiedSince(ProfileKeys::AdditionalWaypointFile, serial) ||
+      map.IsModifiedSince(ProfileKeys::WatchedWaypointFile, serial);
+    AirspaceFileChanged =
+      map.IsModifiedSince(ProfileKeys::AirspaceFile, serial) ||
+      map.IsModifiedSince(ProfileKeys::AdditionalAirspaceFile, serial);
+    AirfieldFileChanged =
+      map.IsModifiedSince(ProfileKeys::AirfieldFile, serial);
 
     // assuming all is ok, we can...
     Profile::Use(Profile::map);
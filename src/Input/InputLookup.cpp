@@ -26,17 +26,43 @@ Copyright_License {
 #include "InputQueue.hpp"
 #include "util/StringAPI.hxx"
 
+#include <algorithm>
+#include <iterator>
+
 // Mapping text names of events to the real thing
 struct Text2EventSTRUCT {
   const TCHAR *text;
   pt2Event event;
 };
 
+/* sorted by name (see tools/Text2Event.pl) */
 static constexpr Text2EventSTRUCT Text2Event[] = {
 #include "InputEvents_Text2Event.cpp"
-  { nullptr, nullptr }
 };
 
+static constexpr bool
+IsLess(const TCHAR *a, const TCHAR *b) noexcept
+{
+  for (; *a == *b; ++a, ++b)
+    if (*a == 0)
+      return false;
+
+  return *a < *b;
+}
+
+static constexpr bool
+IsSorted(const Text2EventSTRUCT *begin, const Text2EventSTRUCT *end) noexcept
+{
+  for (auto i = begin; i + 1 < end; ++i)
+    if (!IsLess(i->text, (i + 1)->text))
+      return false;
+
+  return true;
+}
+
+static_assert(IsSorted(std::begin(Text2Event), std::end(Text2Event)),
+              "Text2Event must be sorted for the binary search");
+
 // Mapping text names of events to the real thing
 static const TCHAR *const Text2GCE[] = {
 #include "InputEvents_Text2GCE.cpp"
@@ -52,9 +78,14 @@ static const TCHAR *const Text2NE[] = {
 pt2Event
 InputEvents::findEvent(const TCHAR *data)
 {
-  for (unsigned i = 0; Text2Event[i].text != nullptr; ++i)
-    if (StringIsEqual(data, Text2Event[i].text))
-      return Text2Event[i].event;
+  const auto end = std::end(Text2Event);
+  const auto i = std::lower_bound(std::begin(Text2Event), end, data,
+                                  [](const Text2EventSTRUCT &e,
+                                     const TCHAR *name){
+                                    return IsLess(e.text, name);
+                                  });
+  if (i != end && StringIsEqual(i->text, data))
+    return i->event;
 
   return nullptr;
 }
@@ -134,11 +134,9 @@ struct EventBuilder {
               *c != _T('L'))
             valid = false;
         
-        if (valid) {
-          // One entry per key: delete old, create new
-          config.Gesture2Event.Remove(data.c_str());
-          config.Gesture2Event.Add(data.c_str(), event_id);
-        } else
+        if (valid)
+          config.SetGestureEvent(data.c_str(), event_id);
+        else
           LogFormat(_T("Invalid gesture data: %s at %u"), data.c_str(), line);
 
         // Make ne (NMEA Event)
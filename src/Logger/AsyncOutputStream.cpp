@@ -0,0 +1,249 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AsyncOutputStream.hpp"
+#include "io/FileOutputStream.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+
+AsyncOutputStream::AsyncOutputStream(FileOutputStream &_file,
+                                     size_t _capacity)
+  :Thread("LogWriter"),
+   file(_file),
+   buffer(new uint8_t[_capacity]), capacity(_capacity)
+{
+  assert(capacity >= BLOCK_SIZE);
+  assert((capacity & (capacity - 1)) == 0);
+
+  if (!Start())
+    throw std::runtime_error("Failed to start the I/O thread");
+}
+
+AsyncOutputStream::~AsyncOutputStream() noexcept
+{
+  try {
+    Close();
+  } catch (...) {
+  }
+}
+
+size_t
+AsyncOutputStream::Push(const uint8_t *data, size_t size) noexcept
+{
+  const size_t h = head.load(std::memory_order_relaxed);
+  const size_t t = tail.load(std::memory_order_acquire);
+
+  const size_t n = std::min(size, capacity - (h - t));
+  if (n == 0)
+    return 0;
+
+  const size_t offset = h & (capacity - 1);
+  const size_t first = std::min(n, capacity - offset);
+  std::copy_n(data, first, buffer.get() + offset);
+  std::copy_n(data + first, n - first, buffer.get());
+
+  head.store(h + n, std::memory_order_release);
+
+  max_queued = std::max(max_queued, h + n - t);
+  return n;
+}
+
+void
+AsyncOutputStream::Write(const void *_data, size_t size)
+{
+  assert(IsDefined());
+
+  const uint8_t *data = (const uint8_t *)_data;
+
+  if (!overflow.empty()) {
+    /* older data goes first */
+    const size_t n = Push(overflow.data(), overflow.size());
+    overflow.erase(overflow.begin(), overflow.begin() + n);
+  }
+
+  if (overflow.empty()) {
+    const size_t n = Push(data, size);
+    data += n;
+    size -= n;
+  }
+
+  if (size > 0) {
+    ++n_overflows;
+
+    if (overflow.size() + size > MAX_OVERFLOW)
+      n_discarded += size;
+    else
+      overflow.insert(overflow.end(), data, data + size);
+  }
+
+  /* notify without holding the mutex: this never blocks; a lost
+     wakeup only delays the write until the next WRITE_INTERVAL */
+  if (size > 0 || GetQueued() >= capacity / 4)
+    cond.notify_one();
+}
+
+void
+AsyncOutputStream::Close()
+{
+  if (!IsDefined())
+    return;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    stop_requested.store(true, std::memory_order_relaxed);
+  }
+
+  cond.notify_one();
+  Join();
+
+  /* the I/O thread has drained the ring buffer; now write the rest
+     synchronously */
+  std::vector<uint8_t> rest(std::move(overflow));
+  overflow.clear();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  if (!rest.empty()) {
+    file.Write(rest.data(), rest.size());
+    file.Sync();
+  }
+}
+
+AsyncOutputStream::Stats
+AsyncOutputStream::GetStats() noexcept
+{
+  Stats stats;
+  stats.max_queued = max_queued;
+  stats.n_overflows = n_overflows;
+  stats.n_discarded = n_discarded;
+
+  const std::lock_guard<Mutex> lock(mutex);
+  stats.n_writes = n_writes;
+  stats.n_syncs = n_syncs;
+  stats.max_stall = max_stall;
+  stats.total_stall = total_stall;
+  return stats;
+}
+
+void
+AsyncOutputStream::AddStall(Clock::duration stall) noexcept
+{
+  max_stall = std::max(max_stall, stall);
+  total_stall += stall;
+}
+
+bool
+AsyncOutputStream::WriteQueued(bool whole_blocks)
+{
+  size_t t = tail.load(std::memory_order_relaxed);
+  size_t h = head.load(std::memory_order_acquire);
+  if (whole_blocks)
+    h &= ~(BLOCK_SIZE - 1);
+
+  if (h <= t)
+    return false;
+
+  do {
+    const size_t offset = t & (capacity - 1);
+    const size_t n = std::min(h - t, capacity - offset);
+
+    const auto start = Clock::now();
+    file.Write(buffer.get() + offset, n);
+    const auto stall = Clock::now() - start;
+
+    t += n;
+    tail.store(t, std::memory_order_release);
+
+    const std::lock_guard<Mutex> lock(mutex);
+    ++n_writes;
+    AddStall(stall);
+  } while (t != h);
+
+  return true;
+}
+
+void
+AsyncOutputStream::Sync()
+{
+  const auto start = Clock::now();
+  file.Sync();
+  const auto stall = Clock::now() - start;
+
+  const std::lock_guard<Mutex> lock(mutex);
+  ++n_syncs;
+  AddStall(stall);
+}
+
+void
+AsyncOutputStream::Run() noexcept
+{
+  auto next_write = Clock::now() + WRITE_INTERVAL;
+  auto next_sync = Clock::now() + SYNC_INTERVAL;
+  bool dirty = false, failed = false;
+
+  while (true) {
+    bool stopping;
+
+    {
+      std::unique_lock<Mutex> lock(mutex);
+      cond.wait_until(lock, next_write, [this]{
+        return stop_requested.load(std::memory_order_relaxed) ||
+          GetQueued() >= capacity / 4;
+      });
+
+      stopping = stop_requested.load(std::memory_order_relaxed);
+    }
+
+    if (failed) {
+      /* discard everything after an I/O error */
+      tail.store(head.load(std::memory_order_acquire),
+                 std::memory_order_release);
+    } else {
+      const auto now = Clock::now();
+      const bool write_all = stopping || now >= next_write;
+      if (write_all)
+        next_write = now + WRITE_INTERVAL;
+
+      try {
+        if (WriteQueued(!write_all))
+          dirty = true;
+
+        if (dirty && (stopping || now >= next_sync)) {
+          Sync();
+          dirty = false;
+          next_sync = now + SYNC_INTERVAL;
+        }
+      } catch (...) {
+        failed = true;
+
+        const std::lock_guard<Mutex> lock(mutex);
+        error = std::current_exception();
+      }
+    }
+
+    if (stopping)
+      break;
+  }
+}
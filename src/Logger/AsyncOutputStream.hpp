@@ -0,0 +1,202 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_LOGGER_ASYNC_OUTPUT_STREAM_HPP
+#define XCSOAR_LOGGER_ASYNC_OUTPUT_STREAM_HPP
+
+#include "io/OutputStream.hxx"
+#include "thread/Thread.hpp"
+#include "thread/Mutex.hxx"
+#include "thread/Cond.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include <cstdint>
+
+class FileOutputStream;
+
+/**
+ * An #OutputStream which passes data to a #FileOutputStream on a
+ * dedicated I/O thread, so a stalling storage device never blocks
+ * the thread which produces the data (e.g. the calculation thread
+ * writing IGC fixes).
+ *
+ * Write() copies the data into a bounded lock-free ring buffer.  The
+ * I/O thread writes whole #BLOCK_SIZE blocks when the buffer fills
+ * up, everything queued once per #WRITE_INTERVAL, and calls fsync()
+ * once per #SYNC_INTERVAL.
+ *
+ * If the ring buffer is full, Write() keeps the data in an overflow
+ * buffer owned by the producer and moves it to the ring buffer
+ * later.  Only if that grows beyond #MAX_OVERFLOW is data discarded
+ * (see Stats::n_discarded).
+ *
+ * There must be only one producer at a time: calls to Write(),
+ * GetStats() and Close() must be serialised by the caller.
+ */
+class AsyncOutputStream final : public OutputStream, private Thread {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t BLOCK_SIZE = 4096;
+  static constexpr size_t MAX_OVERFLOW = 4 * 1024 * 1024;
+
+  static constexpr Clock::duration WRITE_INTERVAL = std::chrono::seconds(1);
+  static constexpr Clock::duration SYNC_INTERVAL = std::chrono::seconds(10);
+
+  struct Stats {
+    /**
+     * The largest number of bytes which were queued in the ring
+     * buffer.
+     */
+    size_t max_queued;
+
+    /**
+     * The number of Write() calls which did not fit into the ring
+     * buffer.
+     */
+    unsigned n_overflows;
+
+    /**
+     * The number of bytes which were discarded because the overflow
+     * buffer was full.
+     */
+    size_t n_discarded;
+
+    unsigned n_writes, n_syncs;
+
+    /**
+     * The longest and the accumulated time the I/O thread was
+     * blocked in write() or fsync().
+     */
+    Clock::duration max_stall, total_stall;
+  };
+
+private:
+  FileOutputStream &file;
+
+  /**
+   * The ring buffer; its size is a power of two.
+   */
+  const std::unique_ptr<uint8_t[]> buffer;
+  const size_t capacity;
+
+  /**
+   * The total number of bytes appended by the producer and consumed
+   * by the I/O thread.  Only the producer writes #head, only the I/O
+   * thread writes #tail.
+   */
+  std::atomic<size_t> head{0}, tail{0};
+
+  std::atomic<bool> stop_requested{false};
+
+  /* the following attributes are owned by the producer */
+
+  std::vector<uint8_t> overflow;
+
+  size_t max_queued = 0, n_discarded = 0;
+  unsigned n_overflows = 0;
+
+  Mutex mutex;
+  Cond cond;
+
+  /* the following attributes are protected by #mutex */
+
+  unsigned n_writes = 0, n_syncs = 0;
+  Clock::duration max_stall{}, total_stall{};
+
+  /**
+   * The first I/O error; after that, all data is discarded.
+   */
+  std::exception_ptr error;
+
+public:
+  /**
+   * Throws if the thread cannot be started.
+   *
+   * @param capacity the size of the ring buffer; must be a power of
+   * two and a multiple of #BLOCK_SIZE
+   */
+  explicit AsyncOutputStream(FileOutputStream &_file,
+                             size_t _capacity=256 * 1024);
+
+  /**
+   * Calls Close() if that has not been done yet, ignoring errors.
+   */
+  ~AsyncOutputStream() noexcept;
+
+  AsyncOutputStream(const AsyncOutputStream &) = delete;
+  AsyncOutputStream &operator=(const AsyncOutputStream &) = delete;
+
+  /**
+   * Write all pending data to the file, sync it and stop the I/O
+   * thread.  This may block.  After that, Write() must not be called
+   * anymore.
+   *
+   * Throws the first I/O error.
+   */
+  void Close();
+
+  Stats GetStats() noexcept;
+
+  /* virtual methods from class OutputStream */
+  void Write(const void *data, size_t size) override;
+
+private:
+  size_t GetQueued() const noexcept {
+    return head.load(std::memory_order_acquire) -
+      tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Copy as much as possible into the ring buffer.
+   *
+   * @return the number of bytes which were copied
+   */
+  size_t Push(const uint8_t *data, size_t size) noexcept;
+
+  /**
+   * Called by the I/O thread.
+   *
+   * @param whole_blocks write only up to the last #BLOCK_SIZE
+   * boundary
+   * @return true if something was written
+   */
+  bool WriteQueued(bool whole_blocks);
+
+  /**
+   * Called by the I/O thread.
+   */
+  void Sync();
+
+  void AddStall(Clock::duration stall) noexcept;
+
+  /* virtual methods from class Thread */
+  void Run() noexcept override;
+};
+
+#endif
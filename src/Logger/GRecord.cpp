@@ -68,27 +68,47 @@ GRecord::AppendRecordToBuffer(const char *in)
 }
 
 /**
+ * Copy the characters which are included in the digest to the given
+ * buffer.
+ *
  * @param ignore_comma if true, then the comma is ignored, even though
  * it's a valid IGC character
+ * @param s the source string; it is advanced past all consumed
+ * characters, which may be fewer than all if the buffer is full
+ * @return the end of the filtered data in the destination buffer
  */
-static void
-AppendIGCString(MD5 &md5, const char *s, bool ignore_comma)
+static char *
+FilterIGCString(char *dest, char *const end, const char *&s,
+                bool ignore_comma)
 {
-  while (*s != '\0') {
+  while (*s != '\0' && dest != end) {
     const char ch = *s++;
     if (ignore_comma && ch == ',')
       continue;
 
     if (IsValidIGCChar(ch))
-      md5.Append(ch);
+      *dest++ = ch;
   }
+
+  return dest;
 }
 
 void
 GRecord::AppendStringToBuffer(const char *in)
 {
-  for (auto &i : md5)
-    AppendIGCString(i, in, ignore_comma);
+  /* filter the string only once and feed the result to all MD5
+     contexts in bulk; records are short, so this loop usually runs
+     only once */
+  char buffer[256];
+
+  while (*in != '\0') {
+    const char *end = FilterIGCString(buffer, buffer + sizeof(buffer),
+                                      in, ignore_comma);
+    const size_t length = end - buffer;
+
+    for (auto &i : md5)
+      i.Append(buffer, length);
+  }
 }
 
 void
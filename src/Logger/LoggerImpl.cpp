@@ -97,7 +97,20 @@ LoggerImpl::StopLogger(const NMEAInfo &gps_info)
   if (!simulator)
     writer->Sign();
 
-  writer->Flush();
+  try {
+    writer->Close();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to write the IGC file");
+  }
+
+  const auto stats = writer->GetWriteStats();
+  const auto max_stall =
+    std::chrono::duration_cast<std::chrono::milliseconds>(stats.max_stall);
+  LogFormat("IGC writer: %u writes, %u syncs, max queue %u bytes, "
+            "%u overflows, %u bytes discarded, max stall %u ms",
+            stats.n_writes, stats.n_syncs, unsigned(stats.max_queued),
+            stats.n_overflows, unsigned(stats.n_discarded),
+            unsigned(max_stall.count()));
 
   LogFormat(_T("Logger stopped: %s"), filename.c_str());
 
@@ -22,17 +22,34 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "io/TextWriter.hpp"
+#include "Logger/AsyncOutputStream.hpp"
+#include "io/FileOutputStream.hxx"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "time/BrokenDateTime.hpp"
 #include "thread/Mutex.hxx"
 #include "system/Path.hpp"
 #include "util/StaticString.hxx"
 
+#include <string.h>
+
 namespace NMEALogger
 {
+  /**
+   * The log file; data is written on an I/O thread, so a slow storage
+   * device does not block the device threads which call Log().
+   */
+  struct Writer {
+    FileOutputStream file;
+    AsyncOutputStream async;
+
+    explicit Writer(Path path)
+      :file(path, FileOutputStream::Mode::CREATE_VISIBLE),
+       async(file) {}
+  };
+
   static Mutex mutex;
-  static TextWriter *writer;
+  static Writer *writer;
 
   bool enabled = false;
 
@@ -56,13 +73,14 @@ NMEALogger::Start()
   const auto logs_path = MakeLocalPath(_T("logs"));
 
   const auto path = AllocatedPath::Build(logs_path, name);
-  writer = new TextWriter(path, false);
-  if (writer == nullptr)
-    return false;
 
-  if (!writer->IsOpen()) {
-    delete writer;
-    writer = nullptr;
+  try {
+    writer = new Writer(path);
+  } catch (...) {
+    LogError(std::current_exception());
+
+    /* don't retry for each line */
+    enabled = false;
     return false;
   }
 
@@ -72,7 +90,19 @@ NMEALogger::Start()
 void
 NMEALogger::Shutdown()
 {
+  const std::lock_guard<Mutex> lock(mutex);
+  if (writer == nullptr)
+    return;
+
+  try {
+    writer->async.Close();
+    writer->file.Commit();
+  } catch (...) {
+    LogError(std::current_exception(), "Failed to write the NMEA log");
+  }
+
   delete writer;
+  writer = nullptr;
 }
 
 void
@@ -82,6 +112,19 @@ NMEALogger::Log(const char *text)
     return;
 
   std::lock_guard<Mutex> lock(mutex);
-  if (Start())
-    writer->WriteLine(text);
+  if (!Start())
+    return;
+
+#ifdef HAVE_POSIX
+  static constexpr char newline[] = "\n";
+#else
+  static constexpr char newline[] = "\r\n";
+#endif
+
+  try {
+    writer->async.Write(text, strlen(text));
+    writer->async.Write(newline, sizeof(newline) - 1);
+  } catch (...) {
+    LogError(std::current_exception());
+  }
 }
@@ -81,6 +81,13 @@ MapLook::Initialise(const MapSettings &settings,
 
   thermal_source_icon.LoadResource(IDB_THERMALSOURCE, IDB_THERMALSOURCE_HD);
 
+  static constexpr Color clrLiftMap(0xd0, 0x80, 0x20);
+  lift_map_pen.Create(Layout::ScalePenWidth(1),
+                      HasColors() ? clrLiftMap : COLOR_BLACK);
+  lift_map_brush.Create(IsDithered()
+                        ? COLOR_WHITE
+                        : ColorWithAlpha(clrLiftMap, alpha));
+
   traffic_safe_icon.LoadResource(IDB_TRAFFIC_SAFE, IDB_TRAFFIC_SAFE_HD, false);
   traffic_warning_icon.LoadResource(IDB_TRAFFIC_WARNING, IDB_TRAFFIC_WARNING_HD, false);
   traffic_alarm_icon.LoadResource(IDB_TRAFFIC_ALARM, IDB_TRAFFIC_ALARM_HD, false);
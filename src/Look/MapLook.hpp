@@ -85,6 +85,13 @@ struct MapLook {
 
   MaskedIcon thermal_source_icon;
 
+  /**
+   * Marks a #LiftMap cell, i.e. lift found on an earlier flight; it
+   * must not be confused with #thermal_source_icon.
+   */
+  Pen lift_map_pen;
+  Brush lift_map_brush;
+
   MaskedIcon traffic_safe_icon;
   MaskedIcon traffic_warning_icon;
   MaskedIcon traffic_alarm_icon;
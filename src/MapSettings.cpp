@@ -66,6 +66,7 @@ MapSettings::SetDefaults()
   final_glide_bar_display_mode = FinalGlideBarDisplayMode::ON;
   vario_bar_enabled = false;
   show_fai_triangle_areas = false;
+  show_lift_map = false;
   skylines_traffic_map_mode = DisplaySkyLinesTrafficMapMode::SYMBOL;
 
   trail.SetDefaults();
@@ -193,6 +193,12 @@ struct MapSettings {
    */
   bool show_fai_triangle_areas;
 
+  /**
+   * Mark the places where lift was found on earlier flights (see
+   * #LiftMap)?
+   */
+  bool show_lift_map;
+
   /**
    * Display skylines name on map
    */
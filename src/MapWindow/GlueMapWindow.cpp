@@ -84,6 +84,12 @@ GlueMapWindow::SetTerrain(RasterTerrain *_terrain)
                         });
 }
 
+void
+GlueMapWindow::OnRaspMapLoaded() noexcept
+{
+  redraw_notify.SendNotification();
+}
+
 void
 GlueMapWindow::SetMapSettings(const MapSettings &new_value)
 {
@@ -203,6 +203,7 @@ protected:
                            const PixelPoint aircraft_pos) override;
   virtual void RenderTrackBearing(Canvas &canvas,
                                   const PixelPoint aircraft_pos) override;
+  void OnRaspMapLoaded() noexcept override;
 
   /* virtual methods from class Window */
   virtual void OnCreate() override;
@@ -245,6 +246,11 @@ private:
   void DrawVario(Canvas &canvas, const PixelRect &rc) const;
   void DrawStallRatio(Canvas &canvas, const PixelRect &rc) const;
 
+  /**
+   * Draw the per-stage timings of the #RenderProfiler (if enabled).
+   */
+  void DrawRenderProfile(Canvas &canvas, const PixelRect &rc) const;
+
   void SwitchZoomClimb();
 
   void SaveDisplayModeScales();
@@ -403,7 +403,10 @@ GlueMapWindow::OnPaint(Canvas &canvas)
 void
 GlueMapWindow::OnPaintBuffer(Canvas &canvas)
 {
+  const RenderProfiler::ScopeFrame profile_frame(draw_sw);
+
 #ifdef ENABLE_OPENGL
+  draw_sw.Mark("ExchangeBlackboard");
   ExchangeBlackboard();
 
   EnterDrawThread();
@@ -411,6 +414,7 @@ GlueMapWindow::OnPaintBuffer(Canvas &canvas)
 
   MapWindow::OnPaintBuffer(canvas);
 
+  draw_sw.Mark("DrawMapScale");
   DrawMapScale(canvas, GetClientRect(), render_projection);
   if (IsPanning())
     DrawPanInfo(canvas);
@@ -466,4 +470,9 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc)
     DrawVario(canvas, rc);
     DrawGPSStatus(canvas, rc, Basic());
   }
+
+  if (draw_sw.IsEnabled()) {
+    draw_sw.Mark("DrawRenderProfile");
+    DrawRenderProfile(canvas, rc);
+  }
 }
@@ -42,6 +42,9 @@ Copyright_License {
 #include "Look/GestureLook.hpp"
 #include "Input/InputEvents.hpp"
 #include "Renderer/MapScaleRenderer.hpp"
+#include "util/StaticString.hxx"
+
+#include <algorithm>
 
 #include <stdio.h>
 
@@ -452,3 +455,64 @@ GlueMapWindow::DrawStallRatio(Canvas &canvas, const PixelRect &rc) const
     canvas.DrawLine(p.At(-1, -m), p.At(-11, -m));
   }
 }
+
+void
+GlueMapWindow::DrawRenderProfile(Canvas &canvas, const PixelRect &rc) const
+{
+  const auto summary = draw_sw.GetSummary();
+  if (summary.n_frames == 0)
+    return;
+
+  const Font &font = *look.overlay.overlay_font;
+  canvas.Select(font);
+
+  const int padding = Layout::GetTextPadding();
+  const unsigned line_height = font.GetHeight();
+
+  StaticString<64> buffer;
+
+  unsigned name_width = canvas.CalcTextSize(_T("Total")).width;
+  for (const auto &stage : summary.stages) {
+    buffer.SetASCII(stage.name);
+    name_width = std::max(name_width, canvas.CalcTextSize(buffer).width);
+  }
+
+  const unsigned value_width =
+    canvas.CalcTextSize(_T("000.0 / 000.0 ms")).width;
+  const unsigned n_lines = summary.stages.size() + 1;
+
+  PixelRect box;
+  box.left = rc.left + padding;
+  box.top = rc.top + padding;
+  box.right = box.left + 3 * padding + name_width + value_width;
+  box.bottom = std::min<int>(box.top + 2 * padding + n_lines * line_height,
+                             rc.bottom);
+
+  canvas.DrawFilledRectangle(box, COLOR_BLACK);
+  canvas.SetTextColor(COLOR_WHITE);
+  canvas.SetBackgroundTransparent();
+
+  const int name_x = box.left + padding;
+  const int value_x = name_x + name_width + padding;
+  int y = box.top + padding;
+
+  auto draw_line = [&](const TCHAR *name, float last, float average){
+    canvas.DrawText({name_x, y}, name);
+
+    buffer.Format(_T("%5.1f / %5.1f ms"), (double)last, (double)average);
+    canvas.DrawText({value_x, y}, buffer);
+
+    y += line_height;
+  };
+
+  for (const auto &stage : summary.stages) {
+    if (y + (int)line_height > box.bottom)
+      return;
+
+    StaticString<64> name;
+    name.SetASCII(stage.name);
+    draw_line(name, stage.last, stage.average);
+  }
+
+  draw_line(_T("Total"), summary.frame_last, summary.frame_average);
+}
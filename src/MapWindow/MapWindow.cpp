@@ -27,6 +27,7 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Weather/Rasp/RaspRenderer.hpp"
+#include "Weather/Rasp/RaspMapCache.hpp"
 #include "Computer/GlideComputer.hpp"
 
 #ifdef ENABLE_OPENGL
@@ -75,6 +76,9 @@ void
 MapWindow::FlushCaches()
 {
   background.Flush();
+#ifndef ENABLE_OPENGL
+  terrain_tiles.Flush();
+#endif
   if (rasp_renderer)
     rasp_renderer->Flush();
   airspace_renderer.Flush();
@@ -136,9 +140,10 @@ MapWindow::OnPaintBuffer(Canvas &canvas)
   GLCanvasScissor scissor(canvas);
 #endif
 
+  const RenderProfiler::ScopeFrame profile_frame(draw_sw);
+
   // Render the moving map
   Render(canvas, GetClientRect());
-  draw_sw.Finish();
 
 #ifndef ENABLE_OPENGL
   /* save the generation number which was active when rendering had
@@ -164,11 +169,20 @@ MapWindow::SetTerrain(RasterTerrain *_terrain)
 {
   terrain = _terrain;
   background.SetTerrain(_terrain);
+#ifndef ENABLE_OPENGL
+  terrain_tiles.SetTerrain(_terrain);
+#endif
 }
 
 void
 MapWindow::SetRasp(const std::shared_ptr<RaspStore> &_rasp_store)
 {
   rasp_renderer.reset();
+  rasp_maps.reset();
   rasp_store = _rasp_store;
+
+  if (rasp_store != nullptr)
+    rasp_maps = std::make_unique<RaspMapCache>(rasp_store, [this](){
+      OnRaspMapLoaded();
+    });
 }
@@ -31,10 +31,11 @@ Copyright_License {
 #include "ui/canvas/BufferCanvas.hpp"
 #endif
 #include "Renderer/LabelBlock.hpp"
-#include "Screen/StopWatch.hpp"
+#include "Screen/RenderProfiler.hpp"
 #include "MapWindowBlackboard.hpp"
 #include "Renderer/AirspaceLabelRenderer.hpp"
 #include "Renderer/BackgroundRenderer.hpp"
+#include "Renderer/TerrainTileCache.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
 #include "util/Compiler.h"
@@ -49,6 +50,7 @@ class TopographyStore;
 class CachedTopographyRenderer;
 class RasterTerrain;
 class RaspStore;
+class RaspMapCache;
 class RaspRenderer;
 class MapOverlay;
 class Waypoints;
@@ -125,6 +127,13 @@ protected:
 
   std::shared_ptr<RaspStore> rasp_store;
 
+  /**
+   * Decodes RASP maps in background, and keeps the recently used
+   * ones.  It outlives #rasp_renderer, so switching between
+   * parameters does not need to decode again.
+   */
+  std::unique_ptr<RaspMapCache> rasp_maps;
+
   /**
    * The current RASP renderer.  Modifications to this pointer (but
    * not to the #RaspRenderer instance) are protected by
@@ -139,6 +148,16 @@ protected:
   const TrafficLook &traffic_look;
 
   BackgroundRenderer background;
+
+#ifndef ENABLE_OPENGL
+  /**
+   * Terrain prerendered in tiles, to avoid rendering it again while
+   * panning and rotating the map.  Falls back to #background if
+   * it is not (yet) usable.
+   */
+  TerrainTileCache terrain_tiles;
+#endif
+
   WaypointRenderer waypoint_renderer;
 
   AirspaceRenderer airspace_renderer;
@@ -177,10 +196,10 @@ protected:
 #endif
 
   /**
-   * The #StopWatch used to benchmark the DrawThread,
+   * Measures the render stages of the DrawThread,
    * i.e. OnPaintBuffer().
    */
-  ScreenStopWatch draw_sw;
+  RenderProfiler draw_sw{"DrawMap"};
 
   friend class DrawThread;
 
@@ -189,6 +208,10 @@ public:
             const TrafficLook &traffic_look);
   virtual ~MapWindow();
 
+  RenderProfiler &GetRenderProfiler() noexcept {
+    return draw_sw;
+  }
+
   /**
    * Is the rendered map following the user's aircraft (i.e. near it)?
    */
@@ -338,6 +361,12 @@ protected:
   /* virtual methods from class DoubleBufferWindow */
   virtual void OnPaintBuffer(Canvas& canvas) override;
 
+  /**
+   * Called by the #RaspMapCache thread after the selected RASP map
+   * has been loaded.
+   */
+  virtual void OnRaspMapLoaded() noexcept {}
+
 private:
   /**
    * Renders the terrain background
@@ -345,6 +374,26 @@ private:
    */
   void RenderTerrain(Canvas &canvas);
 
+#ifndef ENABLE_OPENGL
+  /**
+   * Is there terrain to be prerendered?  Called by the #DrawThread
+   * while it is idle.
+   */
+  bool HasPrefetchWork() const noexcept {
+    return terrain_tiles.HasPrefetchWork();
+  }
+
+  /**
+   * Prerender one terrain tile which is likely to become visible
+   * soon.  Called by the #DrawThread while it is idle.
+   *
+   * @return false if no tile was rendered
+   */
+  bool PrefetchTerrainTile() noexcept {
+    return terrain_tiles.Prefetch(buffer_canvas);
+  }
+#endif
+
   void RenderRasp(Canvas &canvas);
 
   void RenderTerrainAbove(Canvas &canvas, bool working);
@@ -29,7 +29,6 @@ Copyright_License {
 #include "Topography/CachedTopographyRenderer.hpp"
 #include "Renderer/AircraftRenderer.hpp"
 #include "Renderer/WaveRenderer.hpp"
-#include "Operation/Operation.hpp"
 #include "Tracking/SkyLines/Data.hpp"
 
 #ifdef HAVE_NOAA
@@ -46,6 +45,16 @@ MapWindow::RenderTrackBearing(Canvas &canvas, const PixelPoint aircraft_pos)
 void
 MapWindow::RenderTerrain(Canvas &canvas)
 {
+#ifndef ENABLE_OPENGL
+  const auto &terrain_settings = GetMapSettings().terrain;
+  const auto &basic = Basic();
+  if (terrain_tiles.Draw(canvas, render_projection, terrain_settings,
+                         BackgroundRenderer::CalcShadingAngle(terrain_settings,
+                                                              Calculated()),
+                         basic.track_available ? &basic.track : nullptr))
+    return;
+#endif
+
   background.SetShadingAngle(render_projection, GetMapSettings().terrain,
                              Calculated());
   background.Draw(canvas, render_projection, GetMapSettings().terrain);
@@ -73,15 +82,12 @@ MapWindow::RenderRasp(Canvas &canvas)
 #ifndef ENABLE_OPENGL
     const std::lock_guard<Mutex> lock(mutex);
 #endif
-    rasp_renderer.reset(new RaspRenderer(*rasp_store, state.map));
+    rasp_renderer.reset(new RaspRenderer(*rasp_maps, state.map));
   }
 
   rasp_renderer->SetTime(state.time);
 
-  {
-    QuietOperationEnvironment operation;
-    rasp_renderer->Update(Calculated().date_time_local, operation);
-  }
+  rasp_renderer->Update(Calculated().date_time_local);
 
   const auto &terrain_settings = GetMapSettings().terrain;
   if (rasp_renderer->Generate(render_projection, terrain_settings))
@@ -249,12 +255,15 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// aircraft level items
   // Render the snail trail
+  draw_sw.Mark("RenderTrail");
   if (basic.location_available)
     RenderTrail(canvas, aircraft_pos);
 
+  draw_sw.Mark("DrawWaves");
   DrawWaves(canvas);
 
   // Render estimate of thermal location
+  draw_sw.Mark("DrawThermalEstimate");
   DrawThermalEstimate(canvas);
 
   //////////////////////////////////////////////// text items
@@ -287,6 +296,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// traffic
   // Draw traffic
+  draw_sw.Mark("DrawTraffic");
 
 #ifdef HAVE_SKYLINES_TRACKING
   DrawSkyLinesTraffic(canvas);
@@ -302,6 +312,7 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// own aircraft
   // Finally, draw you!
+  draw_sw.Mark("DrawAircraft");
   if (basic.location_available)
     AircraftRenderer::Draw(canvas, GetMapSettings(), look.aircraft,
                            basic.attitude.heading - render_projection.GetScreenAngle(),
@@ -309,5 +320,6 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
 
   //////////////////////////////////////////////// important overlays
   // Draw intersections on top of aircraft
+  draw_sw.Mark("DrawIntersections");
   airspace_renderer.DrawIntersections(canvas, render_projection);
 }
@@ -24,7 +24,51 @@ Copyright_License {
 #include "MapWindow.hpp"
 #include "Look/MapLook.hpp"
 #include "ui/canvas/Icon.hpp"
+#include "Screen/Layout.hpp"
 #include "Tracking/SkyLines/Data.hpp"
+#include "Computer/GlideComputer.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Scope.hpp"
+#endif
+
+#include <mutex>
+
+/**
+ * Cells of the #LiftMap weaker than this [m/s] are not drawn.
+ */
+static constexpr double LIFT_MAP_MIN_LIFT = 1;
+
+/**
+ * Cells of the #LiftMap older than this [s] are not drawn.
+ */
+static constexpr int64_t LIFT_MAP_MAX_AGE = 30 * 24 * 3600;
+
+static void
+DrawLiftMap(Canvas &canvas, const MapLook &look,
+            const WindowProjection &projection,
+            const LiftMap &lift_map, int64_t min_time)
+{
+  canvas.Select(look.lift_map_pen);
+  canvas.Select(look.lift_map_brush);
+
+#ifdef ENABLE_OPENGL
+  const ScopeAlphaBlend alpha_blend;
+#endif
+
+  const unsigned radius = Layout::Scale(3);
+
+  const std::lock_guard<Mutex> lock(lift_map.mutex);
+  lift_map.VisitWithinRange(projection.GetGeoScreenCenter(),
+                            projection.GetScreenDistanceMeters(),
+                            [&](const LiftMap::Cell &cell){
+    if (cell.lift < LIFT_MAP_MIN_LIFT || cell.time < min_time)
+      return;
+
+    if (auto p = projection.GeoToScreenIfVisible(cell.location))
+      canvas.DrawCircle(*p, radius);
+  });
+}
 
 template<typename T>
 static void
@@ -67,6 +111,13 @@ MapWindow::DrawThermalEstimate(Canvas &canvas) const
                      calculated.wind_available
                      ? calculated.wind : SpeedVector::Zero());
 
+  if (GetMapSettings().show_lift_map && glide_computer != nullptr)
+    DrawLiftMap(canvas, look, render_projection,
+                glide_computer->GetLiftMap(),
+                basic.date_time_utc.IsDatePlausible()
+                ? basic.date_time_utc.ToUnixTimeUTC() - LIFT_MAP_MAX_AGE
+                : 0);
+
   const auto &cloud_settings = ComputerSettings().tracking.skylines.cloud;
   if (cloud_settings.show_thermals && skylines_data != nullptr) {
     std::lock_guard<Mutex> lock(skylines_data->mutex);
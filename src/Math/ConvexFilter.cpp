@@ -30,15 +30,23 @@ ConvexFilter::UpdateConvex(double x, double y, int csign) noexcept
   if (!IsEmpty() && x <= x_max)
     return;
 
+  /* never let the slots fill up: that would decimate them and merge
+     new points into the last slot, and the pruning below needs the
+     hull's vertices as individual slots; the oldest vertex is
+     dropped instead */
+  if (slots.full())
+    Remove(0);
+
   Update(x, y, 1);
 
   // check pruning of previous points
 
-  while (sum_n > 2) {
-    const Slot& next = slots[sum_n-1];
-    const Slot& prev = slots[sum_n-3];
+  while (slots.size() > 2) {
+    const unsigned n = slots.size();
+    const Slot& next = slots[n-1];
+    const Slot& prev = slots[n-3];
     const double m = (next.y-prev.y)/(next.x-prev.x);
-    const Slot& cur = slots[sum_n-2];
+    const Slot& cur = slots[n-2];
     const double y_est = (cur.x - prev.x)*m + prev.y;
 
     // if this point doesn't need pruning, neither will predecessors
@@ -47,7 +55,7 @@ ConvexFilter::UpdateConvex(double x, double y, int csign) noexcept
 
     // prune this point, and continue checking previous points for
     // pruning
-    Remove(sum_n-2);
+    Remove(n-2);
   }
 }
 
@@ -56,5 +64,5 @@ ConvexFilter::GetLastY() const noexcept
 {
   assert(!IsEmpty());
 
-  return slots[sum_n-1].y;
+  return slots.back().y;
 }
@@ -166,17 +166,12 @@ LeastSquares::Add(double x, double y, double weight) noexcept
 void
 LeastSquares::Remove(const unsigned i) noexcept
 {
-  assert(i< sum_n);
+  assert(i < slots.size());
 
   const auto &pt = slots[i];
-  // Remove weighted point
-  double weight = 1;
-#ifdef LEASTSQS_WEIGHT_STORE
-  weight = pt.weight;
-#endif
-
-  sum_xxw -= Square(pt.x) * weight;
-  sum_xyw -= (pt.x * pt.y * weight);
+  // Remove weighted point (a slot may hold several merged samples)
+  sum_xxw -= pt.sum_xxw;
+  sum_xyw -= pt.sum_xyw;
 
   StoreRemove(i);
 
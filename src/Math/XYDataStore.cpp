@@ -30,6 +30,7 @@ XYDataStore::StoreReset() noexcept
   sum_xw = 0.;
   sum_yw = 0.;
   sum_weights = 0.;
+  slot_samples = 1;
   slots.clear();
 }
 
@@ -50,9 +51,15 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
     x_min = x;
 
   // Add point
-  // TODO code: really should have a circular buffer here
-  if (!slots.full())
-    slots.append() = Slot(x, y, weight);
+  const Slot slot(x, y, weight);
+  if (!slots.empty() && slots.back().n < slot_samples) {
+    slots.back().Merge(slot);
+  } else {
+    if (slots.full())
+      Decimate();
+
+    slots.append() = slot;
+  }
 
   ++sum_n;
 
@@ -66,20 +73,34 @@ XYDataStore::StoreAdd(double x, double y, double weight) noexcept
 void
 XYDataStore::StoreRemove(const unsigned i) noexcept
 {
-  assert(i< sum_n);
+  assert(i < slots.size());
   const auto &pt = slots[i];
 
   // Remove weighted point
-  auto weight = 1;
-#ifdef LEASTSQS_WEIGHT_STORE
-  weight = pt.weight;
-#endif
+  const double weight = pt.GetWeight();
 
   sum_weights -= weight;
 
   sum_xw -= pt.x * weight;
   sum_yw -= pt.y * weight;
 
+  sum_n -= pt.n;
   slots.remove(i);
-  --sum_n;
+}
+
+void
+XYDataStore::Decimate() noexcept
+{
+  const unsigned n = slots.size();
+  unsigned dest = 0;
+  for (unsigned i = 0; i + 1 < n; i += 2, ++dest) {
+    slots[dest] = slots[i];
+    slots[dest].Merge(slots[i + 1]);
+  }
+
+  if (n % 2 != 0)
+    slots[dest++] = slots[n - 1];
+
+  slots.shrink(dest);
+  slot_samples *= 2;
 }
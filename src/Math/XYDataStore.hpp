@@ -23,6 +23,12 @@ Copyright_License {
 
 /**
  * Basic container class for storage of X-Y data pairs
+ *
+ * The number of slots is fixed.  Once they are all used, adjacent
+ * slots are merged pairwise and each slot from then on covers twice
+ * as many samples, so the store always spans the full data set at a
+ * resolution which degrades gracefully, while memory usage and the
+ * cost of iterating over the slots stay constant.
  */
 
 #ifndef _XYDATASTORE_H
@@ -46,13 +52,39 @@ protected:
 
   unsigned sum_n;
 
+  /**
+   * The maximum number of samples merged into one slot.  This is
+   * always a power of two; it starts at 1 and is doubled each time
+   * the slots are decimated.
+   */
+  unsigned slot_samples;
+
   struct Slot {
+    /**
+     * The (weighted) mean of the x/y values of all samples in this
+     * slot.
+     */
     double x, y;
 
 #ifdef LEASTSQS_WEIGHT_STORE
+    /**
+     * The sum of the weights of all samples in this slot.
+     */
     double weight;
 #endif
 
+    /**
+     * The weighted sums of x*x and x*y of all samples in this slot.
+     * The mean alone does not carry them, and they are needed to
+     * remove a merged slot from the regression sums exactly.
+     */
+    double sum_xxw, sum_xyw;
+
+    /**
+     * The number of samples merged into this slot.
+     */
+    unsigned n;
+
     Slot() = default;
 
     constexpr Slot(double _x, double _y, double _weight) noexcept
@@ -60,10 +92,44 @@ protected:
 #ifdef LEASTSQS_WEIGHT_STORE
       , weight(_weight)
 #endif
+      , sum_xxw(_x * _x * _weight), sum_xyw(_x * _y * _weight)
+      , n(1)
     {}
+
+    constexpr double GetWeight() const noexcept {
+#ifdef LEASTSQS_WEIGHT_STORE
+      return weight;
+#else
+      return n;
+#endif
+    }
+
+    /**
+     * Merge another (later) slot into this one.
+     */
+    void Merge(const Slot &other) noexcept {
+      double a = GetWeight(), b = other.GetWeight();
+      if (!(a + b > 0)) {
+        /* no usable weights: fall back to the sample count */
+        a = n;
+        b = other.n;
+      }
+
+      const double total = a + b;
+      x = (x * a + other.x * b) / total;
+      y = (y * a + other.y * b) / total;
+#ifdef LEASTSQS_WEIGHT_STORE
+      weight += other.weight;
+#endif
+      sum_xxw += other.sum_xxw;
+      sum_xyw += other.sum_xyw;
+      n += other.n;
+    }
   };
 
-  TrivialArray<Slot, 1000> slots;
+  static constexpr unsigned MAX_SLOTS = 1000;
+
+  TrivialArray<Slot, MAX_SLOTS> slots;
 
 public:
   constexpr bool IsEmpty() const noexcept {
@@ -119,11 +185,18 @@ protected:
   void StoreAdd(double x, double y, double weight=1) noexcept;
 
   /**
-   * Remove data point to the values.
-   * If weights aren't stored, this assumes weight = 1
+   * Remove the data points in the specified slot from the values.
+   * If weights aren't stored, this assumes weight = 1 per sample.
    */
   void StoreRemove(const unsigned i) noexcept;
 
+private:
+  /**
+   * Merge adjacent slots pairwise, halving the number of slots in
+   * use and doubling #slot_samples.
+   */
+  void Decimate() noexcept;
+
 };
 
 static_assert(std::is_trivial<XYDataStore>::value, "type is not trivial");
@@ -52,8 +52,7 @@ MergeThread::Process()
   computer.Compute(device_blackboard.SetMoreData(), last_any, last_fix,
                    device_blackboard.Calculated());
 
-  flarm_computer.Process(device_blackboard.SetBasic().flarm,
-                         last_fix.flarm, basic);
+  flarm_computer.Process(device_blackboard.SetBasic().flarm, basic);
 }
 
 void
@@ -53,7 +53,7 @@ Profile::SaveFile(const ProfileMap &map, Path path)
   KeyValueFileWriter kvwriter(buffered);
 
   for (const auto &i : map)
-    kvwriter.Write(i.first.c_str(), i.second.c_str());
+    kvwriter.Write(i.first.c_str(), i.second.text.c_str());
 
   buffered.Flush();
   file.Commit();
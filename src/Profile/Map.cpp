@@ -23,19 +23,47 @@ Copyright_License {
 
 #include "Map.hpp"
 
+#include <tuple>
+
+void
+ProfileMap::clear()
+{
+  if (map.empty())
+    return;
+
+  map.clear();
+  ++serial;
+  SetModified();
+}
+
+void
+ProfileMap::Remove(const char *key)
+{
+  const auto i = map.find(std::string_view(key));
+  if (i == map.end())
+    return;
+
+  map.erase(i);
+  ++serial;
+  SetModified();
+}
+
 void
 ProfileMap::Set(const char *key, const char *value)
 {
-  auto i = insert(std::make_pair(key, value));
-  if (!i.second) {
+  auto i = map.lower_bound(std::string_view(key));
+  if (i != map.end() && i->first.compare(key) == 0) {
     /* exists already */
 
-    if (i.first->second.compare(value) == 0)
+    if (i->second.text.compare(value) == 0)
       /* not modified, don't set the "modified" flag */
       return;
 
-    i.first->second.assign(value);
-  }
+    i->second.Assign(value, ++serial);
+  } else
+    map.emplace_hint(i, std::piecewise_construct,
+                     std::forward_as_tuple(key),
+                     std::forward_as_tuple(value, ++serial));
 
   SetModified();
 }
@@ -27,8 +27,10 @@ Copyright_License {
 #include "util/StringBuffer.hxx"
 #include "util/Compiler.h"
 
+#include <functional>
 #include <map>
 #include <string>
+#include <string_view>
 
 #include <cstdint>
 #include <tchar.h>
@@ -40,11 +42,79 @@ class AllocatedPath;
 template<typename T> class StringPointer;
 template<typename T> class BasicAllocatedString;
 
-class ProfileMap : public std::map<std::string, std::string> {
-  bool modified;
+class ProfileMap {
+public:
+  struct Value {
+    std::string text;
+
+    /**
+     * The text parsed as a signed and an unsigned integer and as a
+     * floating point number.  Parsing once when the value is set
+     * saves the work in each of the (much more frequent) Get()
+     * calls.  Only valid if #has_integer / #has_number is set.
+     */
+    int integer;
+    unsigned uinteger;
+    double number;
+    bool has_integer, has_number;
+
+    /**
+     * The value of ProfileMap::serial when this value was last
+     * modified.
+     */
+    unsigned serial;
+
+    Value(const char *_text, unsigned _serial)
+      :text(_text), serial(_serial) {
+      Parse();
+    }
+
+    void Assign(const char *_text, unsigned _serial) {
+      text.assign(_text);
+      serial = _serial;
+      Parse();
+    }
+
+  private:
+    void Parse();
+  };
+
+private:
+  /**
+   * The transparent comparator allows looking up a "const char *"
+   * key without constructing a temporary std::string.
+   */
+  using Map = std::map<std::string, Value, std::less<>>;
+
+  Map map;
+
+  /**
+   * Incremented each time a value is added, modified or removed.
+   */
+  unsigned serial = 0;
+
+  bool modified = false;
 
 public:
-  ProfileMap():modified(false) {}
+  using const_iterator = Map::const_iterator;
+
+  const_iterator begin() const {
+    return map.begin();
+  }
+
+  const_iterator end() const {
+    return map.end();
+  }
+
+  bool empty() const {
+    return map.empty();
+  }
+
+  std::size_t size() const {
+    return map.size();
+  }
+
+  void clear();
 
   /**
    * Has the profile been modified since the last SetModified(false)
@@ -61,11 +131,51 @@ public:
     modified = _modified;
   }
 
+  /**
+   * Returns a number which identifies the current state of the
+   * profile.  Pass it to IsModifiedSince() later to find out which
+   * values have been changed in between, e.g. by loading a profile
+   * file.
+   */
+  unsigned GetSerial() const {
+    return serial;
+  }
+
+  /**
+   * Has the specified value been added or modified after
+   * GetSerial() returned the specified number?  Removed values
+   * cannot be tracked; check the map serial for those.
+   */
+  gcc_pure
+  bool IsModifiedSince(const char *key, unsigned since) const {
+    const auto i = map.find(std::string_view(key));
+    return i != map.end() && i->second.serial > since;
+  }
+
   gcc_pure
   bool Exists(const char *key) const {
-    return find(key) != end();
+    return map.find(std::string_view(key)) != map.end();
+  }
+
+  /**
+   * Look up a value in the profile.
+   *
+   * @return the value (gets Invalidated by any write access to the
+   * profile), or nullptr if the key does not exist
+   */
+  gcc_pure
+  const Value *Find(const char *key) const {
+    const auto i = map.find(std::string_view(key));
+    return i != map.end()
+      ? &i->second
+      : nullptr;
   }
 
+  /**
+   * Remove the value, if it exists.
+   */
+  void Remove(const char *key);
+
   // basic string values
 
   /**
@@ -78,11 +188,10 @@ public:
    */
   gcc_pure
   const char *Get(const char *key, const char *default_value=nullptr) const {
-    const auto i = find(key);
-    if (i == end())
-      return default_value;
-
-    return i->second.c_str();
+    const auto *value = Find(key);
+    return value != nullptr
+      ? value->text.c_str()
+      : default_value;
   }
 
   void Set(const char *key, const char *value);
@@ -142,6 +142,7 @@ Profile::Load(const ProfileMap &map, MapSettings &settings)
   map.Get(ProfileKeys::ShowFAITriangleAreas,
           settings.show_fai_triangle_areas);
   ::Load(map, settings.fai_triangle_settings);
+  map.Get(ProfileKeys::ShowLiftMap, settings.show_lift_map);
 
   map.Get(ProfileKeys::EnableVarioBar,
           settings.vario_bar_enabled);
@@ -24,22 +24,33 @@ Copyright_License {
 #include "Map.hpp"
 #include "util/NumberParser.hpp"
 
+void
+ProfileMap::Value::Parse()
+{
+  const char *str = text.c_str();
+  char *endptr;
+
+  integer = ParseInt(str, &endptr, 0);
+  has_integer = endptr != str;
+
+  /* parsed separately, because values above INT_MAX would saturate
+     as a signed integer; both accept the same syntax */
+  uinteger = ParseUnsigned(str, nullptr, 0);
+
+  number = ParseDouble(str, &endptr);
+  has_number = endptr != str;
+}
+
 bool
 ProfileMap::Get(const char *key, int &value) const
 {
   // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a number
-  char *endptr;
-  int tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
+  const Value *v = Find(key);
+  if (v == nullptr || !v->has_integer)
     return false;
 
   // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = v->integer;
   return true;
 }
 
@@ -47,18 +58,12 @@ bool
 ProfileMap::Get(const char *key, short &value) const
 {
   // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a number
-  char *endptr;
-  short tmp = ParseInt(str, &endptr, 0);
-  if (endptr == str)
+  const Value *v = Find(key);
+  if (v == nullptr || !v->has_integer)
     return false;
 
   // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = (short)v->integer;
   return true;
 }
 
@@ -79,18 +84,12 @@ bool
 ProfileMap::Get(const char *key, unsigned &value) const
 {
   // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a unsigned number
-  char *endptr;
-  unsigned tmp = ParseUnsigned(str, &endptr, 0);
-  if (endptr == str)
+  const Value *v = Find(key);
+  if (v == nullptr || !v->has_integer)
     return false;
 
   // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = v->uinteger;
   return true;
 }
 
@@ -120,18 +119,12 @@ bool
 ProfileMap::Get(const char *key, double &value) const
 {
   // Try to read the profile map
-  const char *str = Get(key);
-  if (str == nullptr)
-    return false;
-
-  // Parse the string for a floating point number
-  char *endptr;
-  double tmp = ParseDouble(str, &endptr);
-  if (endptr == str)
+  const Value *v = Find(key);
+  if (v == nullptr || !v->has_number)
     return false;
 
   // Save parsed value to output parameter value and return success
-  value = tmp;
+  value = v->number;
   return true;
 }
 
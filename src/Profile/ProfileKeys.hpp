@@ -194,6 +194,7 @@ extern const char EnableFinalGlideBarMC0[];
 extern const char FinalGlideBarDisplayMode[];
 extern const char EnableVarioBar[];
 extern const char ShowFAITriangleAreas[];
+extern const char ShowLiftMap[];
 extern const char FAITriangleThreshold[];
 extern const char AutoLogger[];
 extern const char DisableAutoLogger[];
@@ -26,6 +26,7 @@ Copyright_License {
 #include "Interface.hpp"
 #include "Components.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "Computer/WarningThread.hpp"
 #include "CalculationThread.hpp"
 #include "MergeThread.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
@@ -113,6 +114,11 @@ CreateCalculationThread()
 
   calculation_thread = new CalculationThread(*glide_computer);
   calculation_thread->SetComputerSettings(CommonInterface::GetComputerSettings());
+
+  /* evaluate airspace warnings in a separate thread, so a large
+     airspace database does not delay the other calculations; new
+     warnings wake up the CalculationThread */
+  glide_computer->EnableWarningThread(TriggerGPSUpdate);
 }
 
 void
@@ -126,6 +132,11 @@ SuspendAllThreads()
 
   CommonInterface::main_window->SuspendThreads();
   calculation_thread->Suspend();
+
+  /* the WarningThread does not get new requests while the
+     CalculationThread is suspended; wait for the pending ones */
+  if (auto *warning_thread = glide_computer->GetWarningThread())
+    warning_thread->LockWaitDone();
 }
 
 void
@@ -25,6 +25,7 @@ Copyright_License {
 
 #include "AirspaceRenderer.hpp"
 #include "AirspaceRendererSettings.hpp"
+#include "AirspaceVertexCache.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "ui/canvas/Canvas.hpp"
 #include "MapWindow/MapCanvas.hpp"
@@ -36,20 +37,106 @@ Copyright_License {
 #include "Engine/Airspace/Predicate/AirspacePredicate.hpp"
 #include "ui/canvas/opengl/Scope.hpp"
 
+#include <optional>
+
+/**
+ * Draws one airspace polygon, preferably from the
+ * #AirspaceVertexCache.  The polygon is only projected to screen
+ * coordinates if the cache can't be used.
+ */
+class AirspacePolygonDrawer {
+  MapCanvas &map_canvas;
+  const WindowProjection &projection;
+  const AirspaceVertexCache &cache;
+  const SearchPointVector &points;
+  const AirspaceVertexCache::Item *const item;
+
+  enum class State {
+    NONE,
+    PREPARED,
+    OUTSIDE,
+  } state = State::NONE;
+
+public:
+  AirspacePolygonDrawer(MapCanvas &_map_canvas,
+                        const WindowProjection &_projection,
+                        const AirspaceVertexCache &_cache,
+                        const AirspacePolygon &airspace) noexcept
+    :map_canvas(_map_canvas), projection(_projection), cache(_cache),
+     points(airspace.GetPoints()), item(cache.Find(airspace)) {}
+
+  /**
+   * @return false if the polygon is completely outside the screen
+   */
+  bool IsVisible() noexcept {
+    /* the GPU clips cached polygons */
+    return item != nullptr || Prepare();
+  }
+
+  /**
+   * Fill the polygon with the brush and pen selected on the #Canvas;
+   * the given color must match the brush.
+   */
+  void Fill(Color color) noexcept {
+    if (item != nullptr && cache.DrawFill(projection, *item, color))
+      return;
+
+    if (Prepare())
+      map_canvas.DrawPrepared();
+  }
+
+  /**
+   * Draw the outline with the pen selected on the #Canvas, which
+   * must be equal to the given one.
+   */
+  void Outline(const Pen &pen) noexcept {
+    if (item != nullptr && AirspaceVertexCache::CanDrawOutline(pen))
+      cache.DrawOutline(projection, *item, pen);
+    else
+      Draw();
+  }
+
+  /**
+   * Draw the polygon with the brush and pen selected on the
+   * #Canvas, without using the cache.  The polygon is projected only
+   * once, no matter how often this is called.
+   */
+  void Draw() noexcept {
+    if (Prepare())
+      map_canvas.DrawPrepared();
+  }
+
+private:
+  bool Prepare() noexcept {
+    if (state == State::NONE)
+      state = map_canvas.PreparePolygon(points)
+        ? State::PREPARED
+        : State::OUTSIDE;
+
+    return state == State::PREPARED;
+  }
+};
+
 class AirspaceVisitorRenderer final
   : protected MapCanvas
 {
+  const WindowProjection &window_projection;
+  const AirspaceVertexCache &vertex_cache;
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  const Pen black_pen{1, COLOR_BLACK};
+
 public:
   AirspaceVisitorRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                          const AirspaceVertexCache &_vertex_cache,
                           const AirspaceLook &_look,
                           const AirspaceWarningCopy &_warnings,
                           const AirspaceRendererSettings &_settings)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
+     window_projection(_projection), vertex_cache(_vertex_cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glStencilMask(0xff);
@@ -100,7 +187,9 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    AirspacePolygonDrawer drawer(*this, window_projection, vertex_cache,
+                                 airspace);
+    if (!drawer.IsVisible())
       return;
 
     const AirspaceClassRendererSettings &class_settings =
@@ -119,28 +208,34 @@ private:
       if (!fill_airspace) {
         // set stencil for filling (bit 0)
         SetFillStencil();
-        DrawPrepared();
+        drawer.Draw();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
 
       // fill interior without overpainting any previous outlines
       {
-        SetupInterior(airspace, !fill_airspace);
+        const Color color = SetupInterior(airspace, !fill_airspace);
         const GLEnable<GL_BLEND> blend;
-        DrawPrepared();
+        if (fill_airspace)
+          drawer.Fill(color);
+        else
+          /* the stencil passes are drawn with the thick pen, which
+             the cache can't do; fill from the same screen polygon,
+             or the fill and the stencil would not line up */
+          drawer.Draw();
       }
 
       if (!fill_airspace) {
         // clear fill stencil (bit 0)
         ClearFillStencil();
-        DrawPrepared();
+        drawer.Draw();
         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
       }
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    if (const Pen *pen = SetupOutline(airspace))
+      drawer.Outline(*pen);
   }
 
 public:
@@ -157,17 +252,22 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  /**
+   * @return the selected pen or nullptr if no outline shall be drawn
+   */
+  const Pen *SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetType();
 
+    const Pen *pen;
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      pen = &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
+      pen = &look.classes[type].border_pen;
 
+    canvas.Select(*pen);
     canvas.SelectHollowBrush();
 
     // set bit 1 in stencil buffer, where an outline is drawn
@@ -175,11 +275,14 @@ private:
     glStencilMask(2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
-    return true;
+    return pen;
   }
 
-  void SetupInterior(const AbstractAirspace &airspace,
-                     bool check_fillstencil = false) {
+  /**
+   * @return the selected fill color
+   */
+  Color SetupInterior(const AbstractAirspace &airspace,
+                      bool check_fillstencil = false) {
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
 
     // restrict drawing area and don't paint over previously drawn outlines
@@ -189,8 +292,10 @@ private:
       glStencilFunc(GL_EQUAL, 0, 2);
     glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(90)));
+    const Color color = class_look.fill_color.WithAlpha(90);
+    canvas.Select(Brush(color));
     canvas.SelectNullPen();
+    return color;
   }
 
   void SetFillStencil() {
@@ -217,17 +322,23 @@ private:
 class AirspaceFillRenderer final
   : protected MapCanvas
 {
+  const WindowProjection &window_projection;
+  const AirspaceVertexCache &vertex_cache;
   const AirspaceLook &look;
   const AirspaceWarningCopy &warning_manager;
   const AirspaceRendererSettings &settings;
 
+  const Pen black_pen{1, COLOR_BLACK};
+
 public:
   AirspaceFillRenderer(Canvas &_canvas, const WindowProjection &_projection,
+                       const AirspaceVertexCache &_vertex_cache,
                        const AirspaceLook &_look,
                        const AirspaceWarningCopy &_warnings,
                        const AirspaceRendererSettings &_settings)
     :MapCanvas(_canvas, _projection,
                _projection.GetScreenBounds().Scale(1.1)),
+     window_projection(_projection), vertex_cache(_vertex_cache),
      look(_look), warning_manager(_warnings), settings(_settings)
   {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -249,18 +360,22 @@ private:
   }
 
   void VisitPolygon(const AirspacePolygon &airspace) {
-    if (!PreparePolygon(airspace.GetPoints()))
+    AirspacePolygonDrawer drawer(*this, window_projection, vertex_cache,
+                                 airspace);
+    if (!drawer.IsVisible())
       return;
 
-    if (!warning_manager.IsAcked(airspace) && SetupInterior(airspace)) {
-      // fill interior without overpainting any previous outlines
-      GLEnable<GL_BLEND> blend;
-      DrawPrepared();
+    if (!warning_manager.IsAcked(airspace)) {
+      if (const auto color = SetupInterior(airspace)) {
+        // fill interior without overpainting any previous outlines
+        GLEnable<GL_BLEND> blend;
+        drawer.Fill(*color);
+      }
     }
 
     // draw outline
-    if (SetupOutline(airspace))
-      DrawPrepared();
+    if (const Pen *pen = SetupOutline(airspace))
+      drawer.Outline(*pen);
   }
 
 public:
@@ -277,32 +392,42 @@ public:
   }
 
 private:
-  bool SetupOutline(const AbstractAirspace &airspace) {
+  /**
+   * @return the selected pen or nullptr if no outline shall be drawn
+   */
+  const Pen *SetupOutline(const AbstractAirspace &airspace) {
     AirspaceClass type = airspace.GetType();
 
+    const Pen *pen;
     if (settings.black_outline)
-      canvas.SelectBlackPen();
+      pen = &black_pen;
     else if (settings.classes[type].border_width == 0)
       // Don't draw outlines if border_width == 0
-      return false;
+      return nullptr;
     else
-      canvas.Select(look.classes[type].border_pen);
+      pen = &look.classes[type].border_pen;
 
+    canvas.Select(*pen);
     canvas.SelectHollowBrush();
 
-    return true;
+    return pen;
   }
 
-  bool SetupInterior(const AbstractAirspace &airspace) {
+  /**
+   * @return the selected fill color or std::nullopt if the interior
+   * shall not be filled
+   */
+  std::optional<Color> SetupInterior(const AbstractAirspace &airspace) {
     if (settings.fill_mode == AirspaceRendererSettings::FillMode::NONE)
-      return false;
+      return std::nullopt;
 
     const AirspaceClassLook &class_look = look.classes[airspace.GetType()];
 
-    canvas.Select(Brush(class_look.fill_color.WithAlpha(48)));
+    const Color color = class_look.fill_color.WithAlpha(48);
+    canvas.Select(Brush(color));
     canvas.SelectNullPen();
 
-    return true;
+    return color;
   }
 };
 
@@ -313,20 +438,24 @@ AirspaceRenderer::DrawInternal(Canvas &canvas,
                                const AirspaceWarningCopy &awc,
                                const AirspacePredicate &visible)
 {
+  vertex_cache.Update(*airspaces, projection);
+
   const auto range =
     airspaces->QueryWithinRange(projection.GetGeoScreenCenter(),
                                 projection.GetScreenDistanceMeters());
 
   if (settings.fill_mode == AirspaceRendererSettings::FillMode::ALL ||
       settings.fill_mode == AirspaceRendererSettings::FillMode::NONE) {
-    AirspaceFillRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceFillRenderer renderer(canvas, projection, vertex_cache,
+                                  look, awc, settings);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
         renderer.Visit(airspace);
     }
   } else {
-    AirspaceVisitorRenderer renderer(canvas, projection, look, awc, settings);
+    AirspaceVisitorRenderer renderer(canvas, projection, vertex_cache,
+                                     look, awc, settings);
     for (const auto &i : range) {
       const AbstractAirspace &airspace = i.GetAirspace();
       if (visible(airspace))
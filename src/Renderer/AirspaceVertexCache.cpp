@@ -0,0 +1,225 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifdef ENABLE_OPENGL
+
+#include "AirspaceVertexCache.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AbstractAirspace.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "Math/Point2D.hpp"
+#include "ui/canvas/Color.hpp"
+#include "ui/canvas/Pen.hpp"
+#include "ui/canvas/opengl/Buffer.hpp"
+#include "ui/canvas/opengl/VertexPointer.hpp"
+#include "ui/canvas/opengl/Triangulate.hpp"
+#include "ui/canvas/opengl/Geo.hpp"
+#include "ui/canvas/opengl/Program.hpp"
+#include "ui/canvas/opengl/Shaders.hpp"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <vector>
+
+/**
+ * Rebuild the buffers when the map center is farther than this
+ * [m] from the reference point, to limit the loss of precision of
+ * the single-precision vertex coordinates.
+ */
+static constexpr double ZONE_RADIUS = 500000;
+
+AirspaceVertexCache::AirspaceVertexCache() noexcept
+{
+  AddSurfaceListener(*this);
+}
+
+AirspaceVertexCache::~AirspaceVertexCache() noexcept
+{
+  RemoveSurfaceListener(*this);
+}
+
+void
+AirspaceVertexCache::Invalidate() noexcept
+{
+  airspaces = nullptr;
+  reference = GeoPoint::Invalid();
+  items.clear();
+  vertex_buffer.reset();
+  index_buffer.reset();
+}
+
+void
+AirspaceVertexCache::Update(const Airspaces &_airspaces,
+                            const WindowProjection &projection) noexcept
+{
+  const GeoPoint center = projection.GetGeoScreenCenter();
+
+  if (&_airspaces == airspaces && _airspaces.GetSerial() == serial &&
+      reference.IsValid() && reference.DistanceS(center) < ZONE_RADIUS)
+    /* cache is clean */
+    return;
+
+  airspaces = &_airspaces;
+  serial = _airspaces.GetSerial();
+  reference = center;
+  items.clear();
+
+  std::vector<FloatPoint2D> vertices;
+  std::vector<GLushort> indices;
+
+  for (const auto &i : _airspaces.QueryAll()) {
+    const AbstractAirspace &airspace = i.GetAirspace();
+    if (airspace.GetShape() != AbstractAirspace::Shape::POLYGON)
+      continue;
+
+    const SearchPointVector &points = airspace.GetPoints();
+    const unsigned n = points.size();
+    if (n < 3 || n > 0xffff)
+      /* GLushort indices cannot address this polygon */
+      continue;
+
+    Item item;
+    item.vertex_offset = vertices.size();
+    item.vertex_count = n;
+
+    for (const auto &p : points) {
+      const GeoPoint delta = p.GetLocation() - reference;
+      vertices.emplace_back(float(delta.longitude.Native()),
+                            float(delta.latitude.Native()));
+    }
+
+    /* the flat projection differs from the screen projection only by
+       an affine transformation, therefore the triangulation remains
+       valid as long as the vertices do not change */
+    item.index_offset = indices.size();
+    indices.resize(item.index_offset + 3 * (n - 2));
+    item.index_count = PolygonToTriangles(vertices.data() + item.vertex_offset,
+                                          n,
+                                          indices.data() + item.index_offset,
+                                          0);
+    indices.resize(item.index_offset + item.index_count);
+
+    items.emplace(&airspace, item);
+  }
+
+  if (!vertex_buffer)
+    vertex_buffer = std::make_unique<GLArrayBuffer>();
+  vertex_buffer->Load(vertices.size() * sizeof(vertices.front()),
+                      vertices.data());
+
+  if (!index_buffer)
+    index_buffer = std::make_unique<GLElementArrayBuffer>();
+  index_buffer->Load(indices.size() * sizeof(indices.front()),
+                     indices.data());
+}
+
+const AirspaceVertexCache::Item *
+AirspaceVertexCache::Find(const AbstractAirspace &airspace) const noexcept
+{
+  auto i = items.find(&airspace);
+  return i != items.end()
+    ? &i->second
+    : nullptr;
+}
+
+inline void
+AirspaceVertexCache::Draw(const WindowProjection &projection,
+                          const Item &item, bool fill) const noexcept
+{
+  assert(vertex_buffer);
+  assert(index_buffer);
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(ToGLM(projection, reference)));
+
+  vertex_buffer->Bind();
+
+  const FloatPoint2D *const vertices = nullptr;
+  ScopeVertexPointer vp(vertices + item.vertex_offset);
+
+  if (fill) {
+    index_buffer->Bind();
+
+    const GLushort *const indices = nullptr;
+    glDrawElements(GL_TRIANGLES, item.index_count, GL_UNSIGNED_SHORT,
+                   indices + item.index_offset);
+
+    index_buffer->Unbind();
+  } else
+    glDrawArrays(GL_LINE_LOOP, 0, item.vertex_count);
+
+  vertex_buffer->Unbind();
+
+  glUniformMatrix4fv(OpenGL::solid_modelview, 1, GL_FALSE,
+                     glm::value_ptr(glm::mat4(1)));
+}
+
+bool
+AirspaceVertexCache::DrawFill(const WindowProjection &projection,
+                              const Item &item, Color color) const noexcept
+{
+  if (item.index_count == 0)
+    return false;
+
+  OpenGL::solid_shader->Use();
+  color.Bind();
+
+  Draw(projection, item, true);
+  return true;
+}
+
+bool
+AirspaceVertexCache::CanDrawOutline(const Pen &pen) noexcept
+{
+  /* thick lines are converted to triangles in screen coordinates by
+     Canvas::DrawPolygon(), which we can't cache */
+  return pen.GetWidth() <= 2;
+}
+
+void
+AirspaceVertexCache::DrawOutline(const WindowProjection &projection,
+                                 const Item &item,
+                                 const Pen &pen) const noexcept
+{
+  assert(CanDrawOutline(pen));
+
+  OpenGL::solid_shader->Use();
+  pen.Bind();
+
+  Draw(projection, item, false);
+
+  pen.Unbind();
+}
+
+void
+AirspaceVertexCache::SurfaceCreated()
+{
+}
+
+void
+AirspaceVertexCache::SurfaceDestroyed()
+{
+  Invalidate();
+}
+
+#endif /* ENABLE_OPENGL */
@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_AIRSPACE_VERTEX_CACHE_HPP
+#define XCSOAR_AIRSPACE_VERTEX_CACHE_HPP
+
+#include "Geo/GeoPoint.hpp"
+#include "util/Serial.hpp"
+#include "ui/canvas/opengl/Surface.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+class Airspaces;
+class AbstractAirspace;
+class WindowProjection;
+class Color;
+class Pen;
+class GLArrayBuffer;
+class GLElementArrayBuffer;
+
+/**
+ * Keeps the vertices and the triangulated interiors of all airspace
+ * polygons in OpenGL buffer objects.  The vertices are stored in a
+ * flat projection relative to a reference point, and the shader
+ * transforms them to screen coordinates, just like
+ * #TopographyFileRenderer does.  This avoids projecting and
+ * triangulating each polygon on every frame; the buffers are only
+ * rebuilt when the airspace database gets modified or when the map
+ * moves far away from the reference point.
+ */
+class AirspaceVertexCache final : GLSurfaceListener {
+public:
+  struct Item {
+    /**
+     * The position of the first vertex in the vertex buffer and the
+     * number of vertices.
+     */
+    unsigned vertex_offset, vertex_count;
+
+    /**
+     * The position of the first triangle index in the index buffer
+     * and the number of indices.  The latter is zero if the polygon
+     * could not be triangulated.
+     */
+    unsigned index_offset, index_count;
+  };
+
+private:
+  const Airspaces *airspaces = nullptr;
+  Serial serial;
+
+  /**
+   * The origin of the flat vertex coordinates.
+   */
+  GeoPoint reference = GeoPoint::Invalid();
+
+  std::unique_ptr<GLArrayBuffer> vertex_buffer;
+  std::unique_ptr<GLElementArrayBuffer> index_buffer;
+
+  std::unordered_map<const AbstractAirspace *, Item> items;
+
+public:
+  AirspaceVertexCache() noexcept;
+  ~AirspaceVertexCache() noexcept;
+
+  AirspaceVertexCache(const AirspaceVertexCache &) = delete;
+  AirspaceVertexCache &operator=(const AirspaceVertexCache &) = delete;
+
+  /**
+   * Discard all buffers, e.g. after the OpenGL surface has been
+   * lost.
+   */
+  void Invalidate() noexcept;
+
+  /**
+   * Rebuild the buffers if the airspace database has been modified
+   * or if the map has moved out of the current projection zone.
+   */
+  void Update(const Airspaces &airspaces,
+              const WindowProjection &projection) noexcept;
+
+  /**
+   * Look up the cached geometry of the given polygon airspace.
+   * Returns nullptr if it is not in the cache.
+   */
+  [[gnu::pure]]
+  const Item *Find(const AbstractAirspace &airspace) const noexcept;
+
+  /**
+   * Fill the interior of the polygon.  Returns false if no
+   * triangulation is available; the caller must then fall back to
+   * Canvas::DrawPolygon().
+   */
+  bool DrawFill(const WindowProjection &projection, const Item &item,
+                Color color) const noexcept;
+
+  /**
+   * Draw the outline of the polygon as a line loop.  This is only
+   * suitable for thin pens, see CanDrawOutline().
+   */
+  void DrawOutline(const WindowProjection &projection, const Item &item,
+                   const Pen &pen) const noexcept;
+
+  [[gnu::pure]]
+  static bool CanDrawOutline(const Pen &pen) noexcept;
+
+private:
+  void Draw(const WindowProjection &projection, const Item &item,
+            bool fill) const noexcept;
+
+  /* virtual methods from class GLSurfaceListener */
+  void SurfaceCreated() override;
+  void SurfaceDestroyed() override;
+};
+
+#endif
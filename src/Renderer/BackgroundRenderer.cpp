@@ -66,26 +66,29 @@ BackgroundRenderer::Draw(Canvas& canvas,
   }
 }
 
-void
-BackgroundRenderer::SetShadingAngle(const WindowProjection& projection,
-                                    const TerrainRendererSettings &settings,
-                                    const DerivedInfo &calculated)
+Angle
+BackgroundRenderer::CalcShadingAngle(const TerrainRendererSettings &settings,
+                                     const DerivedInfo &calculated)
 {
-  Angle angle;
-
   if (settings.slope_shading == SlopeShading::WIND &&
       calculated.wind_available &&
       calculated.wind.norm >= 0.5)
-    angle = calculated.wind.bearing;
+    return calculated.wind.bearing;
 
   else if (settings.slope_shading == SlopeShading::SUN &&
            calculated.sun_data_available)
-    angle = calculated.sun_azimuth;
+    return calculated.sun_azimuth;
 
   else
-    angle = DEFAULT_SHADING_ANGLE;
+    return DEFAULT_SHADING_ANGLE;
+}
 
-  SetShadingAngle(projection, angle);
+void
+BackgroundRenderer::SetShadingAngle(const WindowProjection& projection,
+                                    const TerrainRendererSettings &settings,
+                                    const DerivedInfo &calculated)
+{
+  SetShadingAngle(projection, CalcShadingAngle(settings, calculated));
 }
 
 void
@@ -64,6 +64,14 @@ public:
                        const DerivedInfo &calculated);
   void SetTerrain(const RasterTerrain *terrain);
 
+  /**
+   * Determine the slope shading angle (relative to north) according
+   * to the settings.
+   */
+  [[gnu::pure]]
+  static Angle CalcShadingAngle(const TerrainRendererSettings &settings,
+                                const DerivedInfo &calculated);
+
 private:
   void SetShadingAngle(const WindowProjection& proj, Angle angle);
 };
@@ -36,6 +36,8 @@ Copyright_License {
 #include "TaskLegRenderer.hpp"
 #include "GradientRenderer.hpp"
 
+#include <optional>
+
 void
 BarographCaption(TCHAR *sTmp, const FlightStatistics &fs)
 {
@@ -70,6 +72,12 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
                      const DerivedInfo &derived_info,
                      const ProtectedTaskManager *_task)
 {
+  /* lock the task before the statistics; the calculation thread
+     holds the task while updating FlightStatistics */
+  std::optional<ProtectedTaskManager::Lease> task;
+  if (_task != nullptr)
+    task.emplace(*_task);
+
   std::lock_guard<Mutex> lock(fs.mutex);
   ChartRenderer chart(chart_look, canvas, rc, false);
   chart.Begin();
@@ -81,10 +89,9 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
   chart.ScaleYFromData(fs.altitude);
   chart.ScaleYFromValue(0);
 
-  if (_task != nullptr) {
-    ProtectedTaskManager::Lease task(*_task);
+  if (task) {
     canvas.SelectHollowBrush();
-    RenderTaskLegs(chart, task, nmea_info, derived_info, -1);
+    RenderTaskLegs(chart, *task, nmea_info, derived_info, -1);
   }
 
   canvas.SelectNullPen();
@@ -100,7 +107,7 @@ RenderBarographSpark(Canvas &canvas, const PixelRect rc,
       chart.GetCanvas().SelectWhiteBrush();
     else
       chart.GetCanvas().SelectBlackBrush();
-    const auto &s = fs.altitude.GetSlots()[fs.altitude.GetCount()-1];
+    const auto &s = fs.altitude.GetSlots().back();
     chart.DrawDot(s.x, s.y, Layout::Scale(2));
   }
 
@@ -116,6 +123,13 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
                 const DerivedInfo &derived_info,
                 const ProtectedTaskManager *_task)
 {
+  /* lock the task before the statistics; the calculation thread
+     holds the task while updating FlightStatistics */
+  std::optional<ProtectedTaskManager::Lease> task;
+  if (_task != nullptr)
+    task.emplace(*_task);
+
+  std::lock_guard<Mutex> lock(fs.mutex);
   ChartRenderer chart(chart_look, canvas, rc);
   chart.SetXLabel(_T("t"), _T("hr"));
   chart.SetYLabel(_T("h"), Units::GetAltitudeName());
@@ -141,10 +155,8 @@ RenderBarograph(Canvas &canvas, const PixelRect rc,
     chart.ScaleYFromValue(fs.altitude_ceiling.GetMaxY());
   }
 
-  if (_task != nullptr) {
-    ProtectedTaskManager::Lease task(*_task);
-    RenderTaskLegs(chart, task, nmea_info, derived_info, 0.33);
-  }
+  if (task)
+    RenderTaskLegs(chart, *task, nmea_info, derived_info, 0.33);
 
   canvas.SelectNullPen();
   canvas.Select(cross_section_look.terrain_brush);
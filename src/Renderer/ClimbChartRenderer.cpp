@@ -67,6 +67,7 @@ RenderClimbChart(Canvas &canvas, const PixelRect rc,
                  const DerivedInfo &derived_info,
                  const TaskManager &task)
 {
+  std::lock_guard<Mutex> lock(fs.mutex);
   ChartRenderer chart(chart_look, canvas, rc);
   chart.SetXLabel(_T("t"), _T("hr"));
   chart.SetYLabel(_T("w"), Units::GetVerticalSpeedName());
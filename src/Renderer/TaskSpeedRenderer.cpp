@@ -39,6 +39,7 @@ TaskSpeedCaption(TCHAR *sTmp,
                  const FlightStatistics &fs,
                  const GlidePolar &glide_polar)
 {
+  std::lock_guard<Mutex> lock(fs.mutex);
   if (!glide_polar.IsValid() || fs.task_speed.IsEmpty()) {
     *sTmp = _T('\0');
     return;
@@ -63,6 +64,7 @@ RenderSpeed(Canvas &canvas, const PixelRect rc,
             const TaskManager &task,
             const GlidePolar &glide_polar)
 {
+  std::lock_guard<Mutex> lock(fs.mutex);
   ChartRenderer chart(chart_look, canvas, rc);
   chart.SetXLabel(_T("t"), _T("hr"));
   chart.SetYLabel(_T("V"), Units::GetTaskSpeedName());
@@ -0,0 +1,438 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef ENABLE_OPENGL
+
+#include "TerrainTileCache.hpp"
+#include "Terrain/TerrainRenderer.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "ui/canvas/Canvas.hpp"
+
+#include <algorithm>
+
+#include <limits.h>
+#include <math.h>
+
+/**
+ * A linear approximation of the mapping from screen coordinates to
+ * the tile plane.
+ */
+struct TerrainTileCache::PlaneMapping {
+  /**
+   * The plane coordinates of the screen's top left corner.
+   */
+  double origin_x, origin_y;
+
+  /**
+   * The plane vectors of one screen pixel to the right and one
+   * screen pixel down.
+   */
+  double u_x, u_y, v_x, v_y;
+
+  bool identity;
+
+  double ToPlaneX(double x, double y) const noexcept {
+    return origin_x + x * u_x + y * v_x;
+  }
+
+  double ToPlaneY(double x, double y) const noexcept {
+    return origin_y + x * u_y + y * v_y;
+  }
+};
+
+TerrainTileCache::TerrainTileCache() noexcept = default;
+TerrainTileCache::~TerrainTileCache() noexcept = default;
+
+void
+TerrainTileCache::SetTerrain(const RasterTerrain *_terrain) noexcept
+{
+  terrain = _terrain;
+  renderer.reset();
+  Flush();
+}
+
+void
+TerrainTileCache::Flush() noexcept
+{
+  tiles.clear();
+  valid = false;
+  has_range = false;
+  prefetch_stalled = false;
+}
+
+void
+TerrainTileCache::Reset(const WindowProjection &projection,
+                        const TerrainRendererSettings &_settings,
+                        Angle _shading_angle) noexcept
+{
+  tiles.clear();
+
+  anchor.SetGeoLocation(projection.GetGeoScreenCenter());
+  anchor.SetScale(projection.GetScale());
+  anchor.SetScreenOrigin(0, 0);
+  anchor.SetScreenAngle(Angle::Zero());
+
+  settings = _settings;
+  shading_angle = _shading_angle;
+  valid = true;
+}
+
+bool
+TerrainTileCache::CalcMapping(const WindowProjection &projection,
+                              PlaneMapping &m) const noexcept
+{
+  const PixelSize size = projection.GetScreenSize();
+  const int width = size.width, height = size.height;
+
+  const auto o = anchor.GeoToScreen(projection.ScreenToGeo({0, 0}));
+  const auto a = anchor.GeoToScreen(projection.ScreenToGeo({width, 0}));
+  const auto b = anchor.GeoToScreen(projection.ScreenToGeo({0, height}));
+  const auto c = anchor.GeoToScreen(projection.ScreenToGeo({width, height}));
+
+  m.origin_x = o.x;
+  m.origin_y = o.y;
+  m.u_x = double(a.x - o.x) / width;
+  m.u_y = double(a.y - o.y) / width;
+  m.v_x = double(b.x - o.x) / height;
+  m.v_y = double(b.y - o.y) / height;
+
+  m.identity = std::abs(a.x - o.x - width) <= 1 && std::abs(a.y - o.y) <= 1 &&
+    std::abs(b.x - o.x) <= 1 && std::abs(b.y - o.y - height) <= 1;
+
+  /* the plane is not a perfect affine image of the screen (the
+     longitude scale depends on the latitude); check the fourth
+     corner to see whether the error is still acceptable */
+  return std::abs(m.ToPlaneX(width, height) - c.x) <= 2 &&
+    std::abs(m.ToPlaneY(width, height) - c.y) <= 2;
+}
+
+TerrainTileCache::Tile *
+TerrainTileCache::Find(int x, int y) noexcept
+{
+  for (auto &tile : tiles)
+    if (tile.x == x && tile.y == y)
+      return &tile;
+
+  return nullptr;
+}
+
+bool
+TerrainTileCache::IsUpToDate(const Tile *tile) const noexcept
+{
+  return tile != nullptr && tile->terrain_serial == terrain->GetSerial();
+}
+
+bool
+TerrainTileCache::IsWanted(int x, int y) const noexcept
+{
+  return has_range &&
+    x >= min_x - 2 && x <= max_x + 2 &&
+    y >= min_y - 2 && y <= max_y + 2;
+}
+
+TerrainTileCache::Tile *
+TerrainTileCache::Obtain(const Canvas &reference, int x, int y,
+                         bool prefetch) noexcept
+{
+  Tile *tile = Find(x, y);
+  if (tile != nullptr)
+    return tile;
+
+  if (tiles.size() < MAX_TILES) {
+    tile = &tiles.emplace_back(x, y);
+    tile->canvas.Create(reference, {TILE_SIZE + 2 * MARGIN,
+                                    TILE_SIZE + 2 * MARGIN});
+    return tile;
+  }
+
+  /* evict the least recently used tile; while prefetching, never
+     evict a tile which may become visible soon, or the prefetcher
+     would chase its own tail */
+  Tile *victim = nullptr;
+  for (auto &i : tiles)
+    if (i.last_used < frame &&
+        (!prefetch || !IsWanted(i.x, i.y)) &&
+        (victim == nullptr || i.last_used < victim->last_used))
+      victim = &i;
+
+  if (victim != nullptr) {
+    victim->x = x;
+    victim->y = y;
+  }
+
+  return victim;
+}
+
+void
+TerrainTileCache::Render(Tile &tile) noexcept
+{
+  if (!renderer)
+    renderer.reset(new TerrainRenderer(*terrain));
+
+  WindowProjection projection;
+  projection.SetGeoLocation(anchor.GetGeoLocation());
+  projection.SetScale(anchor.GetScale());
+  projection.SetScreenAngle(Angle::Zero());
+  projection.SetScreenOrigin(-tile.x * TILE_SIZE + MARGIN,
+                             -tile.y * TILE_SIZE + MARGIN);
+  projection.SetScreenSize({TILE_SIZE + 2 * MARGIN, TILE_SIZE + 2 * MARGIN});
+  projection.UpdateScreenBounds();
+
+  tile.canvas.ClearWhite();
+
+  renderer->SetSettings(settings);
+  if (renderer->Generate(projection, shading_angle))
+    renderer->Draw(tile.canvas, projection);
+
+  tile.terrain_serial = terrain->GetSerial();
+  tile.last_used = frame;
+}
+
+bool
+TerrainTileCache::Draw(Canvas &canvas, const WindowProjection &projection,
+                       const TerrainRendererSettings &_settings,
+                       Angle _shading_angle,
+                       const Angle *direction) noexcept
+{
+  ++frame;
+  has_range = false;
+  prefetch_stalled = false;
+
+  if (!_settings.enable || terrain == nullptr)
+    return false;
+
+  if (!valid || projection.GetScale() != anchor.GetScale() ||
+      !(_settings == settings) ||
+      !_shading_angle.CompareRoughly(shading_angle))
+    Reset(projection, _settings, _shading_angle);
+
+  PlaneMapping m;
+  if (!CalcMapping(projection, m)) {
+    /* too far away from the anchor: start a new plane */
+    Reset(projection, _settings, _shading_angle);
+    if (!CalcMapping(projection, m))
+      return false;
+  }
+
+#ifndef USE_MEMORY_CANVAS
+  /* GDI cannot compose rotated tiles */
+  if (!m.identity)
+    return false;
+#endif
+
+  /* determine which tiles are visible */
+
+  const PixelSize size = projection.GetScreenSize();
+  const double corners[4][2] = {
+    { 0, 0 },
+    { double(size.width), 0 },
+    { 0, double(size.height) },
+    { double(size.width), double(size.height) },
+  };
+
+  double left = m.origin_x, right = m.origin_x;
+  double top = m.origin_y, bottom = m.origin_y;
+  for (const auto &i : corners) {
+    const double x = m.ToPlaneX(i[0], i[1]), y = m.ToPlaneY(i[0], i[1]);
+    left = std::min(left, x);
+    right = std::max(right, x);
+    top = std::min(top, y);
+    bottom = std::max(bottom, y);
+  }
+
+  min_x = (int)floor(left / TILE_SIZE);
+  min_y = (int)floor(top / TILE_SIZE);
+  max_x = (int)floor((right - 1) / TILE_SIZE);
+  max_y = (int)floor((bottom - 1) / TILE_SIZE);
+  has_range = true;
+
+  if (direction != nullptr) {
+    const auto sc = direction->SinCos();
+    ahead_x = sc.first;
+    ahead_y = -sc.second;
+  } else
+    ahead_x = ahead_y = 0;
+
+  unsigned n_missing = 0;
+  for (int y = min_y; y <= max_y; ++y)
+    for (int x = min_x; x <= max_x; ++x)
+      if (!IsUpToDate(Find(x, y)))
+        ++n_missing;
+
+  if (n_missing > MAX_MISSING)
+    /* leave the big job to the DrawThread's idle time (see
+       Prefetch()); it is cheaper to render just the screen this
+       time */
+    return false;
+
+  /* render the few missing tiles now, and mark all visible tiles as
+     used, to protect them from eviction */
+
+  for (int y = min_y; y <= max_y; ++y) {
+    for (int x = min_x; x <= max_x; ++x) {
+      Tile *tile = Find(x, y);
+      if (IsUpToDate(tile)) {
+        tile->last_used = frame;
+        continue;
+      }
+
+      tile = Obtain(canvas, x, y, false);
+      if (tile == nullptr)
+        return false;
+
+      Render(*tile);
+    }
+  }
+
+  /* compose */
+
+  canvas.ClearWhite();
+
+  for (int y = min_y; y <= max_y; ++y) {
+    for (int x = min_x; x <= max_x; ++x) {
+      const Tile &tile = *Find(x, y);
+      const int tile_left = x * TILE_SIZE, tile_top = y * TILE_SIZE;
+
+      if (m.identity) {
+        canvas.Copy({tile_left - (int)m.origin_x, tile_top - (int)m.origin_y},
+                    {TILE_SIZE, TILE_SIZE},
+                    tile.canvas, {MARGIN, MARGIN});
+        continue;
+      }
+
+#ifdef USE_MEMORY_CANVAS
+      /* find the screen rectangle covered by this (rotated) tile */
+
+      const double det = m.u_x * m.v_y - m.u_y * m.v_x;
+      PixelRect rc{INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+      for (int j = 0; j < 4; ++j) {
+        const double dx = tile_left + (j & 1) * TILE_SIZE - m.origin_x;
+        const double dy = tile_top + (j >> 1) * TILE_SIZE - m.origin_y;
+        const double sx = (m.v_y * dx - m.v_x * dy) / det;
+        const double sy = (m.u_x * dy - m.u_y * dx) / det;
+        rc.left = std::min(rc.left, (int)floor(sx) - 1);
+        rc.top = std::min(rc.top, (int)floor(sy) - 1);
+        rc.right = std::max(rc.right, (int)ceil(sx) + 1);
+        rc.bottom = std::max(rc.bottom, (int)ceil(sy) + 1);
+      }
+
+      /* the tile canvas position of the centre of the top left
+         pixel */
+      const double src_x = m.ToPlaneX(rc.left + 0.5, rc.top + 0.5)
+        - tile_left + MARGIN;
+      const double src_y = m.ToPlaneY(rc.left + 0.5, rc.top + 0.5)
+        - tile_top + MARGIN;
+
+      canvas.CopyTransformed(rc, tile.canvas,
+                             {MARGIN, MARGIN,
+                              MARGIN + TILE_SIZE, MARGIN + TILE_SIZE},
+                             {(int)lround(src_x * 65536),
+                              (int)lround(src_y * 65536)},
+                             {(int)lround(m.u_x * 65536),
+                              (int)lround(m.u_y * 65536)},
+                             {(int)lround(m.v_x * 65536),
+                              (int)lround(m.v_y * 65536)});
+#endif
+    }
+  }
+
+  return true;
+}
+
+bool
+TerrainTileCache::FindPrefetchTile(int &result_x, int &result_y) const noexcept
+{
+  if (!has_range || !valid || terrain == nullptr)
+    return false;
+
+  if (tiles.size() >= MAX_TILES &&
+      std::none_of(tiles.begin(), tiles.end(), [this](const Tile &tile){
+        return !IsWanted(tile.x, tile.y);
+      }))
+    /* no room */
+    return false;
+
+  const double center_x = (min_x + max_x + 1) * 0.5;
+  const double center_y = (min_y + max_y + 1) * 0.5;
+
+  bool found = false;
+  double best_score = 0;
+
+  for (int y = min_y - 2; y <= max_y + 2; ++y) {
+    for (int x = min_x - 2; x <= max_x + 2; ++x) {
+      /* distance from the visible range in tiles (0 = visible) */
+      const int ring = std::max({min_x - x, x - max_x,
+                                 min_y - y, y - max_y, 0});
+
+      /* how well does this tile line up with the direction of
+         travel? (-1 .. 1) */
+      const double dx = x + 0.5 - center_x, dy = y + 0.5 - center_y;
+      const double distance = hypot(dx, dy);
+      const double dot = distance > 0
+        ? (dx * ahead_x + dy * ahead_y) / distance
+        : 0;
+
+      /* the second ring only ahead of the aircraft */
+      if (ring > 1 && dot <= 0)
+        continue;
+
+      const double score = ring - 0.5 * dot;
+      if (found && score >= best_score)
+        continue;
+
+      if (IsUpToDate(Find(x, y)))
+        continue;
+
+      found = true;
+      best_score = score;
+      result_x = x;
+      result_y = y;
+    }
+  }
+
+  return found;
+}
+
+bool
+TerrainTileCache::Prefetch(const Canvas &reference) noexcept
+{
+  int x, y;
+  if (!FindPrefetchTile(x, y))
+    return false;
+
+  if (prefetch_stalled)
+    return false;
+
+  Tile *tile = Obtain(reference, x, y, true);
+  if (tile == nullptr) {
+    /* all slots are in use; don't try again before the next frame */
+    prefetch_stalled = true;
+    return false;
+  }
+
+  Render(*tile);
+  return true;
+}
+
+#endif
@@ -0,0 +1,234 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_TILE_CACHE_HPP
+#define XCSOAR_TERRAIN_TILE_CACHE_HPP
+
+#ifndef ENABLE_OPENGL
+
+#include "Projection/Projection.hpp"
+#include "Terrain/TerrainSettings.hpp"
+#include "ui/canvas/BufferCanvas.hpp"
+#include "Math/Angle.hpp"
+#include "util/Serial.hpp"
+
+#include <list>
+#include <memory>
+
+class Canvas;
+class WindowProjection;
+class RasterTerrain;
+class TerrainRenderer;
+
+/**
+ * Caches the rendered terrain in square tiles, so panning and
+ * rotating the map does not need to render the terrain again.
+ *
+ * The tiles are aligned to a north-up "plane" with the current map
+ * scale, anchored at a geographic location; the map is composed from
+ * tiles by copying (north-up) or by a nearest-neighbour rotation
+ * (track-up, memory canvas only).  Changing the scale, the terrain
+ * settings or moving too far from the anchor discards all tiles.
+ *
+ * Tiles around the visible area (with preference in the direction
+ * of travel) can be rendered ahead of time with Prefetch(), which is
+ * meant to be called by the DrawThread while it is idle.
+ *
+ * This class is not thread-safe; it must only be used by the
+ * DrawThread.
+ */
+class TerrainTileCache {
+  static constexpr int TILE_SIZE = 256;
+
+  /**
+   * Each tile is rendered with this many additional pixels on each
+   * side, to avoid seams caused by the terrain renderer's edge
+   * handling.
+   */
+  static constexpr int MARGIN = 8;
+
+  static constexpr unsigned MAX_TILES = 48;
+
+  /**
+   * If more tiles than this are missing from the visible area, the
+   * caller shall render the terrain directly, and the tiles are left
+   * to Prefetch().
+   */
+  static constexpr unsigned MAX_MISSING = 2;
+
+  struct PlaneMapping;
+
+  struct Tile {
+    int x, y;
+
+    Serial terrain_serial;
+
+    /**
+     * The value of #frame when this tile was last used (or
+     * rendered).
+     */
+    unsigned last_used;
+
+    BufferCanvas canvas;
+
+    Tile(int _x, int _y) noexcept:x(_x), y(_y) {}
+  };
+
+  const RasterTerrain *terrain = nullptr;
+
+  std::unique_ptr<TerrainRenderer> renderer;
+
+  /**
+   * The north-up projection which defines the tile grid: tile (x,y)
+   * covers the pixels (x*TILE_SIZE, y*TILE_SIZE) to
+   * ((x+1)*TILE_SIZE, (y+1)*TILE_SIZE) of this projection.
+   */
+  Projection anchor;
+
+  bool valid = false;
+
+  TerrainRendererSettings settings;
+
+  Angle shading_angle;
+
+  std::list<Tile> tiles;
+
+  unsigned frame = 0;
+
+  /**
+   * The range of tiles which was visible in the last frame.  Only
+   * valid if #has_range is set.
+   */
+  int min_x, min_y, max_x, max_y;
+
+  bool has_range = false;
+
+  /**
+   * The direction of travel within the plane (unit vector), or zero.
+   */
+  double ahead_x = 0, ahead_y = 0;
+
+  /**
+   * Set by Prefetch() when it found a tile to render but no free
+   * slot; all tiles were used in the current frame or may become
+   * visible soon.  Prefetching is suspended until the next Draw(),
+   * which may free slots.
+   */
+  bool prefetch_stalled = false;
+
+public:
+  TerrainTileCache() noexcept;
+  ~TerrainTileCache() noexcept;
+
+  TerrainTileCache(const TerrainTileCache &) = delete;
+  TerrainTileCache &operator=(const TerrainTileCache &) = delete;
+
+  void SetTerrain(const RasterTerrain *_terrain) noexcept;
+
+  /**
+   * Discard all tiles.
+   */
+  void Flush() noexcept;
+
+  /**
+   * Compose the terrain layer from tiles.
+   *
+   * @param shading_angle the slope shading angle relative to north
+   * @param direction the direction of travel (for Prefetch()), or
+   * nullptr if unknown
+   * @return false if the cache cannot be used for this frame; the
+   * caller shall then render the terrain directly
+   */
+  bool Draw(Canvas &canvas, const WindowProjection &projection,
+            const TerrainRendererSettings &settings,
+            Angle shading_angle, const Angle *direction) noexcept;
+
+  /**
+   * Is there a tile which should be rendered by Prefetch()?
+   */
+  [[gnu::pure]]
+  bool HasPrefetchWork() const noexcept {
+    int x, y;
+    return !prefetch_stalled && FindPrefetchTile(x, y);
+  }
+
+  /**
+   * Render one tile which is likely to become visible soon.
+   *
+   * @param reference a canvas which is compatible with the screen
+   * @return false if there was nothing to do or if no tile slot was
+   * available (until the next Draw() call)
+   */
+  bool Prefetch(const Canvas &reference) noexcept;
+
+private:
+  void Reset(const WindowProjection &projection,
+             const TerrainRendererSettings &_settings,
+             Angle _shading_angle) noexcept;
+
+  /**
+   * Calculate the mapping from the screen to the tile plane.
+   *
+   * @return false if the error of the linear approximation is too
+   * large
+   */
+  bool CalcMapping(const WindowProjection &projection,
+                   PlaneMapping &m) const noexcept;
+
+  [[gnu::pure]]
+  Tile *Find(int x, int y) noexcept;
+
+  [[gnu::pure]]
+  const Tile *Find(int x, int y) const noexcept {
+    return const_cast<TerrainTileCache *>(this)->Find(x, y);
+  }
+
+  [[gnu::pure]]
+  bool IsUpToDate(const Tile *tile) const noexcept;
+
+  /**
+   * May the specified tile become visible soon?
+   */
+  [[gnu::pure]]
+  bool IsWanted(int x, int y) const noexcept;
+
+  /**
+   * Find a tile slot for the specified position: reuse an existing
+   * one, allocate a new one or evict the least recently used tile
+   * which was not visible in the current frame.
+   *
+   * @param prefetch if true, then tiles which may become visible
+   * soon are not evicted
+   * @return nullptr if the cache is full
+   */
+  Tile *Obtain(const Canvas &reference, int x, int y,
+               bool prefetch) noexcept;
+
+  void Render(Tile &tile) noexcept;
+
+  bool FindPrefetchTile(int &x, int &y) const noexcept;
+};
+
+#endif
+
+#endif
@@ -43,6 +43,7 @@ RenderVarioHistogram(Canvas &canvas, const PixelRect rc,
                      const FlightStatistics &fs,
                      const GlidePolar &glide_polar)
 {
+  std::lock_guard<Mutex> lock(fs.mutex);
   ChartRenderer chart(chart_look, canvas, rc);
   chart.SetYLabel(_T("w"), Units::GetVerticalSpeedName());
   chart.Begin();
@@ -57,6 +57,7 @@ RenderWindChart(Canvas &canvas, const PixelRect rc,
                 const NMEAInfo &nmea_info,
                 const WindStore &wind_store)
 {
+  std::lock_guard<Mutex> lock(fs.mutex);
   unsigned numsteps = 10;
   bool found = true;
 
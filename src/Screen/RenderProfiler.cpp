@@ -0,0 +1,246 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RenderProfiler.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "LogFile.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "ui/opengl/System.hpp"
+#endif
+
+#include <algorithm>
+
+#include <cassert>
+#include <string.h>
+
+/**
+ * The weight of the newest frame in the moving averages.
+ */
+static constexpr float AVERAGE_WEIGHT = 0.1f;
+
+static float
+ToMilliseconds(std::chrono::steady_clock::duration d) noexcept
+{
+  return std::chrono::duration<float, std::milli>(d).count();
+}
+
+/**
+ * Wait until all pending drawing operations are complete, so the
+ * GPU time is accounted to the stage which has caused it.
+ */
+static void
+FlushScreen() noexcept
+{
+#ifdef ENABLE_OPENGL
+  glFinish();
+#endif
+}
+
+RenderProfiler::RenderProfiler(const char *_frame_name) noexcept
+  :frame_name(_frame_name), epoch(Clock::now()),
+#ifdef STOP_WATCH
+   enabled(true)
+#else
+   enabled(false)
+#endif
+{
+}
+
+void
+RenderProfiler::BeginFrame() noexcept
+{
+  if (depth++ > 0)
+    return;
+
+  active = IsEnabled();
+  if (!active)
+    return;
+
+  FlushScreen();
+  markers.clear();
+  frame_start = Clock::now();
+}
+
+void
+RenderProfiler::DoMark(const char *name) noexcept
+{
+  FlushScreen();
+  markers.append({name, Clock::now()});
+}
+
+void
+RenderProfiler::EndFrame() noexcept
+{
+  assert(depth > 0);
+
+  if (--depth > 0 || !active)
+    return;
+
+  active = false;
+
+  FlushScreen();
+  const auto end = Clock::now();
+
+#ifdef STOP_WATCH
+  for (unsigned i = 0; i < markers.size(); ++i) {
+    const auto stage_end = i + 1 < markers.size()
+      ? markers[i + 1].time
+      : end;
+    LogFormat("StopWatch '%s': %.3f ms", markers[i].name,
+              (double)ToMilliseconds(stage_end - markers[i].time));
+  }
+
+  LogFormat("StopWatch total: %.3f ms",
+            (double)ToMilliseconds(end - frame_start));
+#endif
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  AddTraceEvent(frame_name, 0, frame_start, end);
+  for (unsigned i = 0; i < markers.size(); ++i)
+    AddTraceEvent(markers[i].name, 1, markers[i].time,
+                  i + 1 < markers.size() ? markers[i + 1].time : end);
+
+  UpdateSummary(end);
+}
+
+void
+RenderProfiler::AddTraceEvent(const char *name, uint8_t level,
+                              Clock::time_point start,
+                              Clock::time_point end) noexcept
+{
+  const TraceEvent event{
+    name,
+    ToTraceTime(start),
+    uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()),
+    level,
+  };
+
+  if (trace.size() < MAX_TRACE_EVENTS) {
+    trace.push_back(event);
+  } else {
+    /* the buffer is full: overwrite the oldest event */
+    trace[trace_head] = event;
+    trace_head = (trace_head + 1) % MAX_TRACE_EVENTS;
+  }
+}
+
+static float
+UpdateAverage(float average, float value, bool first) noexcept
+{
+  return first
+    ? value
+    : average + (value - average) * AVERAGE_WEIGHT;
+}
+
+void
+RenderProfiler::UpdateSummary(Clock::time_point end) noexcept
+{
+  const bool first = summary.n_frames == 0;
+  ++summary.n_frames;
+
+  summary.frame_last = ToMilliseconds(end - frame_start);
+  summary.frame_average = UpdateAverage(summary.frame_average,
+                                        summary.frame_last, first);
+
+  /* reset the durations of all known stages; a stage which was
+     skipped in this frame counts as zero */
+  for (auto &stage : summary.stages)
+    stage.last = 0;
+
+  for (unsigned i = 0; i < markers.size(); ++i) {
+    const auto stage_end = i + 1 < markers.size()
+      ? markers[i + 1].time
+      : end;
+    const float duration = ToMilliseconds(stage_end - markers[i].time);
+    const char *name = markers[i].name;
+
+    auto stage = std::find_if(summary.stages.begin(), summary.stages.end(),
+                              [name](const Stage &s){
+                                return s.name == name ||
+                                  strcmp(s.name, name) == 0;
+                              });
+    if (stage == summary.stages.end()) {
+      if (summary.stages.full())
+        continue;
+
+      stage = &summary.stages.append();
+      *stage = {name, 0, 0};
+    }
+
+    /* a stage may be entered more than once per frame */
+    stage->last += duration;
+  }
+
+  for (auto &stage : summary.stages)
+    stage.average = UpdateAverage(stage.average, stage.last,
+                                  first);
+}
+
+RenderProfiler::Summary
+RenderProfiler::GetSummary() const noexcept
+{
+  const std::lock_guard<Mutex> lock(mutex);
+  return summary;
+}
+
+void
+RenderProfiler::ExportTrace(Path path) const
+{
+  std::vector<TraceEvent> events;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    events.reserve(trace.size());
+    events.insert(events.end(), trace.begin() + trace_head, trace.end());
+    events.insert(events.end(), trace.begin(), trace.begin() + trace_head);
+  }
+
+  FileOutputStream file(path);
+  BufferedOutputStream buffered(file);
+
+  buffered.Write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+  bool first = true;
+  for (const auto &event : events) {
+    if (!first)
+      buffered.Write(",\n");
+    first = false;
+
+    /* the names are string literals which do not need to be
+       escaped */
+    buffered.Format("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\","
+                    "\"pid\":1,\"tid\":1,"
+                    "\"ts\":%llu,\"dur\":%lu}",
+                    event.name,
+                    event.level == 0 ? "frame" : "stage",
+                    (unsigned long long)event.start,
+                    (unsigned long)event.duration);
+  }
+
+  buffered.Write("\n]}\n");
+  buffered.Flush();
+  file.Commit();
+}
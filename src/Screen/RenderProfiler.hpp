@@ -0,0 +1,238 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_RENDER_PROFILER_HPP
+#define XCSOAR_SCREEN_RENDER_PROFILER_HPP
+
+#include "thread/Mutex.hxx"
+#include "util/StaticArray.hxx"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <cstdint>
+
+class Path;
+
+/**
+ * Measures how long each stage of rendering a frame takes (e.g. the
+ * map layers drawn by MapWindow::Render()).  A stage lasts from one
+ * Mark() call to the next one, or to the end of the frame.
+ *
+ * Profiling is disabled by default; then Mark() does nothing but
+ * check a flag.  While enabled, a moving average of each stage is
+ * maintained (for an on-screen overlay), and all stages are recorded
+ * in a bounded trace buffer which can be exported in the Chrome
+ * trace event format (chrome://tracing or ui.perfetto.dev).
+ *
+ * If the macro STOP_WATCH is defined, profiling is enabled from the
+ * start, and each frame is written to the log file.
+ */
+class RenderProfiler {
+  using Clock = std::chrono::steady_clock;
+
+public:
+  struct Stage {
+    const char *name;
+
+    /**
+     * The duration in the most recent frame [ms].
+     */
+    float last;
+
+    /**
+     * The moving average of the duration [ms].
+     */
+    float average;
+  };
+
+  static constexpr unsigned MAX_STAGES = 32;
+
+  struct Summary {
+    StaticArray<Stage, MAX_STAGES> stages;
+
+    /**
+     * The duration of the most recent frame [ms].
+     */
+    float frame_last = 0;
+
+    /**
+     * The moving average of the whole frame [ms].
+     */
+    float frame_average = 0;
+
+    unsigned n_frames = 0;
+  };
+
+private:
+  struct Marker {
+    const char *name;
+    Clock::time_point time;
+  };
+
+  struct TraceEvent {
+    const char *name;
+
+    /**
+     * Start time relative to #epoch [us].
+     */
+    uint64_t start;
+
+    /**
+     * Duration [us].
+     */
+    uint32_t duration;
+
+    /**
+     * 0 for the frame, 1 for its stages.
+     */
+    uint8_t level;
+  };
+
+  /**
+   * The maximum number of trace events; when the buffer is full, the
+   * oldest events are overwritten.
+   */
+  static constexpr size_t MAX_TRACE_EVENTS = 64 * 1024;
+
+  const char *const frame_name;
+
+  const Clock::time_point epoch;
+
+  std::atomic_bool enabled;
+
+  /**
+   * The nesting level of BeginFrame() calls.  This and the following
+   * attributes are only accessed by the rendering thread.
+   */
+  unsigned depth = 0;
+
+  /**
+   * Is the current frame being measured?  This is decided when the
+   * outermost frame begins.
+   */
+  bool active = false;
+
+  Clock::time_point frame_start;
+
+  StaticArray<Marker, 64> markers;
+
+  /**
+   * Protects #summary and #trace.
+   */
+  mutable Mutex mutex;
+
+  Summary summary;
+
+  std::vector<TraceEvent> trace;
+
+  /**
+   * The index of the oldest event in #trace, once the buffer is
+   * full.
+   */
+  size_t trace_head = 0;
+
+public:
+  /**
+   * @param _frame_name the name of the whole frame in the trace
+   */
+  explicit RenderProfiler(const char *_frame_name) noexcept;
+
+  RenderProfiler(const RenderProfiler &) = delete;
+  RenderProfiler &operator=(const RenderProfiler &) = delete;
+
+  bool IsEnabled() const noexcept {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Enable or disable profiling.  May be called from any thread.
+   */
+  void SetEnabled(bool _enabled) noexcept {
+    enabled.store(_enabled, std::memory_order_relaxed);
+  }
+
+  void BeginFrame() noexcept;
+  void EndFrame() noexcept;
+
+  /**
+   * Start a new stage within the current frame.
+   *
+   * @param name a string literal
+   */
+  void Mark(const char *name) noexcept {
+    if (active && !markers.full())
+      DoMark(name);
+  }
+
+  /**
+   * Obtain a copy of the moving averages.  May be called from any
+   * thread.
+   */
+  Summary GetSummary() const noexcept;
+
+  /**
+   * Write all recorded events to a JSON file in the Chrome trace
+   * event format.  May be called from any thread.
+   *
+   * Throws on error.
+   */
+  void ExportTrace(Path path) const;
+
+  /**
+   * Measures a frame during the lifetime of this object.  Frames may
+   * be nested; only the outermost one counts.
+   */
+  class ScopeFrame {
+    RenderProfiler &profiler;
+
+  public:
+    explicit ScopeFrame(RenderProfiler &_profiler) noexcept
+      :profiler(_profiler) {
+      profiler.BeginFrame();
+    }
+
+    ~ScopeFrame() noexcept {
+      profiler.EndFrame();
+    }
+
+    ScopeFrame(const ScopeFrame &) = delete;
+    ScopeFrame &operator=(const ScopeFrame &) = delete;
+  };
+
+private:
+  void DoMark(const char *name) noexcept;
+
+  uint64_t ToTraceTime(Clock::time_point t) const noexcept {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - epoch).count();
+  }
+
+  void AddTraceEvent(const char *name, uint8_t level,
+                     Clock::time_point start,
+                     Clock::time_point end) noexcept;
+
+  void UpdateSummary(Clock::time_point end) noexcept;
+};
+
+#endif
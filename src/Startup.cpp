@@ -59,7 +59,9 @@ Copyright_License {
 #include "CommandLine.hpp"
 #include "MainWindow.hpp"
 #include "Computer/GlideComputer.hpp"
+#include "Computer/WarningThread.hpp"
 #include "Computer/GlideComputerInterface.hpp"
+#include "Computer/LiftMapGlue.hpp"
 #include "Computer/Events.hpp"
 #include "Monitor/AllMonitors.hpp"
 #include "MergeThread.hpp"
@@ -109,6 +111,10 @@ Copyright_License {
 #include "DrawThread.hpp"
 #endif
 
+#ifdef USE_FREETYPE
+#include "ui/canvas/freetype/GlyphAtlas.hpp"
+#endif
+
 #ifdef ANDROID
 #include "Android/Main.hpp"
 #include "Android/Context.hpp"
@@ -306,6 +312,7 @@ Startup()
   glide_computer->SetTerrain(terrain);
   glide_computer->SetLogger(logger);
   glide_computer->Initialise();
+  LoadLiftMap(glide_computer->GetLiftMap());
 
   replay = new Replay(logger, *protected_task_manager);
 
@@ -555,6 +562,18 @@ Shutdown()
 
   if (calculation_thread != nullptr) {
     calculation_thread->Join();
+
+    /* the WarningThread's callback refers to the
+       CalculationThread */
+    if (auto *warning_thread = glide_computer->GetWarningThread()) {
+      const auto stats = warning_thread->GetStats();
+      LogFormat("Airspace warnings: %u updates, %u dropped, max latency %u ms",
+                stats.n_updates, stats.n_dropped,
+                unsigned(stats.max_latency * 1000));
+    }
+
+    glide_computer->DisableWarningThread();
+
     delete calculation_thread;
     calculation_thread = nullptr;
   }
@@ -643,6 +662,8 @@ Shutdown()
   LogFormat("Close Progress Dialog");
   operation.Hide();
 
+  if (glide_computer != nullptr)
+    SaveLiftMap(glide_computer->GetLiftMap());
   delete glide_computer;
   glide_computer = nullptr;
   delete task_events;
@@ -659,6 +680,20 @@ Shutdown()
   delete file_cache;
   file_cache = nullptr;
 
+#ifdef USE_FREETYPE
+  {
+    const auto &stats = GlyphAtlas::GetStats();
+    LogFormat("Glyph atlas: %llu hits, %llu misses, %llu overflows, "
+              "%llu uploads (%llu bytes), %llu fallbacks",
+              (unsigned long long)stats.hits,
+              (unsigned long long)stats.misses,
+              (unsigned long long)stats.overflows,
+              (unsigned long long)stats.uploads,
+              (unsigned long long)stats.upload_bytes,
+              (unsigned long long)stats.fallbacks);
+  }
+#endif
+
   LogFormat("Close Windows - main");
   main_window->Destroy();
   delete main_window;
@@ -22,9 +22,9 @@
 
 #include "LoadFile.hpp"
 #include "Deserialiser.hpp"
-#include "XML/Node.hpp"
-#include "XML/DataNodeXML.hpp"
 #include "XML/Parser.hpp"
+#include "XML/FlatDocument.hpp"
+#include "XML/DataNodeFlat.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "system/Path.hpp"
 #include "util/StringUtil.hpp"
@@ -39,8 +39,9 @@ LoadTask(Path path, const TaskBehaviour &task_behaviour,
          const Waypoints *waypoints)
 {
   // Load root node
-  const auto xml_root = XML::ParseFile(path);
-  const ConstDataNodeXML root(xml_root);
+  const auto xml = XML::ReadFile(path);
+  const XML::FlatDocument document({xml.data(), xml.size()});
+  const ConstDataNodeFlat root(document, document.GetRoot());
 
   // Check if root node is a <Task> node
   if (!StringIsEqual(root.GetName(), _T("Task")))
@@ -0,0 +1,219 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "TaskIndex.hpp"
+#include "system/Path.hpp"
+#include "io/LineReader.hpp"
+#include "io/BufferedOutputStream.hxx"
+#include "util/ConvertString.hpp"
+#include "util/NumberParser.hpp"
+#include "util/StringAPI.hxx"
+
+/**
+ * The file starts with a header line, followed by one "F" line per
+ * task file and one "N" line per task name in that file:
+ *
+ *   F mtime size path
+ *   N name
+ *
+ * Paths and names are UTF-8.
+ */
+
+static constexpr char HEADER[] = "# XCSoar task index v1";
+
+const TaskIndex::Entry *
+TaskIndex::Lookup(Path path, uint64_t mtime, uint64_t size) noexcept
+{
+  auto i = entries.find(path.c_str());
+  if (i == entries.end())
+    return nullptr;
+
+  Entry &entry = i->second;
+  entry.seen = true;
+
+  if (entry.mtime != mtime || entry.size != size)
+    return nullptr;
+
+  return &entry;
+}
+
+void
+TaskIndex::Set(Path path, uint64_t mtime, uint64_t size,
+               std::vector<tstring> &&names) noexcept
+{
+  Entry &entry = entries[path.c_str()];
+  entry.mtime = mtime;
+  entry.size = size;
+  entry.names = std::move(names);
+  entry.seen = true;
+  modified = true;
+}
+
+void
+TaskIndex::BeginScan() noexcept
+{
+  for (auto &i : entries)
+    i.second.seen = false;
+}
+
+[[gnu::pure]]
+static bool
+MatchesExtension(Path path,
+                 std::initializer_list<const TCHAR *> extensions) noexcept
+{
+  for (const TCHAR *i : extensions)
+    if (path.MatchesExtension(i))
+      return true;
+
+  return false;
+}
+
+void
+TaskIndex::EndScan(std::initializer_list<const TCHAR *> extensions) noexcept
+{
+  for (auto i = entries.begin(); i != entries.end();) {
+    if (i->second.seen ||
+        !MatchesExtension(Path(i->first.c_str()), extensions)) {
+      ++i;
+    } else {
+      i = entries.erase(i);
+      modified = true;
+    }
+  }
+}
+
+static bool
+ParseFileLine(const char *line, uint64_t &mtime, uint64_t &size,
+              const char *&path)
+{
+  char *endptr;
+
+  mtime = ParseUint64(line, &endptr);
+  if (endptr == line || *endptr != ' ')
+    return false;
+
+  line = endptr + 1;
+  size = ParseUint64(line, &endptr);
+  if (endptr == line || *endptr != ' ')
+    return false;
+
+  path = endptr + 1;
+  return *path != '\0';
+}
+
+void
+TaskIndex::Load(NLineReader &reader)
+{
+  const char *line = reader.ReadLine();
+  if (line == nullptr || !StringIsEqual(line, HEADER))
+    /* unknown format version */
+    return;
+
+  /* the entry which "N" lines get appended to; nullptr while
+     skipping a malformed entry */
+  Entry *entry = nullptr;
+
+  char *p;
+  while ((p = reader.ReadLine()) != nullptr) {
+    if (p[0] == 'F' && p[1] == ' ') {
+      uint64_t mtime, size;
+      const char *path;
+      entry = nullptr;
+      if (!ParseFileLine(p + 2, mtime, size, path))
+        continue;
+
+      const UTF8ToWideConverter tpath(path);
+      if (!tpath.IsValid())
+        continue;
+
+      entry = &entries[tpath.c_str()];
+      entry->mtime = mtime;
+      entry->size = size;
+      entry->names.clear();
+      entry->seen = false;
+    } else if (p[0] == 'N' && p[1] == ' ' && entry != nullptr) {
+      const UTF8ToWideConverter name(p + 2);
+      if (name.IsValid())
+        entry->names.emplace_back(name.c_str());
+    }
+  }
+}
+
+/**
+ * Can this string be stored on a single line?
+ */
+[[gnu::pure]]
+static bool
+IsSingleLine(const TCHAR *s) noexcept
+{
+  for (; *s != 0; ++s)
+    if (*s == '\n' || *s == '\r')
+      return false;
+  return true;
+}
+
+[[gnu::pure]]
+static bool
+CanSave(const tstring &path, const TaskIndex::Entry &entry) noexcept
+{
+  if (!IsSingleLine(path.c_str()))
+    return false;
+
+  for (const auto &name : entry.names)
+    if (!IsSingleLine(name.c_str()))
+      return false;
+
+  return true;
+}
+
+void
+TaskIndex::Save(BufferedOutputStream &writer)
+{
+  writer.Write(HEADER);
+  writer.Write('\n');
+
+  for (const auto &i : entries) {
+    if (!CanSave(i.first, i.second))
+      /* this entry will be recreated next time */
+      continue;
+
+    const WideToUTF8Converter path(i.first.c_str());
+    if (!path.IsValid())
+      continue;
+
+    writer.Format("F %llu %llu %s\n",
+                  (unsigned long long)i.second.mtime,
+                  (unsigned long long)i.second.size,
+                  path.c_str());
+
+    for (const auto &name : i.second.names) {
+      const WideToUTF8Converter uname(name.c_str());
+      writer.Write("N ");
+      if (uname.IsValid())
+        writer.Write(uname.c_str());
+      writer.Write('\n');
+    }
+  }
+
+  modified = false;
+}
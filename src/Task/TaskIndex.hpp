@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TASK_INDEX_HPP
+#define XCSOAR_TASK_INDEX_HPP
+
+#include "util/tstring.hpp"
+
+#include <tchar.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <vector>
+
+class Path;
+class NLineReader;
+class BufferedOutputStream;
+
+/**
+ * A persistent cache of the task names found in task files, keyed by
+ * the file's path.  Each entry remembers the modification time and
+ * the size of the file it was created from; if either has changed,
+ * the entry is considered stale and the file needs to be parsed
+ * again.
+ *
+ * This class is not thread-safe.
+ */
+class TaskIndex {
+public:
+  struct Entry {
+    uint64_t mtime, size;
+
+    /**
+     * The names of the tasks in this file, as returned by
+     * TaskFile::GetList().  This may be empty if the file contains
+     * no (valid) task.
+     */
+    std::vector<tstring> names;
+
+    /**
+     * Has this entry been looked up or updated since the last
+     * BeginScan() call?
+     */
+    bool seen;
+  };
+
+private:
+  std::map<tstring, Entry> entries;
+
+  bool modified = false;
+
+public:
+  bool empty() const noexcept {
+    return entries.empty();
+  }
+
+  std::size_t size() const noexcept {
+    return entries.size();
+  }
+
+  bool IsModified() const noexcept {
+    return modified;
+  }
+
+  /**
+   * Look up the entry for the specified file.  Returns nullptr if
+   * there is no entry or if it is stale.  Marks the entry as "seen"
+   * in both cases.
+   */
+  const Entry *Lookup(Path path, uint64_t mtime, uint64_t size) noexcept;
+
+  /**
+   * Add or replace the entry for the specified file.
+   */
+  void Set(Path path, uint64_t mtime, uint64_t size,
+           std::vector<tstring> &&names) noexcept;
+
+  /**
+   * Clear the "seen" flag on all entries.  Call this before scanning
+   * the data directory.
+   */
+  void BeginScan() noexcept;
+
+  /**
+   * Remove all entries which have not been looked up since
+   * BeginScan(), i.e. files which do not exist anymore.  Only files
+   * with one of the specified extensions (e.g. ".tsk") are
+   * considered; entries of other file types were not part of this
+   * scan and are kept.
+   */
+  void EndScan(std::initializer_list<const TCHAR *> extensions) noexcept;
+
+  /**
+   * Load entries from a file created by Save().  Malformed entries
+   * are skipped.
+   */
+  void Load(NLineReader &reader);
+
+  /**
+   * Write all entries and clear the "modified" flag.
+   */
+  void Save(BufferedOutputStream &writer);
+};
+
+#endif
@@ -25,8 +25,12 @@ Copyright_License {
 #include "Task/TaskFile.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Components.hpp"
+#include "Job/Job.hpp"
 #include "system/FileUtil.hpp"
 #include "system/Path.hpp"
+#include "io/FileLineReader.hpp"
+#include "io/FileOutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
 #include "LocalPath.hpp"
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
@@ -34,53 +38,179 @@ Copyright_License {
 #include <algorithm>
 #include <memory>
 
+#include <cassert>
+
+static constexpr const TCHAR *TASK_INDEX_FILE = _T("task-index.txt");
+
+static AllocatedPath
+GetIndexPath() noexcept
+{
+  return AllocatedPath::Build(MakeLocalPath(_T("cache")), TASK_INDEX_FILE);
+}
+
 class TaskFileVisitor: public File::Visitor
 {
 private:
-  TaskStore::ItemVector &store;
+  TaskIndex &index;
+  std::vector<TaskStore::PendingFile> &pending;
+  std::function<void(Path, const tstring &,
+                     const std::vector<tstring> &)> add;
 
 public:
-  TaskFileVisitor(TaskStore::ItemVector &_store):
-    store(_store) {}
+  template<typename F>
+  TaskFileVisitor(TaskIndex &_index,
+                  std::vector<TaskStore::PendingFile> &_pending,
+                  F &&_add)
+    :index(_index), pending(_pending), add(std::forward<F>(_add)) {}
 
-  void Visit(Path path, Path base_name) override
-  try {
-    // Create a TaskFile instance to determine how many
-    // tasks are inside of this task file
-    const auto task_file = TaskFile::Create(path);
-    if (!task_file)
-      return;
-
-    const auto list = task_file->GetList();
-
-    // Count the tasks in the task file
-    unsigned count = list.size();
-    // For each task in the task file
-    for (unsigned i = 0; i < count; i++) {
-      // Copy base name of the file into task name
-      StaticString<256> name(base_name.c_str());
-
-      // If the task file holds more than one task
-      const auto &saved_name = list[i];
-      if (!saved_name.empty()) {
-        name += _T(": ");
-        name += saved_name.c_str();
-      } else if (count > 1) {
-        // .. append " - Task #[n]" suffix to the task name
-        name.AppendFormat(_T(": %s #%d"), _("Task"), i + 1);
+  void Visit(Path path, Path base_name) override {
+    const uint64_t mtime = File::GetLastModification(path);
+    const uint64_t size = File::GetSize(path);
+
+    if (const auto *entry = index.Lookup(path, mtime, size))
+      add(path, base_name.c_str(), entry->names);
+    else
+      /* new or modified: parse it in the background */
+      pending.push_back({AllocatedPath(path), base_name.c_str(),
+                         mtime, size});
+  }
+};
+
+/**
+ * Parses the pending task files in a background thread and submits
+ * the task names to the #TaskStore one file at a time.
+ */
+class TaskStore::ScanJob final : public Job {
+  TaskStore &store;
+  const std::vector<PendingFile> files;
+
+public:
+  ScanJob(TaskStore &_store, std::vector<PendingFile> &&_files) noexcept
+    :store(_store), files(std::move(_files)) {}
+
+  void Run(OperationEnvironment &env) override {
+    for (const auto &file : files) {
+      if (env.IsCancelled())
+        break;
+
+      std::vector<tstring> names;
+
+      try {
+        // Create a TaskFile instance to determine how many
+        // tasks are inside of this task file
+        const auto task_file = TaskFile::Create(file.path);
+        if (task_file)
+          names = task_file->GetList();
+      } catch (...) {
+        /* remember the file anyway, without tasks, so it doesn't get
+           parsed again until it is modified */
+        LogError(std::current_exception());
+      }
+
+      {
+        const std::lock_guard<Mutex> lock(store.mutex);
+        store.index.Set(file.path, file.mtime, file.size,
+                        std::vector<tstring>(names));
+        store.received.push_back({Path(file.path), file.base_name,
+                                  std::move(names)});
       }
 
-      // Add the task to the TaskStore
-      store.emplace_back(path, name.empty() ? path.c_str() : name, i);
+      store.result_notify.SendNotification();
     }
-  } catch (...) {
-    LogError(std::current_exception());
   }
 };
 
+TaskStore::~TaskStore() noexcept
+{
+  CancelScan();
+}
+
+void
+TaskStore::CancelScan() noexcept
+{
+  if (job != nullptr) {
+    async.Cancel();
+
+    try {
+      async.Wait();
+    } catch (...) {
+      LogError(std::current_exception());
+    }
+
+    delete job;
+    job = nullptr;
+
+    /* the results which have been submitted so far are still in
+       the index; everything else will be scanned again next time */
+    SaveIndex();
+  }
+
+  result_notify.ClearNotification();
+  received.clear();
+  pending.clear();
+}
+
+void
+TaskStore::LoadIndex() noexcept
+try {
+  index_loaded = true;
+
+  const auto path = GetIndexPath();
+  if (!File::Exists(path))
+    return;
+
+  FileLineReaderA reader(path);
+  index.Load(reader);
+} catch (...) {
+  LogError(std::current_exception());
+}
+
+void
+TaskStore::SaveIndex() noexcept
+try {
+  if (!index.IsModified())
+    return;
+
+  FileOutputStream fos(GetIndexPath());
+  BufferedOutputStream bos(fos);
+  index.Save(bos);
+  bos.Flush();
+  fos.Commit();
+} catch (...) {
+  LogError(std::current_exception());
+}
+
+void
+TaskStore::AddFile(Path path, const tstring &base_name,
+                   const std::vector<tstring> &names)
+{
+  // Count the tasks in the task file
+  const unsigned count = names.size();
+  // For each task in the task file
+  for (unsigned i = 0; i < count; i++) {
+    // Copy base name of the file into task name
+    StaticString<256> name(base_name.c_str());
+
+    // If the task file holds more than one task
+    const auto &saved_name = names[i];
+    if (!saved_name.empty()) {
+      name += _T(": ");
+      name += saved_name.c_str();
+    } else if (count > 1) {
+      // .. append " - Task #[n]" suffix to the task name
+      name.AppendFormat(_T(": %s #%d"), _("Task"), i + 1);
+    }
+
+    // Add the task to the TaskStore
+    store.emplace_back(path, name.empty() ? path.c_str() : name, i);
+  }
+}
+
 void
 TaskStore::Clear()
 {
+  CancelScan();
+
   // clear entries first
   store.erase(store.begin(), store.end());
 }
@@ -90,8 +220,17 @@ TaskStore::Scan(bool extra)
 {
   Clear();
 
+  if (!index_loaded)
+    LoadIndex();
+
+  index.BeginScan();
+
   // scan files
-  TaskFileVisitor tfv(store);
+  TaskFileVisitor tfv(index, pending,
+                      [this](Path path, const tstring &base_name,
+                             const std::vector<tstring> &names){
+                        AddFile(path, base_name, names);
+                      });
   VisitDataFiles(_T("*.tsk"), tfv);
 
   if (extra) {
@@ -99,7 +238,95 @@ TaskStore::Scan(bool extra)
     VisitDataFiles(_T("*.igc"), tfv);
   }
 
+  if (extra)
+    index.EndScan({_T(".tsk"), _T(".cup"), _T(".igc")});
+  else
+    index.EndScan({_T(".tsk")});
+
   std::sort(store.begin(), store.end());
+
+  if (pending.empty()) {
+    SaveIndex();
+    return;
+  }
+
+  job = new ScanJob(*this, std::move(pending));
+  pending.clear();
+  async.Start(job, env, &finished_notify);
+}
+
+unsigned
+TaskStore::ReceiveResults(unsigned keep_index) noexcept
+{
+  std::vector<ScanResult> results;
+
+  {
+    const std::lock_guard<Mutex> lock(mutex);
+    results.swap(received);
+  }
+
+  if (results.empty())
+    return keep_index;
+
+  /* remember which item was selected, find it again after
+     sorting */
+  const bool keep = keep_index < store.size();
+  AllocatedPath keep_path = nullptr;
+  unsigned keep_task_index = 0;
+  if (keep) {
+    keep_path = store[keep_index].GetPath();
+    keep_task_index = store[keep_index].task_index;
+  }
+
+  const std::size_t old_size = store.size();
+  for (const auto &result : results)
+    AddFile(result.path, result.base_name, result.names);
+
+  if (store.size() == old_size)
+    return keep_index;
+
+  /* the new items are sorted and then merged, which is cheaper than
+     sorting the whole list again */
+  const auto middle = std::next(store.begin(), old_size);
+  std::sort(middle, store.end());
+  std::inplace_merge(store.begin(), middle, store.end());
+
+  if (!keep)
+    return keep_index;
+
+  for (unsigned i = 0; i < store.size(); ++i)
+    if (store[i].task_index == keep_task_index &&
+        store[i].filename == keep_path)
+      return i;
+
+  return keep_index;
+}
+
+void
+TaskStore::OnResult() noexcept
+{
+  if (update_callback)
+    update_callback();
+}
+
+void
+TaskStore::OnScanFinished() noexcept
+{
+  assert(job != nullptr);
+
+  try {
+    async.Wait();
+  } catch (...) {
+    LogError(std::current_exception());
+  }
+
+  delete job;
+  job = nullptr;
+
+  SaveIndex();
+
+  if (update_callback)
+    update_callback();
 }
 
 TaskStore::Item::~Item() noexcept = default;
@@ -24,9 +24,15 @@ Copyright_License {
 #ifndef TASK_STORE_HPP
 #define TASK_STORE_HPP
 
+#include "TaskIndex.hpp"
 #include "system/Path.hpp"
+#include "thread/Mutex.hxx"
+#include "Job/Async.hpp"
+#include "Operation/Operation.hpp"
+#include "ui/event/Notify.hpp"
 #include "util/tstring.hpp"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -35,6 +41,11 @@ class OrderedTask;
 
 /**
  * Class to load multiple tasks on demand, e.g. for browsing
+ *
+ * The task names are taken from a persistent #TaskIndex; only files
+ * which are new or have been modified since the index was written
+ * are parsed, and that happens in a background thread.  The task
+ * bodies are only parsed when GetTask() is called.
  */
 class TaskStore 
 {
@@ -80,21 +91,107 @@ public:
 
   typedef std::vector<TaskStore::Item> ItemVector;
 
+  /**
+   * A task file which needs to be parsed (again).
+   */
+  struct PendingFile {
+    AllocatedPath path;
+    tstring base_name;
+    uint64_t mtime, size;
+  };
+
+  /**
+   * The task names found in one #PendingFile by the background
+   * thread.
+   */
+  struct ScanResult {
+    AllocatedPath path;
+    tstring base_name;
+    std::vector<tstring> names;
+  };
+
+  using UpdateCallback = std::function<void()>;
+
 private:
+  class ScanJob;
+
   /**
    * Internal task storage
    */
   ItemVector store;
 
+  TaskIndex index;
+  bool index_loaded = false;
+
+  /**
+   * Files to be parsed by the next #ScanJob.
+   */
+  std::vector<PendingFile> pending;
+
+  /**
+   * Protects #index and #received while a #ScanJob is running.
+   */
+  Mutex mutex;
+
+  /**
+   * Results submitted by the #ScanJob which have not yet been merged
+   * into #store.  Protected by #mutex.
+   */
+  std::vector<ScanResult> received;
+
+  AsyncJobRunner async;
+  ScanJob *job = nullptr;
+  QuietOperationEnvironment env;
+
+  UI::Notify result_notify{[this]{ OnResult(); }};
+  UI::Notify finished_notify{[this]{ OnScanFinished(); }};
+
+  /**
+   * Invoked in the main thread when new results are available (call
+   * ReceiveResults()) or when the background scan has finished.
+   */
+  const UpdateCallback update_callback;
+
 public:
+  explicit TaskStore(UpdateCallback _update_callback={}) noexcept
+    :update_callback(std::move(_update_callback)) {}
+
+  ~TaskStore() noexcept;
+
+  TaskStore(const TaskStore &) = delete;
+  TaskStore &operator=(const TaskStore &) = delete;
+
   /**
    * Scan the XCSoarData folder for .tsk files and add them to the TaskStore
    *
+   * Files which are listed in the index with matching modification
+   * time and size are added immediately.  All others are parsed by a
+   * background thread; their tasks show up after the update callback
+   * has been invoked and ReceiveResults() has been called.
+   *
    * @param extra scan all "extra" (non-XCSoar) task files, e.g. *.cup
    * and task declarations from *.igc
    */
   void Scan(bool extra=false);
 
+  /**
+   * Is the background thread still parsing files?
+   */
+  [[gnu::pure]]
+  bool IsScanning() const noexcept {
+    return job != nullptr;
+  }
+
+  /**
+   * Merge the tasks found by the background thread into the list.
+   * Must be called in the main thread.
+   *
+   * @param keep_index the index of an item (e.g. the list cursor)
+   * whose new position shall be returned
+   * @return the new index of the item previously at #keep_index
+   */
+  unsigned ReceiveResults(unsigned keep_index=0) noexcept;
+
   /**
    * Clear all the tasks from the TaskStore
    */
@@ -134,6 +231,17 @@ public:
    */
   const OrderedTask *GetTask(unsigned index,
                              const TaskBehaviour &task_behaviour);
+
+private:
+  void CancelScan() noexcept;
+  void LoadIndex() noexcept;
+  void SaveIndex() noexcept;
+
+  void AddFile(Path path, const tstring &base_name,
+               const std::vector<tstring> &names);
+
+  void OnResult() noexcept;
+  void OnScanFinished() noexcept;
 };
 
 #endif
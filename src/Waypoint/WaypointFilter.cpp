@@ -24,6 +24,8 @@ Copyright_License {
 #include "WaypointFilter.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Engine/Task/Shapes/FAITrianglePointValidator.hpp"
+#include "util/CharUtil.hxx"
+#include "util/StringUtil.hpp"
 
 inline bool
 WaypointFilter::CompareType(const Waypoint &waypoint, TypeFilter type,
@@ -121,3 +123,48 @@ WaypointFilter::Matches(const Waypoint &waypoint, GeoPoint location,
          (distance <= 0 || CompareName(waypoint)) &&
          CompareDirection(waypoint, location);
 }
+
+/**
+ * Like NormalizeSearchString() followed by a prefix comparison, but
+ * without copying the (possibly long) waypoint name.
+ */
+static bool
+CompareNormalisedPrefix(const TCHAR *name, const TCHAR *normalized_prefix)
+{
+  for (; *normalized_prefix != 0; ++name) {
+    if (*name == 0)
+      return false;
+
+    if (!IsAlphaNumericASCII(*name))
+      continue;
+
+    if (ToUpperASCII(*name) != *normalized_prefix)
+      return false;
+
+    ++normalized_prefix;
+  }
+
+  return true;
+}
+
+bool
+WaypointFilter::MatchesName(const Waypoint &waypoint) const
+{
+  if (distance > 0)
+    return CompareName(waypoint);
+
+  TCHAR normalized[NAME_LENGTH + 1];
+  NormalizeSearchString(normalized, name);
+  return CompareNormalisedPrefix(waypoint.name.c_str(), normalized);
+}
+
+bool
+WaypointFilter::IsRefinementOf(const WaypointFilter &other) const
+{
+  return type_index == other.type_index &&
+    distance == other.distance &&
+    direction.Native() == other.direction.Native() &&
+    name.length() >= other.name.length() &&
+    StringIsEqualIgnoreCase(name.c_str(), other.name.c_str(),
+                            other.name.length());
+}
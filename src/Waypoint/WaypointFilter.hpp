@@ -71,6 +71,24 @@ struct WaypointFilter
   bool Matches(const Waypoint &waypoint, GeoPoint location,
                const FAITrianglePointValidator &triangle_validator) const;
 
+  /**
+   * Check only the name, the same way a full query does: a
+   * case-insensitive prefix match when the distance filter is
+   * active, and a match against the normalised prefix (see
+   * NormalizeSearchString()) when the name tree is used.
+   */
+  gcc_pure
+  bool MatchesName(const Waypoint &waypoint) const;
+
+  /**
+   * Does this filter accept a subset of the waypoints accepted by
+   * #other, differing only by a longer name prefix?  The result of
+   * #other can then be narrowed with MatchesName() instead of
+   * querying the waypoint database again.
+   */
+  gcc_pure
+  bool IsRefinementOf(const WaypointFilter &other) const;
+
 private:
   static bool CompareType(const Waypoint &waypoint, TypeFilter type,
                           const FAITrianglePointValidator &triangle_validator);
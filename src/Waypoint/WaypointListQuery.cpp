@@ -0,0 +1,62 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointListQuery.hpp"
+#include "WaypointListBuilder.hpp"
+#include "WaypointList.hpp"
+#include "Waypoint/Waypoint.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+
+#include <algorithm>
+
+bool
+WaypointListQuery::Update(const Waypoints &waypoints,
+                          const WaypointFilter &_filter,
+                          WaypointList &list) noexcept
+{
+  const bool reuse = valid && waypoints.GetSerial() == serial &&
+    _filter.IsRefinementOf(filter);
+
+  if (reuse) {
+    if (_filter.name.length() > filter.name.length())
+      list.erase(std::remove_if(list.begin(), list.end(),
+                                [&_filter](const WaypointListItem &item){
+                                  return !_filter.MatchesName(*item.waypoint);
+                                }),
+                 list.end());
+  } else {
+    list.clear();
+
+    WaypointListBuilder builder(_filter, location, list,
+                                ordered_task, ordered_task_index);
+    builder.Visit(waypoints);
+
+    if (_filter.distance > 0 || !_filter.direction.IsNegative())
+      list.SortByDistance(location);
+  }
+
+  filter = _filter;
+  serial = waypoints.GetSerial();
+  valid = true;
+  return reuse;
+}
@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_LIST_QUERY_HPP
+#define XCSOAR_WAYPOINT_LIST_QUERY_HPP
+
+#include "WaypointFilter.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "util/Serial.hpp"
+
+class WaypointList;
+class Waypoints;
+class OrderedTask;
+
+/**
+ * Fills a #WaypointList like #WaypointListBuilder does, but remembers
+ * the filter which produced the list.  When the next filter only
+ * extends the name prefix (i.e. the user typed another character),
+ * the previous result is narrowed in place instead of querying the
+ * waypoint database again; this preserves the sort order and the
+ * cached #GeoVector of each item.
+ *
+ * The caller must not modify the list between two Update() calls,
+ * or else call Invalidate().
+ */
+class WaypointListQuery final {
+  const GeoPoint location;
+
+  OrderedTask *const ordered_task;
+  const unsigned ordered_task_index;
+
+  /**
+   * The filter which produced the current list.  Only valid if
+   * #valid is true.
+   */
+  WaypointFilter filter;
+
+  /**
+   * The #Waypoints serial at the time the current list was built.
+   */
+  Serial serial;
+
+  bool valid = false;
+
+public:
+  WaypointListQuery(GeoPoint _location,
+                    OrderedTask *_ordered_task,
+                    unsigned _ordered_task_index) noexcept
+    :location(_location),
+     ordered_task(_ordered_task),
+     ordered_task_index(_ordered_task_index) {}
+
+  /**
+   * Forget the previous result, forcing the next Update() call to
+   * query the database.
+   */
+  void Invalidate() noexcept {
+    valid = false;
+  }
+
+  /**
+   * Fill the list with all waypoints matching the filter, sorted by
+   * distance if a distance or direction filter is set.
+   *
+   * @return true if the previous result was reused
+   */
+  bool Update(const Waypoints &waypoints, const WaypointFilter &_filter,
+              WaypointList &list) noexcept;
+};
+
+#endif
@@ -22,15 +22,12 @@ Copyright_License {
 */
 
 #include "RaspCache.hpp"
+#include "RaspMapCache.hpp"
 #include "RaspStore.hpp"
 #include "Terrain/RasterMap.hpp"
-#include "Terrain/Loader.hpp"
 #include "Language/Language.hpp"
-#include "system/Path.hpp"
-#include "io/ZipArchive.hpp"
 
 #include <cassert>
-#include <windef.h> // for MAX_PATH
 
 static constexpr unsigned
 ToHalfHours(BrokenTime t)
@@ -38,6 +35,9 @@ ToHalfHours(BrokenTime t)
   return t.hour * 2u + t.minute / 30;
 }
 
+RaspCache::RaspCache(RaspMapCache &_maps, unsigned _parameter)
+  :maps(_maps), store(maps.GetStore()), parameter(_parameter) {}
+
 const TCHAR *
 RaspCache::GetMapName() const
 {
@@ -75,7 +75,7 @@ RaspCache::IsInside(GeoPoint p) const
 }
 
 void
-RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
+RaspCache::Reload(BrokenTime time_local)
 {
   unsigned effective_time = time;
   if (effective_time == 0) {
@@ -89,7 +89,7 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
     assert(effective_time < RaspStore::MAX_WEATHER_TIMES);
   }
 
-  if (effective_time == last_time)
+  if (effective_time == last_time && map != nullptr)
     // no change, quick exit.
     return;
 
@@ -99,32 +99,5 @@ RaspCache::Reload(BrokenTime time_local, OperationEnvironment &operation)
   if (effective_time == RaspStore::MAX_WEATHER_TIMES)
     return;
 
-  Close();
-
-  auto archive = store.OpenArchive();
-  if (!archive)
-    return;
-
-  char new_name[MAX_PATH];
-  store.NarrowWeatherFilename(new_name, Path(store.GetItemInfo(parameter).name),
-                              effective_time);
-
-  RasterMap *new_map = new RasterMap();
-  if (!LoadTerrainOverview(archive->get(), new_name, nullptr,
-                           new_map->GetTileCache(),
-                           true, operation)) {
-    delete new_map;
-    return;
-  }
-
-  new_map->UpdateProjection();
-
-  map = new_map;
-}
-
-void
-RaspCache::Close()
-{
-  delete map;
-  map = nullptr;
+  map = maps.Get(parameter, effective_time);
 }
@@ -26,19 +26,23 @@ Copyright_License {
 
 #include "util/Compiler.h"
 
+#include <memory>
+
 #include <tchar.h>
 
 struct BrokenTime;
 struct GeoPoint;
 class RaspStore;
+class RaspMapCache;
 class RasterMap;
-class OperationEnvironment;
 
 /**
- * Class to manage the raster weather map, to be loaded/selected from
- * a #RaspStore instance.
+ * Class to manage the raster weather map, to be selected from a
+ * #RaspStore instance.  The maps are loaded by a #RaspMapCache.
  */
 class RaspCache {
+  RaspMapCache &maps;
+
   const RaspStore &store;
 
   const unsigned parameter;
@@ -46,18 +50,10 @@ class RaspCache {
   unsigned time = 0;
   unsigned last_time = 0;
 
-  RasterMap *map = nullptr;
+  std::shared_ptr<const RasterMap> map;
 
 public:
-  /** 
-   * Default constructor
-   */
-  RaspCache(const RaspStore &_store, unsigned _parameter)
-    :store(_store), parameter(_parameter) {}
-
-  ~RaspCache() {
-    Close();
-  }
+  RaspCache(RaspMapCache &_maps, unsigned _parameter);
 
   const RaspStore &GetStore() const {
     return store;
@@ -65,7 +61,7 @@ public:
 
   gcc_pure
   const RasterMap *GetMap() const {
-    return map;
+    return map.get();
   }
 
   /**
@@ -93,9 +89,14 @@ public:
   bool IsInside(GeoPoint p) const;
 
   /**
-   * @param day_time the local time, in seconds since midnight
+   * Select the map for the current time.  This does not block; if
+   * the map has not been loaded yet, GetMap() returns nullptr until
+   * the #RaspMapCache has loaded it.
+   *
+   * @param time_local the current local time (used if the "now" time
+   * index is selected)
    */
-  void Reload(BrokenTime time_local, OperationEnvironment &operation);
+  void Reload(BrokenTime time_local);
 
   /**
    * Returns the current time index.
@@ -107,9 +108,6 @@ public:
    * Sets the current time index.
    */
   void SetTime(BrokenTime t);
-
-private:
-  void Close();
 };
 
 #endif
@@ -0,0 +1,168 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RaspMapCache.hpp"
+#include "RaspStore.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "Terrain/Loader.hpp"
+#include "Operation/Operation.hpp"
+#include "io/ZipArchive.hpp"
+#include "system/Path.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+
+#include <windef.h> // for MAX_PATH
+
+RaspMapCache::RaspMapCache(std::shared_ptr<RaspStore> _store,
+                           std::function<void()> &&_callback) noexcept
+  :StandbyThread("RASP"), store(std::move(_store)),
+   callback(std::move(_callback)) {}
+
+RaspMapCache::~RaspMapCache() noexcept
+{
+  LockStop();
+}
+
+const RaspMapCache::Item *
+RaspMapCache::Find(Key key) const noexcept
+{
+  for (const auto &item : items)
+    if (item.key == key)
+      return &item;
+
+  return nullptr;
+}
+
+void
+RaspMapCache::Enqueue(Key key) noexcept
+{
+  if (key.time < RaspStore::MAX_WEATHER_TIMES &&
+      !queue.full() && !queue.contains(key) && Find(key) == nullptr)
+    queue.append(key);
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapCache::Get(unsigned parameter, unsigned time) noexcept
+{
+  const Key key{parameter, time};
+
+  const std::lock_guard<Mutex> lock(mutex);
+
+  std::shared_ptr<const RasterMap> result;
+
+  auto i = std::find_if(items.begin(), items.end(),
+                        [&key](const Item &item){
+                          return item.key == key;
+                        });
+  if (i != items.end()) {
+    /* move to the front of the LRU list */
+    items.splice(items.begin(), items, i);
+    result = i->map;
+  }
+
+  if (key == current && (i != items.end() || IsBusy()))
+    /* the prefetch queue is still up to date */
+    return result;
+
+  current = key;
+
+  /* schedule the requested map and its neighbours (in the order of
+     distance, later times first because that's where the clock is
+     going) */
+
+  queue.clear();
+  Enqueue(key);
+
+  unsigned after = time, before = time;
+  for (unsigned n = 0; n < PREFETCH_RANGE; ++n) {
+    while (++after < RaspStore::MAX_WEATHER_TIMES &&
+           !store->IsTimeAvailable(parameter, after)) {}
+    Enqueue({parameter, after});
+
+    while (before > 0 && !store->IsTimeAvailable(parameter, --before)) {}
+    if (store->IsTimeAvailable(parameter, before))
+      Enqueue({parameter, before});
+  }
+
+  if (!queue.empty() && !IsBusy())
+    Trigger();
+
+  return result;
+}
+
+std::shared_ptr<const RasterMap>
+RaspMapCache::Load(Key key) const noexcept
+try {
+  auto archive = store->OpenArchive();
+
+  char name[MAX_PATH];
+  if (!store->NarrowWeatherFilename(name,
+                                    Path(store->GetItemInfo(key.parameter).name),
+                                    key.time))
+    return nullptr;
+
+  auto map = std::make_shared<RasterMap>();
+
+  NullOperationEnvironment env;
+  if (!LoadTerrainOverview(archive->get(), name, nullptr,
+                           map->GetTileCache(), true, env))
+    return nullptr;
+
+  map->UpdateProjection();
+  return map;
+} catch (...) {
+  LogError(std::current_exception(), "Failed to load RASP map");
+  return nullptr;
+}
+
+void
+RaspMapCache::Tick() noexcept
+{
+  while (!queue.empty() && !IsStopped()) {
+    const Key key = queue.front();
+    queue.remove(0);
+
+    if (Find(key) != nullptr)
+      continue;
+
+    std::shared_ptr<const RasterMap> map;
+
+    {
+      const ScopeUnlock unlock(mutex);
+      map = Load(key);
+    }
+
+    /* evict the least recently used maps; their memory is freed as
+       soon as the renderer lets go of them */
+    while (items.size() >= MAX_MAPS)
+      items.pop_back();
+
+    items.push_front({key, std::move(map)});
+
+    if (key == current && callback) {
+      const ScopeUnlock unlock(mutex);
+      callback();
+    }
+  }
+}
@@ -0,0 +1,143 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WEATHER_RASP_MAP_CACHE_HPP
+#define XCSOAR_WEATHER_RASP_MAP_CACHE_HPP
+
+#include "thread/StandbyThread.hpp"
+#include "util/StaticArray.hxx"
+
+#include <functional>
+#include <list>
+#include <memory>
+
+class RaspStore;
+class RasterMap;
+
+/**
+ * A cache of decoded RASP maps, keyed by parameter and time index.
+ * Maps are decoded by a background thread; the neighbouring time
+ * slots of the map being displayed are decoded ahead of time, so
+ * scrubbing through the forecast does not stall the caller.
+ */
+class RaspMapCache final : private StandbyThread {
+public:
+  /**
+   * The maximum number of decoded maps kept in memory.
+   */
+  static constexpr unsigned MAX_MAPS = 8;
+
+  /**
+   * The number of available time slots before and after the
+   * displayed one which are decoded ahead of time.
+   */
+  static constexpr unsigned PREFETCH_RANGE = 2;
+
+  struct Key {
+    unsigned parameter, time;
+
+    constexpr bool operator==(const Key &other) const noexcept {
+      return parameter == other.parameter && time == other.time;
+    }
+  };
+
+private:
+  const std::shared_ptr<RaspStore> store;
+
+  /**
+   * Invoked by the thread after the map most recently requested by
+   * Get() has been loaded.
+   */
+  const std::function<void()> callback;
+
+  struct Item {
+    Key key;
+
+    /**
+     * The decoded map, or nullptr if it has failed to load.
+     */
+    std::shared_ptr<const RasterMap> map;
+  };
+
+  /**
+   * The decoded maps, most recently used first.  Protected by the
+   * mutex.
+   */
+  std::list<Item> items;
+
+  /**
+   * The maps to be loaded by the thread, most urgent first.
+   * Protected by the mutex.
+   */
+  StaticArray<Key, 1 + 2 * PREFETCH_RANGE> queue;
+
+  /**
+   * The key most recently passed to Get().  Protected by the mutex.
+   */
+  Key current{~0u, ~0u};
+
+public:
+  RaspMapCache(std::shared_ptr<RaspStore> _store,
+               std::function<void()> &&_callback) noexcept;
+
+  ~RaspMapCache() noexcept;
+
+  const RaspStore &GetStore() const noexcept {
+    return *store;
+  }
+
+  /**
+   * Look up a decoded map.  On a miss, the map is scheduled to be
+   * loaded by the thread, which invokes the callback when done.  In
+   * any case, the neighbouring time slots are scheduled for
+   * prefetching.
+   *
+   * This method is thread-safe.
+   *
+   * @param time an available time index, see
+   * RaspStore::GetNearestTime()
+   * @return the map, or nullptr if it is not yet available (or has
+   * failed to load)
+   */
+  std::shared_ptr<const RasterMap> Get(unsigned parameter,
+                                       unsigned time) noexcept;
+
+private:
+  /**
+   * Caller must lock the mutex.
+   */
+  [[gnu::pure]]
+  const Item *Find(Key key) const noexcept;
+
+  /**
+   * Caller must lock the mutex.
+   */
+  void Enqueue(Key key) noexcept;
+
+  std::shared_ptr<const RasterMap> Load(Key key) const noexcept;
+
+  /* virtual methods from class StandbyThread */
+  void Tick() noexcept override;
+};
+
+#endif
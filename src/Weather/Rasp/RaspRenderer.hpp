@@ -46,8 +46,8 @@ class RaspRenderer {
   const ColorRamp *last_color_ramp = nullptr;
 
 public:
-  RaspRenderer(const RaspStore &_store, unsigned parameter)
-    :cache(_store, parameter) {}
+  RaspRenderer(RaspMapCache &maps, unsigned parameter)
+    :cache(maps, parameter) {}
 
   /**
    * Flush the cache.
@@ -82,8 +82,8 @@ public:
     cache.SetTime(t);
   }
 
-  void Update(BrokenTime time_local, OperationEnvironment &operation) {
-    cache.Reload(time_local, operation);
+  void Update(BrokenTime time_local) {
+    cache.Reload(time_local);
   }
 
   /**
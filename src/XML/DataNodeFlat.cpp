@@ -0,0 +1,70 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "DataNodeFlat.hpp"
+#include "FlatDocument.hpp"
+#include "util/StringAPI.hxx"
+
+using XML::FlatDocument;
+
+const TCHAR *
+ConstDataNodeFlat::GetName() const noexcept
+{
+  return document.GetName(element);
+}
+
+std::unique_ptr<ConstDataNode>
+ConstDataNodeFlat::GetChildNamed(const TCHAR *name) const noexcept
+{
+  const unsigned child = document.FindChild(element, name);
+  if (child == FlatDocument::NONE)
+    return nullptr;
+
+  return std::make_unique<ConstDataNodeFlat>(document, child);
+}
+
+ConstDataNode::List
+ConstDataNodeFlat::ListChildren() const noexcept
+{
+  List list;
+  for (unsigned i = document.GetFirstChild(element);
+       i != FlatDocument::NONE; i = document.GetNextSibling(i))
+    list.emplace_back(new ConstDataNodeFlat(document, i));
+  return list;
+}
+
+ConstDataNode::List
+ConstDataNodeFlat::ListChildrenNamed(const TCHAR *name) const noexcept
+{
+  List list;
+  for (unsigned i = document.GetFirstChild(element);
+       i != FlatDocument::NONE; i = document.GetNextSibling(i))
+    if (StringIsEqualIgnoreCase(document.GetName(i), name))
+      list.emplace_back(new ConstDataNodeFlat(document, i));
+  return list;
+}
+
+const TCHAR *
+ConstDataNodeFlat::GetAttribute(const TCHAR *name) const noexcept
+{
+  return document.GetAttribute(element, name);
+}
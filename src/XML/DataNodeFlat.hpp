@@ -0,0 +1,51 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_DATANODE_FLAT_HPP
+#define XCSOAR_DATANODE_FLAT_HPP
+
+#include "DataNode.hpp"
+
+namespace XML { class FlatDocument; }
+
+/**
+ * ConstDataNode implementation for an XML::FlatDocument, i.e. an XML
+ * file parsed without building an XMLNode tree.
+ */
+class ConstDataNodeFlat final : public ConstDataNode {
+  const XML::FlatDocument &document;
+  const unsigned element;
+
+public:
+  ConstDataNodeFlat(const XML::FlatDocument &_document,
+                    unsigned _element) noexcept
+    :document(_document), element(_element) {}
+
+  /* virtual methods from ConstDataNode */
+  const TCHAR *GetName() const noexcept override;
+  std::unique_ptr<ConstDataNode> GetChildNamed(const TCHAR *name) const noexcept override;
+  List ListChildren() const noexcept override;
+  List ListChildrenNamed(const TCHAR *name) const noexcept override;
+  const TCHAR *GetAttribute(const TCHAR *name) const noexcept override;
+};
+
+#endif
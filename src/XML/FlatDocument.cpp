@@ -0,0 +1,144 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "FlatDocument.hpp"
+#include "PullParser.hpp"
+#include "util/StringAPI.hxx"
+
+#include <stdexcept>
+
+namespace XML {
+
+unsigned
+FlatDocument::AddString(TStringView s)
+{
+  const unsigned offset = strings.size();
+  strings.insert(strings.end(), s.begin(), s.end());
+  strings.push_back(_T('\0'));
+  return offset;
+}
+
+unsigned
+FlatDocument::AddEscapedString(TStringView s)
+{
+  const unsigned offset = strings.size();
+  strings.resize(offset + s.size + 1);
+
+  TCHAR *end = Unescape(s, strings.data() + offset);
+  if (end == nullptr)
+    throw std::runtime_error("Malformed entity");
+
+  *end++ = _T('\0');
+  strings.resize(end - strings.data());
+  return offset;
+}
+
+FlatDocument::FlatDocument(TStringView src)
+{
+  /* the names and values (with their terminators) are hardly ever
+     longer than the source; this avoids reallocations */
+  strings.reserve(src.size);
+
+  /* the elements which are currently open, and the index of the
+     last child of each */
+  struct Open {
+    unsigned element, last_child;
+  };
+
+  std::vector<Open> stack;
+
+  PullParser parser(src);
+  PullParser::Event event;
+  while ((event = parser.Next()) != PullParser::Event::END) {
+    switch (event) {
+    case PullParser::Event::START_ELEMENT:
+      if (stack.empty() && !elements.empty()) {
+        /* only the first top-level element is the document; skip
+           the others */
+        parser.SkipElement();
+        break;
+      }
+
+      {
+        const unsigned index = elements.size();
+
+        Element element;
+        element.name = AddString(parser.GetName());
+        element.first_attribute = attributes.size();
+
+        for (const auto &i : parser.GetAttributes())
+          attributes.push_back({AddString(i.name),
+                                AddEscapedString(i.value)});
+
+        element.end_attribute = attributes.size();
+        elements.push_back(element);
+
+        if (!stack.empty()) {
+          Open &parent = stack.back();
+          if (parent.last_child == NONE)
+            elements[parent.element].first_child = index;
+          else
+            elements[parent.last_child].next_sibling = index;
+          parent.last_child = index;
+        }
+
+        stack.push_back({index, NONE});
+      }
+      break;
+
+    case PullParser::Event::END_ELEMENT:
+      stack.pop_back();
+      break;
+
+    case PullParser::Event::TEXT:
+    case PullParser::Event::END:
+      break;
+    }
+  }
+
+  if (elements.empty())
+    throw std::runtime_error("No elements found");
+}
+
+unsigned
+FlatDocument::FindChild(unsigned element, const TCHAR *name) const noexcept
+{
+  for (unsigned i = GetFirstChild(element); i != NONE; i = GetNextSibling(i))
+    if (StringIsEqualIgnoreCase(GetName(i), name))
+      return i;
+
+  return NONE;
+}
+
+const TCHAR *
+FlatDocument::GetAttribute(unsigned element,
+                           const TCHAR *name) const noexcept
+{
+  const Element &e = elements[element];
+  for (unsigned i = e.first_attribute; i != e.end_attribute; ++i)
+    if (StringIsEqualIgnoreCase(GetString(attributes[i].name), name))
+      return GetString(attributes[i].value);
+
+  return nullptr;
+}
+
+}
@@ -0,0 +1,120 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_XML_FLAT_DOCUMENT_HPP
+#define XCSOAR_XML_FLAT_DOCUMENT_HPP
+
+#include "util/TStringView.hxx"
+
+#include <vector>
+
+#include <tchar.h>
+
+namespace XML {
+
+/**
+ * A read-only XML document built by a single pass of the
+ * #PullParser.  Unlike #XMLNode, it does not allocate anything per
+ * element: all elements and attributes are stored in two flat
+ * arrays, and all names and (unescaped) values share one
+ * null-terminated string buffer.  Text content is discarded.
+ *
+ * Elements are referred to by their index; the root element has
+ * index 0.
+ */
+class FlatDocument {
+public:
+  static constexpr unsigned NONE = ~0u;
+
+private:
+  struct Element {
+    unsigned name;
+    unsigned first_attribute, end_attribute;
+    unsigned first_child = NONE, next_sibling = NONE;
+  };
+
+  struct Attribute {
+    unsigned name, value;
+  };
+
+  std::vector<Element> elements;
+  std::vector<Attribute> attributes;
+  std::vector<TCHAR> strings;
+
+public:
+  /**
+   * Parse the given XML document.
+   *
+   * Throws std::runtime_error on error.
+   */
+  explicit FlatDocument(TStringView src);
+
+  FlatDocument(const FlatDocument &) = delete;
+  FlatDocument &operator=(const FlatDocument &) = delete;
+
+  unsigned GetRoot() const noexcept {
+    return 0;
+  }
+
+  const TCHAR *GetName(unsigned element) const noexcept {
+    return GetString(elements[element].name);
+  }
+
+  unsigned GetFirstChild(unsigned element) const noexcept {
+    return elements[element].first_child;
+  }
+
+  unsigned GetNextSibling(unsigned element) const noexcept {
+    return elements[element].next_sibling;
+  }
+
+  /**
+   * Find the first child element with the specified
+   * (case-insensitive) name.
+   *
+   * @return the element index or #NONE
+   */
+  [[gnu::pure]]
+  unsigned FindChild(unsigned element, const TCHAR *name) const noexcept;
+
+  /**
+   * Look up an attribute by its (case-insensitive) name.
+   *
+   * @return the unescaped value or nullptr if there is no such
+   * attribute
+   */
+  [[gnu::pure]]
+  const TCHAR *GetAttribute(unsigned element,
+                            const TCHAR *name) const noexcept;
+
+private:
+  const TCHAR *GetString(unsigned offset) const noexcept {
+    return strings.data() + offset;
+  }
+
+  unsigned AddString(TStringView s);
+  unsigned AddEscapedString(TStringView s);
+};
+
+}
+
+#endif
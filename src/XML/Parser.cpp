@@ -769,8 +769,8 @@ XML::ParseString(const TCHAR *xml_string)
   return xnode;
 }
 
-static tstring
-ReadTextFile(Path path)
+tstring
+XML::ReadFile(Path path)
 {
   /* auto-detect the character encoding, to be able to parse XCSoar
      6.0 task files */
@@ -808,6 +808,6 @@ ReadTextFile(Path path)
 XMLNode
 XML::ParseFile(Path filename)
 {
-  const auto buffer = ReadTextFile(filename);
+  const auto buffer = ReadFile(filename);
   return ParseString(buffer.c_str());
 }
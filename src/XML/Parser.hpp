@@ -29,6 +29,8 @@
 #ifndef XCSOAR_XML_PARSER_HPP
 #define XCSOAR_XML_PARSER_HPP
 
+#include "util/tstring.hpp"
+
 #include <tchar.h>
 
 class XMLNode;
@@ -44,6 +46,15 @@ namespace XML {
    * Throws on error.
    */
   XMLNode ParseFile(Path path);
+
+  /**
+   * Read an XML file into a string, auto-detecting its character
+   * encoding.  This is the first step of ParseFile(); it can be
+   * combined with other parsers, e.g. XML::FlatDocument.
+   *
+   * Throws on error.
+   */
+  tstring ReadFile(Path path);
 }
 
 #endif
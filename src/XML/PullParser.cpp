@@ -0,0 +1,346 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "PullParser.hpp"
+#include "util/CharUtil.hxx"
+#include "util/StringAPI.hxx"
+#include "util/NumberParser.hpp"
+
+#ifndef _UNICODE
+#include "util/UTF8.hpp"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <cassert>
+
+namespace XML {
+
+[[gnu::const]]
+static constexpr bool
+IsNameChar(TCHAR ch) noexcept
+{
+  return !IsWhitespaceOrNull(ch) &&
+    ch != _T('/') && ch != _T('>') && ch != _T('<') &&
+    ch != _T('=') && ch != _T('"') && ch != _T('\'');
+}
+
+[[gnu::pure]]
+static bool
+StartsWith(const TCHAR *p, const TCHAR *end, TStringView prefix) noexcept
+{
+  return std::size_t(end - p) >= prefix.size &&
+    StringIsEqual(p, prefix.data, prefix.size);
+}
+
+inline void
+PullParser::SkipWhitespace() noexcept
+{
+  while (p != end && IsWhitespaceOrNull(*p))
+    ++p;
+}
+
+void
+PullParser::SkipPast(TStringView terminator)
+{
+  while (!StartsWith(p, end, terminator)) {
+    if (p == end)
+      throw std::runtime_error("Unterminated markup");
+    ++p;
+  }
+
+  p += terminator.size;
+}
+
+TStringView
+PullParser::ParseName()
+{
+  const TCHAR *start = p;
+  while (p != end && IsNameChar(*p))
+    ++p;
+
+  if (p == start)
+    throw std::runtime_error("Missing name");
+
+  return {start, p};
+}
+
+void
+PullParser::ParseAttributes()
+{
+  attributes.clear();
+
+  while (true) {
+    SkipWhitespace();
+    if (p == end)
+      throw std::runtime_error("Unterminated start tag");
+
+    if (*p == _T('>') || *p == _T('/'))
+      return;
+
+    Attribute attribute;
+    attribute.name = ParseName();
+
+    SkipWhitespace();
+    if (p == end || *p != _T('='))
+      throw std::runtime_error("Missing attribute value");
+
+    ++p;
+    SkipWhitespace();
+    if (p == end || (*p != _T('"') && *p != _T('\'')))
+      throw std::runtime_error("Attribute value not quoted");
+
+    const TCHAR quote = *p++;
+    const TCHAR *start = p;
+    while (p != end && *p != quote)
+      ++p;
+
+    if (p == end)
+      throw std::runtime_error("Unterminated attribute value");
+
+    attribute.value = {start, p};
+    ++p;
+
+    attributes.push_back(attribute);
+  }
+}
+
+PullParser::Event
+PullParser::ParseStartTag()
+{
+  name = ParseName();
+  ParseAttributes();
+
+  if (*p == _T('/')) {
+    ++p;
+    if (p == end || *p != _T('>'))
+      throw std::runtime_error("Malformed empty-element tag");
+
+    pending_end = true;
+  } else
+    stack.push_back(name);
+
+  assert(*p == _T('>'));
+  ++p;
+
+  return Event::START_ELEMENT;
+}
+
+PullParser::Event
+PullParser::ParseEndTag()
+{
+  name = ParseName();
+  SkipWhitespace();
+  if (p == end || *p != _T('>'))
+    throw std::runtime_error("Malformed end tag");
+
+  ++p;
+
+  if (stack.empty() || !stack.back().EqualsIgnoreCase(name))
+    throw std::runtime_error("Unmatched end tag");
+
+  stack.pop_back();
+  return Event::END_ELEMENT;
+}
+
+PullParser::Event
+PullParser::Next()
+{
+  if (pending_end) {
+    pending_end = false;
+    return Event::END_ELEMENT;
+  }
+
+  while (p != end) {
+    if (*p != _T('<')) {
+      const TCHAR *start = p;
+      bool blank = true;
+      for (; p != end && *p != _T('<'); ++p)
+        if (!IsWhitespaceOrNull(*p))
+          blank = false;
+
+      if (blank || stack.empty())
+        /* ignore whitespace and text outside of the root element */
+        continue;
+
+      text = {start, p};
+      text_escaped = true;
+      return Event::TEXT;
+    }
+
+    ++p;
+    if (p == end)
+      break;
+
+    switch (*p) {
+    case _T('/'):
+      ++p;
+      return ParseEndTag();
+
+    case _T('?'):
+      SkipPast(_T("?>"));
+      continue;
+
+    case _T('!'):
+      if (StartsWith(p, end, _T("!--"))) {
+        SkipPast(_T("-->"));
+      } else if (StartsWith(p, end, _T("![CDATA["))) {
+        p += 8;
+        const TCHAR *start = p;
+        SkipPast(_T("]]>"));
+
+        if (stack.empty())
+          continue;
+
+        text = {start, p - 3};
+        text_escaped = false;
+        return Event::TEXT;
+      } else
+        /* DOCTYPE (internal subsets are not supported) */
+        SkipPast(_T(">"));
+      continue;
+
+    default:
+      return ParseStartTag();
+    }
+  }
+
+  if (!stack.empty())
+    throw std::runtime_error("Unexpected end of file");
+
+  return Event::END;
+}
+
+TStringView
+PullParser::GetAttribute(TStringView _name) const noexcept
+{
+  for (const auto &i : attributes)
+    if (i.name.EqualsIgnoreCase(_name))
+      return i.value;
+
+  return nullptr;
+}
+
+void
+PullParser::SkipElement()
+{
+  unsigned depth = 1;
+  while (depth > 0) {
+    switch (Next()) {
+    case Event::START_ELEMENT:
+      ++depth;
+      break;
+
+    case Event::END_ELEMENT:
+      --depth;
+      break;
+
+    case Event::TEXT:
+      break;
+
+    case Event::END:
+      /* unreachable: Next() throws on premature end of file */
+      return;
+    }
+  }
+}
+
+/**
+ * Resolve a numeric character reference ("#123" or "#x7b", without
+ * the leading ampersand and the trailing semicolon).
+ */
+static TCHAR *
+UnescapeNumber(TStringView src, TCHAR *dest) noexcept
+{
+  assert(!src.empty() && src.front() == _T('#'));
+  src.pop_front();
+
+  int base = 10;
+  if (!src.empty() && (src.front() == _T('x') || src.front() == _T('X'))) {
+    src.pop_front();
+    base = 16;
+  }
+
+  if (src.empty())
+    return nullptr;
+
+  TCHAR *endptr;
+  const unsigned long ch = ParseUnsigned(src.data, &endptr, base);
+  if (endptr != src.data + src.size || ch > 0x10ffff)
+    return nullptr;
+
+  if (ch == 0) {
+    *dest++ = _T(' ');
+    return dest;
+  }
+
+#ifdef _UNICODE
+  *dest++ = (TCHAR)ch;
+  return dest;
+#else
+  return UnicodeToUTF8(ch, dest);
+#endif
+}
+
+TCHAR *
+Unescape(TStringView src, TCHAR *dest) noexcept
+{
+  while (!src.empty()) {
+    const TCHAR *amp = src.Find(_T('&'));
+    if (amp == nullptr) {
+      std::copy_n(src.data, src.size, dest);
+      return dest + src.size;
+    }
+
+    dest = std::copy(src.data, amp, dest);
+    src = src.substr(amp + 1);
+
+    const TCHAR *semicolon = src.Find(_T(';'));
+    if (semicolon == nullptr)
+      return nullptr;
+
+    const TStringView entity(src.data, semicolon);
+    src = src.substr(semicolon + 1);
+
+    if (entity.EqualsIgnoreCase(_T("lt")))
+      *dest++ = _T('<');
+    else if (entity.EqualsIgnoreCase(_T("gt")))
+      *dest++ = _T('>');
+    else if (entity.EqualsIgnoreCase(_T("amp")))
+      *dest++ = _T('&');
+    else if (entity.EqualsIgnoreCase(_T("apos")))
+      *dest++ = _T('\'');
+    else if (entity.EqualsIgnoreCase(_T("quot")))
+      *dest++ = _T('"');
+    else if (!entity.empty() && entity.front() == _T('#')) {
+      dest = UnescapeNumber(entity, dest);
+      if (dest == nullptr)
+        return nullptr;
+    } else
+      return nullptr;
+  }
+
+  return dest;
+}
+
+}
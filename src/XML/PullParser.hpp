@@ -0,0 +1,166 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_XML_PULL_PARSER_HPP
+#define XCSOAR_XML_PULL_PARSER_HPP
+
+#include "util/TStringView.hxx"
+
+#include <vector>
+
+#include <tchar.h>
+
+namespace XML {
+
+/**
+ * A non-validating streaming XML parser which operates on a memory
+ * buffer.  Unlike XML::ParseString(), it does not build a tree and
+ * does not copy anything: the caller pulls one event at a time and
+ * gets names, attribute values and text as views into the source
+ * buffer, which must remain valid while this object is used.
+ *
+ * Attribute values and text are "raw", i.e. entities have not been
+ * resolved; use Unescape() for that.  Comments, processing
+ * instructions (including the XML declaration) and DOCTYPE
+ * declarations are skipped.  End tags are matched
+ * case-insensitively, like XML::ParseString() does.
+ */
+class PullParser {
+public:
+  enum class Event {
+    START_ELEMENT,
+    END_ELEMENT,
+    TEXT,
+    END,
+  };
+
+  struct Attribute {
+    TStringView name, value;
+  };
+
+private:
+  const TCHAR *p;
+  const TCHAR *const end;
+
+  /**
+   * The names of all open elements.
+   */
+  std::vector<TStringView> stack;
+
+  /**
+   * The attributes of the current START_ELEMENT.
+   */
+  std::vector<Attribute> attributes;
+
+  TStringView name, text;
+
+  /**
+   * Does the current TEXT need to be unescaped?  This is false for
+   * CDATA sections.
+   */
+  bool text_escaped;
+
+  /**
+   * Was the current element an empty-element tag ("<foo/>")?  If
+   * yes, then the next event is its END_ELEMENT.
+   */
+  bool pending_end = false;
+
+public:
+  explicit PullParser(TStringView src) noexcept
+    :p(src.data), end(src.data + src.size) {}
+
+  PullParser(const PullParser &) = delete;
+  PullParser &operator=(const PullParser &) = delete;
+
+  /**
+   * Parse the next event.  Whitespace-only text is skipped.
+   *
+   * Throws std::runtime_error on syntax error.
+   */
+  Event Next();
+
+  /**
+   * The name of the current element (START_ELEMENT and END_ELEMENT).
+   */
+  TStringView GetName() const noexcept {
+    return name;
+  }
+
+  /**
+   * The attributes of the current element (START_ELEMENT only).
+   */
+  const std::vector<Attribute> &GetAttributes() const noexcept {
+    return attributes;
+  }
+
+  /**
+   * Look up an attribute of the current element (START_ELEMENT only)
+   * by its case-insensitive name.
+   *
+   * @return the raw value or nullptr if there is no such attribute
+   */
+  [[gnu::pure]]
+  TStringView GetAttribute(TStringView name) const noexcept;
+
+  /**
+   * The text of the current TEXT event.
+   */
+  TStringView GetText() const noexcept {
+    return text;
+  }
+
+  bool IsTextEscaped() const noexcept {
+    return text_escaped;
+  }
+
+  /**
+   * Skip the rest of the current element, including all of its
+   * children.  Call this after START_ELEMENT; the next call to Next()
+   * returns the event after its END_ELEMENT.
+   */
+  void SkipElement();
+
+private:
+  Event ParseStartTag();
+  Event ParseEndTag();
+  void ParseAttributes();
+  TStringView ParseName();
+  void SkipWhitespace() noexcept;
+  void SkipPast(TStringView terminator);
+};
+
+/**
+ * Resolve the entities in a raw attribute value or text.  The
+ * destination buffer must have room for at least src.size
+ * characters; resolving entities never makes the string longer.  The
+ * result is not null-terminated.
+ *
+ * @return the end of the result or nullptr on error (unknown or
+ * malformed entity)
+ */
+TCHAR *
+Unescape(TStringView src, TCHAR *dest) noexcept;
+
+}
+
+#endif
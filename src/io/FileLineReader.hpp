@@ -24,16 +24,16 @@ Copyright_License {
 #ifndef XCSOAR_IO_FILE_LINE_READER_HPP
 #define XCSOAR_IO_FILE_LINE_READER_HPP
 
-#include "FileReader.hxx"
+#include "ReadAheadReader.hpp"
 #include "BufferedReader.hxx"
 #include "ConvertLineReader.hpp"
 
 /**
- * Glue class which combines FileReader and BufferedReader, and provides
- * a public NLineReader interface.
+ * Glue class which combines ReadAheadReader and BufferedReader, and
+ * provides a public NLineReader interface.
  */
 class FileLineReaderA : public NLineReader {
-  FileReader file;
+  ReadAheadReader file;
   BufferedReader buffered;
 
 public:
@@ -137,6 +137,16 @@ FileOutputStream::Write(const void *data, size_t size)
 				      GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (!FlushFileBuffers(handle))
+		throw FormatLastError("Failed to sync %s",
+				      GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -247,6 +257,15 @@ FileOutputStream::Write(const void *data, size_t size)
 				  GetPath().c_str());
 }
 
+void
+FileOutputStream::Sync()
+{
+	assert(IsDefined());
+
+	if (fsync(fd.Get()) < 0)
+		throw FormatErrno("Failed to sync %s", GetPath().c_str());
+}
+
 void
 FileOutputStream::Commit()
 {
@@ -136,6 +136,12 @@ public:
 	/* virtual methods from class OutputStream */
 	void Write(const void *data, size_t size) override;
 
+	/**
+	 * Ask the operating system to write all data to the physical
+	 * device.  Throws on error.
+	 */
+	void Sync();
+
 	void Commit();
 	void Cancel() noexcept;
 
@@ -0,0 +1,91 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ReadAheadReader.hpp"
+
+#ifdef HAVE_URING_READ_AHEAD
+#include "uring/ReadAhead.hpp"
+
+#include <atomic>
+#include <system_error>
+
+/**
+ * Set after io_uring setup has failed once, to avoid retrying for
+ * each file.
+ */
+static std::atomic<bool> uring_unavailable{false};
+#endif
+
+ReadAheadReader::ReadAheadReader(Path path)
+  :file(path)
+{
+#ifdef HAVE_URING_READ_AHEAD
+  if (!uring_unavailable.load(std::memory_order_relaxed) &&
+      file.GetSize() >= MIN_ASYNC_SIZE) {
+    try {
+      read_ahead = std::make_unique<Uring::ReadAhead>(file.GetFD());
+    } catch (const std::system_error &) {
+      /* probably ENOSYS (kernel too old) or EPERM (disabled by
+         sysctl or seccomp); use the synchronous FileReader */
+      uring_unavailable.store(true, std::memory_order_relaxed);
+    }
+  }
+#endif
+}
+
+ReadAheadReader::~ReadAheadReader() noexcept = default;
+
+uint64_t
+ReadAheadReader::GetPosition() const noexcept
+{
+#ifdef HAVE_URING_READ_AHEAD
+  if (read_ahead)
+    return read_ahead->GetPosition();
+#endif
+
+  return file.GetPosition();
+}
+
+void
+ReadAheadReader::Rewind()
+{
+#ifdef HAVE_URING_READ_AHEAD
+  if (read_ahead) {
+    read_ahead->Seek(0);
+    return;
+  }
+#endif
+
+  file.Rewind();
+}
+
+size_t
+ReadAheadReader::Read(void *data, size_t size)
+{
+#ifdef HAVE_URING_READ_AHEAD
+  if (read_ahead)
+    return read_ahead->Read(data, size);
+#endif
+
+  return file.Read(data, size);
+}
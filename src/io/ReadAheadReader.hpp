@@ -0,0 +1,89 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_READ_AHEAD_READER_HPP
+#define XCSOAR_IO_READ_AHEAD_READER_HPP
+
+#include "Reader.hxx"
+#include "FileReader.hxx"
+#include "uring/Features.h"
+
+#include <cstdint>
+#include <memory>
+
+class Path;
+namespace Uring { class ReadAhead; }
+
+/**
+ * A #Reader for regular files which are read sequentially from start
+ * to end.  Large files are read with io_uring, keeping several
+ * requests in flight; if the kernel does not support io_uring (or on
+ * other operating systems), this falls back to plain #FileReader.
+ */
+class ReadAheadReader final : public Reader {
+  /**
+   * Files smaller than this are read synchronously; setting up an
+   * io_uring would cost more than it saves.
+   */
+  static constexpr uint64_t MIN_ASYNC_SIZE = 256 * 1024;
+
+  FileReader file;
+
+#ifdef HAVE_URING_READ_AHEAD
+  std::unique_ptr<Uring::ReadAhead> read_ahead;
+#endif
+
+public:
+  /**
+   * Throws std::runtime_error on error.
+   */
+  explicit ReadAheadReader(Path path);
+
+  ~ReadAheadReader() noexcept;
+
+  /**
+   * Does this object use io_uring?
+   */
+  bool IsAsync() const noexcept {
+#ifdef HAVE_URING_READ_AHEAD
+    return read_ahead != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  [[gnu::pure]]
+  uint64_t GetSize() const noexcept {
+    return file.GetSize();
+  }
+
+  [[gnu::pure]]
+  uint64_t GetPosition() const noexcept;
+
+  void Rewind();
+
+  /* virtual methods from class Reader */
+  size_t Read(void *data, size_t size) override;
+};
+
+#endif
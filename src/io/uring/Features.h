@@ -1 +1,9 @@
-// empty file, because XCSoar doesn't use io_uring
+/* the event loop doesn't use io_uring (HAVE_URING is never defined),
+   but large files are read with io_uring read-ahead where available,
+   see io/ReadAheadReader.hpp */
+
+#if defined(__linux__) && !defined(ANDROID) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define HAVE_URING_READ_AHEAD
+#endif
+#endif
@@ -0,0 +1,183 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ReadAhead.hpp"
+
+#ifdef HAVE_URING_READ_AHEAD
+
+#include "system/Error.hxx"
+
+#include <algorithm>
+#include <cassert>
+
+#include <linux/io_uring.h>
+#include <string.h>
+
+namespace Uring {
+
+ReadAhead::ReadAhead(FileDescriptor _fd)
+  :ring(N_SLOTS), fd(_fd)
+{
+  for (auto &slot : slots) {
+    slot.buffer.reset(new std::byte[SLOT_SIZE]);
+    slot.iov.iov_base = slot.buffer.get();
+    slot.iov.iov_len = SLOT_SIZE;
+  }
+
+  Restart(0);
+}
+
+ReadAhead::~ReadAhead() noexcept
+{
+  try {
+    Drain();
+  } catch (...) {
+    /* the kernel has failed to tell us about the completion; better
+       leak the buffers than risk a use-after-free */
+    for (auto &slot : slots)
+      if (slot.in_flight)
+        slot.buffer.release();
+  }
+}
+
+void
+ReadAhead::SubmitSlot(unsigned i)
+{
+  Slot &slot = slots[i];
+  assert(!slot.in_flight);
+
+  struct io_uring_sqe *sqe = ring.GetSubmitEntry();
+  assert(sqe != nullptr);
+
+  /* IORING_OP_READV is supported by all io_uring kernels, unlike
+     IORING_OP_READ which needs Linux 5.6 */
+  sqe->opcode = IORING_OP_READV;
+  sqe->fd = fd.Get();
+  sqe->addr = (uint64_t)(uintptr_t)&slot.iov;
+  sqe->len = 1;
+  sqe->off = next_offset;
+  sqe->user_data = i;
+
+  slot.offset = next_offset;
+  slot.in_flight = true;
+  slot.done = false;
+
+  next_offset += SLOT_SIZE;
+}
+
+void
+ReadAhead::WaitSlot(unsigned i)
+{
+  while (!slots[i].done) {
+    uint64_t user_data;
+    const int result = ring.WaitCompletion(user_data);
+
+    assert(user_data < N_SLOTS);
+    Slot &slot = slots[user_data];
+    assert(slot.in_flight);
+
+    slot.result = result;
+    slot.in_flight = false;
+    slot.done = true;
+  }
+}
+
+void
+ReadAhead::Drain()
+{
+  for (unsigned i = 0; i < N_SLOTS; ++i)
+    if (slots[i].in_flight)
+      WaitSlot(i);
+}
+
+void
+ReadAhead::Restart(uint64_t offset)
+{
+  Drain();
+
+  next_offset = position = offset;
+  current = 0;
+  consumed = 0;
+  eof = false;
+
+  for (unsigned i = 0; i < N_SLOTS; ++i)
+    SubmitSlot(i);
+
+  ring.Submit();
+}
+
+void
+ReadAhead::Seek(uint64_t offset)
+{
+  if (offset != position)
+    Restart(offset);
+}
+
+std::size_t
+ReadAhead::Read(void *data, std::size_t size)
+{
+  while (!eof) {
+    Slot &slot = slots[current];
+    WaitSlot(current);
+
+    if (slot.result < 0)
+      throw MakeErrno(-slot.result, "Failed to read");
+
+    const std::size_t available = slot.result - consumed;
+    if (available > 0) {
+      const std::size_t n = std::min(size, available);
+      memcpy(data, slot.buffer.get() + consumed, n);
+      consumed += n;
+      position += n;
+      return n;
+    }
+
+    /* this slot is exhausted */
+
+    if (slot.result == 0) {
+      eof = true;
+      break;
+    }
+
+    if (std::size_t(slot.result) < SLOT_SIZE) {
+      /* short read: the following requests were submitted for the
+         wrong offsets; start over right after this block (usually,
+         this finds the end of the file) */
+      Restart(slot.offset + slot.result);
+      continue;
+    }
+
+    /* recycle the slot for the next block */
+    SubmitSlot(current);
+    ring.Submit();
+
+    current = (current + 1) % N_SLOTS;
+    consumed = 0;
+  }
+
+  return 0;
+}
+
+} // namespace Uring
+
+#endif
@@ -0,0 +1,154 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_URING_READ_AHEAD_HPP
+#define XCSOAR_IO_URING_READ_AHEAD_HPP
+
+#include "Features.h"
+
+#ifdef HAVE_URING_READ_AHEAD
+
+#include "Ring.hpp"
+#include "io/FileDescriptor.hxx"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include <sys/uio.h>
+
+namespace Uring {
+
+/**
+ * Read a file sequentially, keeping several io_uring read requests
+ * in flight, so the kernel can fetch the next blocks while the
+ * caller parses the current one.
+ */
+class ReadAhead {
+  static constexpr unsigned N_SLOTS = 4;
+  static constexpr std::size_t SLOT_SIZE = 64 * 1024;
+
+  struct Slot {
+    std::unique_ptr<std::byte[]> buffer;
+    struct iovec iov;
+
+    uint64_t offset;
+
+    /**
+     * The number of bytes read (or a negative errno value); only
+     * valid if #done is set.
+     */
+    int result;
+
+    bool in_flight = false, done = false;
+  };
+
+  Ring ring;
+
+  const FileDescriptor fd;
+
+  std::array<Slot, N_SLOTS> slots;
+
+  /**
+   * The slot which is being consumed by Read().
+   */
+  unsigned current = 0;
+
+  /**
+   * The number of bytes of the #current slot which have been
+   * consumed already.
+   */
+  std::size_t consumed = 0;
+
+  /**
+   * The file offset of the next request to be submitted.
+   */
+  uint64_t next_offset = 0;
+
+  /**
+   * The file offset of the next byte returned by Read().
+   */
+  uint64_t position = 0;
+
+  bool eof = false;
+
+public:
+  /**
+   * Throws std::system_error if io_uring is not available.
+   *
+   * @param _fd the file to be read; it must remain open as long as
+   * this object exists
+   */
+  explicit ReadAhead(FileDescriptor _fd);
+
+  /**
+   * Waits for all pending requests, because the kernel may still
+   * write to the buffers.
+   */
+  ~ReadAhead() noexcept;
+
+  ReadAhead(const ReadAhead &) = delete;
+  ReadAhead &operator=(const ReadAhead &) = delete;
+
+  uint64_t GetPosition() const noexcept {
+    return position;
+  }
+
+  /**
+   * Throws std::system_error on error.
+   */
+  void Seek(uint64_t offset);
+
+  /**
+   * Throws std::system_error on error.
+   *
+   * @return the number of bytes copied to #data, 0 at the end of
+   * the file
+   */
+  std::size_t Read(void *data, std::size_t size);
+
+private:
+  void SubmitSlot(unsigned i);
+
+  /**
+   * Wait until the specified slot has completed.
+   */
+  void WaitSlot(unsigned i);
+
+  /**
+   * Wait for all requests in flight, discarding the data.
+   */
+  void Drain();
+
+  /**
+   * Discard all buffered data and start reading at the specified
+   * offset.
+   */
+  void Restart(uint64_t offset);
+};
+
+} // namespace Uring
+
+#endif
+
+#endif
@@ -0,0 +1,215 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Ring.hpp"
+
+#ifdef HAVE_URING_READ_AHEAD
+
+#include "system/Error.hxx"
+
+#include <algorithm>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+namespace Uring {
+
+static void *
+MapRing(int fd, std::size_t size, off_t offset)
+{
+  void *p = mmap(nullptr, size, PROT_READ|PROT_WRITE,
+                 MAP_SHARED|MAP_POPULATE, fd, offset);
+  if (p == MAP_FAILED)
+    throw MakeErrno("Failed to map io_uring");
+
+  return p;
+}
+
+template<typename T>
+static T *
+RingPointer(void *ring, unsigned offset) noexcept
+{
+  return (T *)((std::byte *)ring + offset);
+}
+
+Ring::Ring(unsigned entries)
+{
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  int result = syscall(__NR_io_uring_setup, entries, &params);
+  if (result < 0)
+    throw MakeErrno("io_uring_setup() failed");
+
+  fd = UniqueFileDescriptor(result);
+
+  sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size = params.cq_off.cqes +
+    params.cq_entries * sizeof(struct io_uring_cqe);
+
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap)
+    sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+  try {
+    sq_ring = MapRing(fd.Get(), sq_ring_size, IORING_OFF_SQ_RING);
+    cq_ring = single_mmap
+      ? sq_ring
+      : MapRing(fd.Get(), cq_ring_size, IORING_OFF_CQ_RING);
+
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes = (struct io_uring_sqe *)MapRing(fd.Get(), sqes_size,
+                                          IORING_OFF_SQES);
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+
+  sq_head = RingPointer<unsigned>(sq_ring, params.sq_off.head);
+  sq_tail = RingPointer<unsigned>(sq_ring, params.sq_off.tail);
+  sq_mask = *RingPointer<unsigned>(sq_ring, params.sq_off.ring_mask);
+  sq_array = RingPointer<unsigned>(sq_ring, params.sq_off.array);
+
+  cq_head = RingPointer<unsigned>(cq_ring, params.cq_off.head);
+  cq_tail = RingPointer<unsigned>(cq_ring, params.cq_off.tail);
+  cq_mask = *RingPointer<unsigned>(cq_ring, params.cq_off.ring_mask);
+  cqes = RingPointer<struct io_uring_cqe>(cq_ring, params.cq_off.cqes);
+}
+
+Ring::~Ring() noexcept
+{
+  Unmap();
+}
+
+void
+Ring::Unmap() noexcept
+{
+  if (sqes != nullptr)
+    munmap(sqes, sqes_size);
+
+  if (cq_ring != nullptr && cq_ring != sq_ring)
+    munmap(cq_ring, cq_ring_size);
+
+  if (sq_ring != nullptr)
+    munmap(sq_ring, sq_ring_size);
+}
+
+int
+Ring::Enter(unsigned to_submit, unsigned min_complete,
+            unsigned flags) noexcept
+{
+  return syscall(__NR_io_uring_enter, fd.Get(), to_submit, min_complete,
+                 flags, nullptr, 0);
+}
+
+struct io_uring_sqe *
+Ring::GetSubmitEntry() noexcept
+{
+  /* only this thread modifies the tail; the kernel modifies the
+     head */
+  const unsigned tail = *sq_tail + n_prepared;
+  const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+  if (tail - head > sq_mask)
+    return nullptr;
+
+  const unsigned index = tail & sq_mask;
+  sq_array[index] = index;
+
+  struct io_uring_sqe *sqe = &sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+
+  ++n_prepared;
+  return sqe;
+}
+
+void
+Ring::Submit()
+{
+  if (n_prepared > 0) {
+    /* publish the new entries to the kernel */
+    __atomic_store_n(sq_tail, *sq_tail + n_prepared, __ATOMIC_RELEASE);
+    n_unsubmitted += n_prepared;
+    n_prepared = 0;
+  }
+
+  while (n_unsubmitted > 0) {
+    int result = Enter(n_unsubmitted, 0, 0);
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+
+      if ((errno == EAGAIN || errno == EBUSY) && n_in_flight > 0)
+        /* the kernel is out of resources or the completion queue is
+           full; reaping completions will fix this, and
+           WaitCompletion() will try again */
+        return;
+
+      throw MakeErrno("io_uring_enter() failed");
+    }
+
+    if (result == 0) {
+      /* no progress; don't spin, but retry after the next
+         completion */
+      if (n_in_flight > 0)
+        return;
+
+      throw MakeErrno(EAGAIN, "io_uring_enter() did not submit");
+    }
+
+    const unsigned n = std::min(unsigned(result), n_unsubmitted);
+    n_unsubmitted -= n;
+    n_in_flight += n;
+  }
+}
+
+int
+Ring::WaitCompletion(uint64_t &user_data)
+{
+  Submit();
+
+  while (true) {
+    const unsigned head = *cq_head;
+    if (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+      const struct io_uring_cqe &cqe = cqes[head & cq_mask];
+      user_data = cqe.user_data;
+      const int res = cqe.res;
+      __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+
+      if (n_in_flight > 0)
+        --n_in_flight;
+
+      return res;
+    }
+
+    if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+      throw MakeErrno("io_uring_enter() failed");
+  }
+}
+
+} // namespace Uring
+
+#endif
@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_URING_RING_HPP
+#define XCSOAR_IO_URING_RING_HPP
+
+#include "Features.h"
+
+#ifdef HAVE_URING_READ_AHEAD
+
+#include "io/UniqueFileDescriptor.hxx"
+
+#include <cstddef>
+#include <cstdint>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace Uring {
+
+/**
+ * A minimal io_uring instance, talking to the kernel directly (without
+ * liburing).  It is meant to be used by one thread which submits
+ * requests and waits for their completion.
+ */
+class Ring {
+  UniqueFileDescriptor fd;
+
+  void *sq_ring = nullptr, *cq_ring = nullptr;
+  std::size_t sq_ring_size, cq_ring_size;
+
+  struct io_uring_sqe *sqes = nullptr;
+  std::size_t sqes_size;
+
+  unsigned *sq_head, *sq_tail, *sq_array;
+  unsigned sq_mask;
+
+  unsigned *cq_head, *cq_tail;
+  unsigned cq_mask;
+  struct io_uring_cqe *cqes;
+
+  /**
+   * The number of submission queue entries which have been
+   * prepared, but not yet published in the submission ring.
+   */
+  unsigned n_prepared = 0;
+
+  /**
+   * The number of entries which have been published in the
+   * submission ring, but not yet consumed by io_uring_enter().
+   */
+  unsigned n_unsubmitted = 0;
+
+  /**
+   * The number of requests which have been consumed by the kernel,
+   * but whose completion has not yet been reaped.
+   */
+  unsigned n_in_flight = 0;
+
+public:
+  /**
+   * Throws std::system_error on error (e.g. ENOSYS if the kernel
+   * does not support io_uring).
+   */
+  explicit Ring(unsigned entries);
+
+  ~Ring() noexcept;
+
+  Ring(const Ring &) = delete;
+  Ring &operator=(const Ring &) = delete;
+
+  /**
+   * Obtain a cleared submission queue entry.  Call Submit() to pass
+   * it to the kernel.
+   *
+   * @return nullptr if the submission queue is full
+   */
+  struct io_uring_sqe *GetSubmitEntry() noexcept;
+
+  /**
+   * Pass all prepared submission queue entries to the kernel.  If
+   * the kernel doesn't accept all of them right now (e.g. EAGAIN or
+   * EBUSY) while requests are in flight, the rest is left in the
+   * ring and retried by the next Submit() or WaitCompletion() call,
+   * after completions have been reaped.
+   *
+   * Throws std::system_error on error.
+   */
+  void Submit();
+
+  /**
+   * Submit all prepared entries and wait for one completion.
+   *
+   * Throws std::system_error on error.
+   *
+   * @param user_data receives the "user_data" value of the
+   * completed request
+   * @return the "res" value of the completed request (negative
+   * errno on error)
+   */
+  int WaitCompletion(uint64_t &user_data);
+
+private:
+  void Unmap() noexcept;
+
+  int Enter(unsigned to_submit, unsigned min_complete,
+            unsigned flags) noexcept;
+};
+
+} // namespace Uring
+
+#endif
+
+#endif
@@ -58,8 +58,10 @@ FileMapping::FileMapping(Path path)
   m_size = (size_t)st.st_size;
 
   m_data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd.Get(), 0);
-  if (m_data == nullptr)
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
     throw FormatErrno("Failed to map %s", path.c_str());
+  }
 
   madvise(m_data, m_size, MADV_WILLNEED);
 #else /* !HAVE_POSIX */
@@ -32,6 +32,8 @@ Copyright_License {
 
 #ifdef USE_FREETYPE
 typedef struct FT_FaceRec_ *FT_Face;
+class GlyphAtlas;
+struct GlyphQuad;
 #endif
 
 #ifdef _WIN32
@@ -51,6 +53,11 @@ class Font {
 protected:
 #ifdef USE_FREETYPE
   FT_Face face = nullptr;
+
+  /**
+   * Caches the rendered glyphs of this font.
+   */
+  GlyphAtlas *atlas = nullptr;
 #elif defined(ANDROID)
   TextUtil *text_util_object = nullptr;
 
@@ -134,6 +141,25 @@ public:
   }
 #endif
 
+#ifdef USE_FREETYPE
+  GlyphAtlas &GetGlyphAtlas() const noexcept {
+    return *atlas;
+  }
+
+  /**
+   * Lay out the string with glyphs from the #GlyphAtlas.
+   *
+   * @param quads an array which receives one element per visible
+   * glyph
+   * @param max the size of the #quads array
+   * @return the number of quads or -1 if at least one glyph is not
+   * stored in the atlas (the caller shall then fall back to
+   * Render())
+   */
+  int LayoutGlyphs(TStringView text,
+                   GlyphQuad *quads, unsigned max) const noexcept;
+#endif
+
   unsigned GetHeight() const noexcept {
     return height;
   }
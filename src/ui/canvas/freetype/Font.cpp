@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "ui/canvas/Font.hpp"
+#include "GlyphAtlas.hpp"
 #include "Screen/Debug.hpp"
 #include "ui/canvas/custom/Files.hpp"
 #include "Look/FontDescription.hpp"
@@ -181,6 +182,7 @@ Font::LoadFile(const char *file, unsigned ptsize, bool bold, bool italic)
   // TODO: handle bold/italic
 
   face = new_face;
+  atlas = new GlyphAtlas(height);
   return true;
 }
 
@@ -226,6 +228,9 @@ Font::Destroy() noexcept
 
   assert(IsScreenInitialized());
 
+  delete atlas;
+  atlas = nullptr;
+
   ::FT_Done_Face(face);
   face = nullptr;
 }
@@ -245,10 +250,100 @@ ForEachChar(TStringView text, F &&f)
   }
 }
 
+static void
+ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
+{
+  for (; n >= 8; n -= 8, ++src) {
+    for (unsigned i = 0x80; i != 0; i >>= 1)
+      *dest++ = (*src & i) ? 0xff : 0x00;
+  }
+
+  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
+    *dest++ = (*src & i) ? 0xff : 0x00;
+}
+
+static void
+ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
+{
+  dest = src;
+  dest.pitch = dest.width;
+  dest.buffer = new unsigned char[dest.pitch * dest.rows];
+
+  unsigned char *d = dest.buffer, *s = src.buffer;
+  for (unsigned y = 0; y < unsigned(dest.rows);
+       ++y, d += dest.pitch, s += src.pitch)
+    ConvertMono(d, s, dest.width);
+}
+
+/**
+ * Render the glyph which was loaded into the face's glyph slot and
+ * pass an 8 bit alpha bitmap to the given function.
+ */
+template<typename F>
+static void
+RenderGlyphBitmap(FT_GlyphSlot glyph, F &&f) noexcept
+{
+  FT_Error error = FT_Render_Glyph(glyph, render_mode);
+  if (error)
+    return;
+
+  if (IsMono()) {
+    /* with anti-aliasing disabled, FreeType writes each pixel in one
+       bit; hack: convert it to 1 byte per pixel */
+    FT_Bitmap bitmap;
+    ConvertMono(bitmap, glyph->bitmap);
+    f(bitmap);
+    delete[] bitmap.buffer;
+  } else
+    f(glyph->bitmap);
+}
+
+/**
+ * Look up the glyph in the #GlyphAtlas; on a miss, load it with
+ * FreeType and add it to the atlas.
+ */
+static const GlyphAtlas::Glyph &
+GetGlyph(FT_Face face, unsigned ascent_height,
+         GlyphAtlas &atlas, unsigned ch) noexcept
+{
+  const GlyphAtlas::Glyph *cached = atlas.Lookup(ch);
+  if (cached != nullptr)
+    return *cached;
+
+  GlyphAtlas::Glyph glyph{};
+
+  const FT_UInt i = FT_Get_Char_Index(face, ch);
+  if (i == 0 || FT_Load_Glyph(face, i, load_flags) != 0)
+    /* remember that this character cannot be rendered */
+    return atlas.Add(ch, glyph, nullptr, 0);
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Glyph_Metrics &metrics = slot->metrics;
+
+  glyph.index = i;
+  glyph.left = FT_FLOOR(metrics.horiBearingX);
+  glyph.top = ascent_height - FT_FLOOR(metrics.horiBearingY);
+  glyph.advance = FT_CEIL(metrics.horiAdvance);
+  glyph.right = glyph.left + FT_CEIL(metrics.width);
+
+  const GlyphAtlas::Glyph *result = nullptr;
+  RenderGlyphBitmap(slot, [&](const FT_Bitmap &bitmap){
+    glyph.width = bitmap.width;
+    glyph.height = bitmap.rows;
+    result = &atlas.Add(ch, glyph, bitmap.buffer, bitmap.pitch);
+  });
+
+  if (result == nullptr)
+    /* rendering has failed; cache only the metrics */
+    result = &atlas.Add(ch, glyph, nullptr, 0);
+
+  return *result;
+}
+
 template<typename T, typename F>
 static void
-ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
-             F &&f) noexcept
+ForEachGlyph(const FT_Face face, unsigned ascent_height, GlyphAtlas &atlas,
+             T &&text, F &&f) noexcept
 {
   const bool use_kerning = FT_HAS_KERNING(face);
 
@@ -260,35 +355,27 @@ ForEachGlyph(const FT_Face face, unsigned ascent_height, T &&text,
 #endif
 
   ForEachChar(std::forward<T>(text),
-              [face, ascent_height, &f, use_kerning,
+              [face, ascent_height, &atlas, &f, use_kerning,
                &x, &prev_index](unsigned ch){
-      const FT_UInt i = FT_Get_Char_Index(face, ch);
-      if (i == 0)
-        return;
-
-      const FT_Error error = FT_Load_Glyph(face, i, load_flags);
-      if (error)
+      const GlyphAtlas::Glyph &glyph =
+        GetGlyph(face, ascent_height, atlas, ch);
+      if (glyph.index == 0)
         return;
 
-      const FT_GlyphSlot glyph = face->glyph;
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-
       if (use_kerning) {
-        if (prev_index != 0 && i != 0) {
+        if (prev_index != 0) {
           FT_Vector delta;
-          FT_Get_Kerning(face, prev_index, i, ft_kerning_default,
+          FT_Get_Kerning(face, prev_index, glyph.index, ft_kerning_default,
                          &delta);
           x += delta.x >> 6;
         }
 
-        prev_index = i;
+        prev_index = glyph.index;
       }
 
-      f(x + FT_FLOOR(metrics.horiBearingX),
-        ascent_height - FT_FLOOR(metrics.horiBearingY),
-        glyph);
+      f(x, glyph);
 
-      x += FT_CEIL(metrics.horiAdvance);
+      x += glyph.advance;
     });
 }
 
@@ -297,13 +384,9 @@ Font::TextSize(TStringView text) const noexcept
 {
   int maxx = 0;
 
-  ForEachGlyph(face, ascent_height, text,
-               [&maxx](int x, int y, const FT_GlyphSlot glyph){
-      const FT_Glyph_Metrics &metrics = glyph->metrics;
-      const int glyph_minx = FT_FLOOR(metrics.horiBearingX);
-      const int glyph_maxx = glyph_minx + FT_CEIL(metrics.width);
-
-      int z = x + glyph_maxx;
+  ForEachGlyph(face, ascent_height, *atlas, text,
+               [&maxx](int x, const GlyphAtlas::Glyph &glyph){
+      int z = x + glyph.right;
       if (z > maxx)
         maxx = z;
     });
@@ -311,6 +394,34 @@ Font::TextSize(TStringView text) const noexcept
   return PixelSize{unsigned(maxx), height};
 }
 
+int
+Font::LayoutGlyphs(TStringView text,
+                   GlyphQuad *quads, unsigned max) const noexcept
+{
+  unsigned n = 0;
+  bool complete = true;
+
+  ForEachGlyph(face, ascent_height, *atlas, text,
+               [quads, max, &n, &complete](int x,
+                                           const GlyphAtlas::Glyph &glyph){
+      if (glyph.IsEmpty())
+        return;
+
+      if (!glyph.in_atlas || n >= max) {
+        complete = false;
+        return;
+      }
+
+      const PixelPoint position(x + glyph.left, glyph.top);
+      quads[n++] = {
+        PixelRect{position, PixelSize(glyph.width, glyph.height)},
+        glyph.GetSourceRect(),
+      };
+    });
+
+  return complete ? int(n) : -1;
+}
+
 static void
 MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 {
@@ -321,12 +432,9 @@ MixLine(uint8_t *dest, const uint8_t *src, size_t n) noexcept
 
 static void
 RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
-            const FT_Bitmap &bitmap, int x, int y) noexcept
+            const uint8_t *src, int width, int height, int pitch,
+            int x, int y) noexcept
 {
-  const uint8_t *src = (const uint8_t *)bitmap.buffer;
-  int width = bitmap.width, height = bitmap.rows;
-  int pitch = bitmap.pitch;
-
   if (x < 0) {
     src -= x;
     width += x;
@@ -357,50 +465,6 @@ RenderGlyph(uint8_t *buffer, unsigned buffer_width, unsigned buffer_height,
     MixLine(buffer, src, width);
 }
 
-static void
-ConvertMono(unsigned char *dest, const unsigned char *src, unsigned n) noexcept
-{
-  for (; n >= 8; n -= 8, ++src) {
-    for (unsigned i = 0x80; i != 0; i >>= 1)
-      *dest++ = (*src & i) ? 0xff : 0x00;
-  }
-
-  for (unsigned i = 0x80; n > 0; i >>= 1, --n)
-    *dest++ = (*src & i) ? 0xff : 0x00;
-}
-
-static void
-ConvertMono(FT_Bitmap &dest, const FT_Bitmap &src) noexcept
-{
-  dest = src;
-  dest.pitch = dest.width;
-  dest.buffer = new unsigned char[dest.pitch * dest.rows];
-
-  unsigned char *d = dest.buffer, *s = src.buffer;
-  for (unsigned y = 0; y < unsigned(dest.rows);
-       ++y, d += dest.pitch, s += src.pitch)
-    ConvertMono(d, s, dest.width);
-}
-
-static void
-RenderGlyph(uint8_t *buffer, size_t width, size_t height,
-            FT_GlyphSlot glyph, int x, int y) noexcept
-{
-  FT_Error error = FT_Render_Glyph(glyph, render_mode);
-  if (error)
-    return;
-
-  if (IsMono()) {
-    /* with anti-aliasing disabled, FreeType writes each pixel in one
-       bit; hack: convert it to 1 byte per pixel and then render it */
-    FT_Bitmap bitmap;
-    ConvertMono(bitmap, glyph->bitmap);
-    RenderGlyph(buffer, width, height, bitmap, x, y);
-    delete[] bitmap.buffer;
-  } else
-    RenderGlyph(buffer, width, height, glyph->bitmap, x, y);
-}
-
 void
 Font::Render(TStringView text, const PixelSize size,
              void *_buffer) const noexcept
@@ -408,9 +472,34 @@ Font::Render(TStringView text, const PixelSize size,
   uint8_t *buffer = (uint8_t *)_buffer;
   std::fill_n(buffer, BufferSize(size), 0);
 
-  ForEachGlyph(face, ascent_height, text,
-               [size, buffer](int x, int y, const FT_GlyphSlot glyph){
-      RenderGlyph(buffer, size.width, size.height, glyph,
-                  x, y);
+  const FT_Face face = this->face;
+  GlyphAtlas &atlas = *this->atlas;
+
+  ForEachGlyph(face, ascent_height, atlas, text,
+               [face, &atlas, size, buffer](int x,
+                                            const GlyphAtlas::Glyph &glyph){
+      if (glyph.IsEmpty())
+        return;
+
+      const int gx = x + glyph.left, gy = glyph.top;
+
+      if (glyph.in_atlas) {
+        RenderGlyph(buffer, size.width, size.height,
+                    atlas.GetBitmap(glyph),
+                    glyph.width, glyph.height, atlas.GetPitch(),
+                    gx, gy);
+        return;
+      }
+
+      /* the atlas is full: render this glyph with FreeType */
+      if (FT_Load_Glyph(face, glyph.index, load_flags) != 0)
+        return;
+
+      RenderGlyphBitmap(face->glyph, [&](const FT_Bitmap &bitmap){
+        RenderGlyph(buffer, size.width, size.height,
+                    (const uint8_t *)bitmap.buffer,
+                    bitmap.width, bitmap.rows, bitmap.pitch,
+                    gx, gy);
+      });
     });
 }
@@ -0,0 +1,173 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "GlyphAtlas.hpp"
+
+#ifdef ENABLE_OPENGL
+#include "ui/canvas/opengl/Texture.hpp"
+#endif
+
+#include <algorithm>
+
+#include <string.h>
+
+GlyphAtlas::Stats GlyphAtlas::stats;
+
+static constexpr unsigned
+NextPowerOfTwo(unsigned i) noexcept
+{
+  unsigned p = 1;
+  while (p < i)
+    p <<= 1;
+  return p;
+}
+
+PixelSize
+GlyphAtlas::CalcSize(unsigned font_height) noexcept
+{
+  /* enough room for approximately 128 glyphs, which covers the
+     characters used by a typical translation */
+  const unsigned side = NextPowerOfTwo((font_height + PADDING) * 12);
+  return PixelSize{std::clamp(side, 128u, 1024u)};
+}
+
+GlyphAtlas::GlyphAtlas(unsigned font_height) noexcept
+  :size(CalcSize(font_height)) {}
+
+GlyphAtlas::~GlyphAtlas() noexcept = default;
+
+const GlyphAtlas::Glyph *
+GlyphAtlas::Lookup(unsigned ch) noexcept
+{
+  auto i = glyphs.find(ch);
+  if (i == glyphs.end())
+    return nullptr;
+
+  ++stats.hits;
+  return &i->second;
+}
+
+bool
+GlyphAtlas::Allocate(Glyph &glyph) noexcept
+{
+  if (glyph.width + PADDING > size.width ||
+      glyph.height + PADDING > size.height)
+    return false;
+
+  if (shelf_x + glyph.width + PADDING > size.width) {
+    /* start a new shelf */
+    shelf_y += shelf_height;
+    shelf_x = 0;
+    shelf_height = 0;
+  }
+
+  if (shelf_y + glyph.height + PADDING > size.height)
+    return false;
+
+  if (bitmap == nullptr)
+    /* make_unique() zero-initialises the array */
+    bitmap = std::make_unique<uint8_t[]>(size.width * size.height);
+
+  glyph.x = shelf_x;
+  glyph.y = shelf_y;
+
+  shelf_x += glyph.width + PADDING;
+  shelf_height = std::max(shelf_height, glyph.height + PADDING);
+  return true;
+}
+
+const GlyphAtlas::Glyph &
+GlyphAtlas::Add(unsigned ch, Glyph glyph,
+                const uint8_t *src, int pitch) noexcept
+{
+  ++stats.misses;
+
+  glyph.x = glyph.y = 0;
+  glyph.in_atlas = glyph.IsEmpty();
+
+  if (!glyph.IsEmpty()) {
+    assert(src != nullptr);
+
+    if (Allocate(glyph)) {
+      uint8_t *dest = bitmap.get() + glyph.y * size.width + glyph.x;
+      for (unsigned y = 0; y < glyph.height;
+           ++y, src += pitch, dest += size.width)
+        memcpy(dest, src, glyph.width);
+
+      glyph.in_atlas = true;
+
+#ifdef ENABLE_OPENGL
+      if (dirty_top == dirty_bottom) {
+        dirty_top = glyph.y;
+        dirty_bottom = glyph.y + glyph.height;
+      } else {
+        dirty_top = std::min<unsigned>(dirty_top, glyph.y);
+        dirty_bottom = std::max<unsigned>(dirty_bottom,
+                                          glyph.y + glyph.height);
+      }
+#endif
+    } else
+      ++stats.overflows;
+  }
+
+  return glyphs.emplace(ch, glyph).first->second;
+}
+
+#ifdef ENABLE_OPENGL
+
+GLTexture &
+GlyphAtlas::GetTexture() noexcept
+{
+  if (bitmap == nullptr)
+    /* no glyph has been added yet */
+    bitmap = std::make_unique<uint8_t[]>(size.width * size.height);
+
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+  if (texture == nullptr) {
+    texture = std::make_unique<GLTexture>(GL_ALPHA, size,
+                                          GL_ALPHA, GL_UNSIGNED_BYTE,
+                                          bitmap.get());
+    ++stats.uploads;
+    stats.upload_bytes += size.width * size.height;
+    dirty_top = dirty_bottom = 0;
+  } else {
+    texture->Bind();
+
+    if (dirty_top != dirty_bottom) {
+      /* upload only the modified rows */
+      const unsigned n_rows = dirty_bottom - dirty_top;
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, dirty_top,
+                      size.width, n_rows,
+                      GL_ALPHA, GL_UNSIGNED_BYTE,
+                      bitmap.get() + dirty_top * size.width);
+      ++stats.uploads;
+      stats.upload_bytes += n_rows * size.width;
+      dirty_top = dirty_bottom = 0;
+    }
+  }
+
+  return *texture;
+}
+
+#endif
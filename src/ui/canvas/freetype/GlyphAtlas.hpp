@@ -0,0 +1,251 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SCREEN_FREETYPE_GLYPH_ATLAS_HPP
+#define XCSOAR_SCREEN_FREETYPE_GLYPH_ATLAS_HPP
+
+#include "ui/dim/Rect.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+#include <cassert>
+#include <cstdint>
+
+#ifdef ENABLE_OPENGL
+class GLTexture;
+#endif
+
+/**
+ * One glyph of a string laid out by Font::LayoutGlyphs().
+ */
+struct GlyphQuad {
+  /**
+   * The position of the glyph relative to the top left corner of
+   * the string.
+   */
+  PixelRect dest;
+
+  /**
+   * The position of the glyph bitmap within the #GlyphAtlas.
+   */
+  PixelRect src;
+};
+
+/**
+ * A cache for the rendered glyphs of one #Font.  All glyph bitmaps
+ * are packed into one alpha bitmap (which is uploaded into a
+ * GL_ALPHA texture on OpenGL), and strings are composed from these
+ * glyphs instead of being rasterised by FreeType each time.
+ *
+ * When the atlas is full, only the metrics of new glyphs are
+ * cached, and their bitmaps need to be rendered by the caller.
+ *
+ * This class is not thread-safe.
+ */
+class GlyphAtlas {
+public:
+  struct Glyph {
+    /**
+     * The FreeType glyph index (needed for kerning).  0 means the
+     * font does not have this character.
+     */
+    unsigned index;
+
+    /**
+     * The position of the bitmap within the atlas.
+     */
+    uint16_t x, y;
+
+    /**
+     * The size of the bitmap.
+     */
+    uint16_t width, height;
+
+    /**
+     * The position of the bitmap relative to the pen position and
+     * the top of the line.
+     */
+    int16_t left, top;
+
+    /**
+     * The horizontal pen advance.
+     */
+    int16_t advance;
+
+    /**
+     * The right edge of the glyph outline relative to the pen
+     * position.
+     */
+    int16_t right;
+
+    /**
+     * Is the bitmap stored in the atlas?  This is false if the atlas
+     * was full when this glyph was added.
+     */
+    bool in_atlas;
+
+    bool IsEmpty() const noexcept {
+      return width == 0 || height == 0;
+    }
+
+    PixelRect GetSourceRect() const noexcept {
+      return {x, y, x + width, y + height};
+    }
+  };
+
+  struct Stats {
+    /**
+     * The number of glyph lookups which were served from an atlas.
+     */
+    uint64_t hits = 0;
+
+    /**
+     * The number of glyphs which had to be loaded by FreeType.
+     */
+    uint64_t misses = 0;
+
+    /**
+     * The number of glyph bitmaps which did not fit into their
+     * atlas.
+     */
+    uint64_t overflows = 0;
+
+    /**
+     * The number of texture uploads and their total size.
+     */
+    uint64_t uploads = 0, upload_bytes = 0;
+
+    /**
+     * The number of strings which had to be drawn by the #TextCache
+     * because the atlas could not render them.
+     */
+    uint64_t fallbacks = 0;
+  };
+
+private:
+  /**
+   * Leave this many empty pixels between two glyphs, to avoid
+   * bleeding when the texture gets interpolated.
+   */
+  static constexpr unsigned PADDING = 1;
+
+  static Stats stats;
+
+  const PixelSize size;
+
+  /**
+   * The alpha bitmap; allocated on the first Add() call.
+   */
+  std::unique_ptr<uint8_t[]> bitmap;
+
+  /**
+   * The current "shelf": glyphs are placed in horizontal rows; a
+   * new row is started when a glyph does not fit into the current
+   * one.
+   */
+  unsigned shelf_y = 0, shelf_height = 0, shelf_x = 0;
+
+  std::unordered_map<unsigned, Glyph> glyphs;
+
+#ifdef ENABLE_OPENGL
+  std::unique_ptr<GLTexture> texture;
+
+  /**
+   * The range of rows which were modified since the last upload.
+   */
+  unsigned dirty_top = 0, dirty_bottom = 0;
+#endif
+
+public:
+  /**
+   * @param font_height the height of the font; used to choose the
+   * atlas size
+   */
+  explicit GlyphAtlas(unsigned font_height) noexcept;
+  ~GlyphAtlas() noexcept;
+
+  GlyphAtlas(const GlyphAtlas &) = delete;
+  GlyphAtlas &operator=(const GlyphAtlas &) = delete;
+
+  [[gnu::pure]]
+  static PixelSize CalcSize(unsigned font_height) noexcept;
+
+  const PixelSize &GetSize() const noexcept {
+    return size;
+  }
+
+  /**
+   * Look up a glyph which was added previously.
+   *
+   * @return nullptr if the glyph is not cached
+   */
+  const Glyph *Lookup(unsigned ch) noexcept;
+
+  /**
+   * Add a glyph.  Its bitmap is copied into the atlas if there is
+   * room; the "x", "y" and "in_atlas" attributes are set by this
+   * method.
+   *
+   * @param src the 8 bit alpha bitmap with glyph.width *
+   * glyph.height pixels; may be nullptr if the glyph is empty
+   * @param pitch the number of bytes per row in #src
+   */
+  const Glyph &Add(unsigned ch, Glyph glyph,
+                   const uint8_t *src, int pitch) noexcept;
+
+  /**
+   * Returns a pointer to the first pixel of the glyph's bitmap.  The
+   * glyph must be stored in the atlas.
+   */
+  const uint8_t *GetBitmap(const Glyph &glyph) const noexcept {
+    assert(glyph.in_atlas);
+
+    return bitmap.get() + glyph.y * size.width + glyph.x;
+  }
+
+  unsigned GetPitch() const noexcept {
+    return size.width;
+  }
+
+#ifdef ENABLE_OPENGL
+  /**
+   * Returns the texture containing all glyphs, after uploading
+   * pending modifications.  The texture is bound.
+   */
+  GLTexture &GetTexture() noexcept;
+#endif
+
+  static const Stats &GetStats() noexcept {
+    return stats;
+  }
+
+  static void CountFallback() noexcept {
+    ++stats.fallbacks;
+  }
+
+private:
+  bool Allocate(Glyph &glyph) noexcept;
+};
+
+#endif
@@ -406,6 +406,50 @@ Canvas::Copy(const Canvas &src)
   Copy(src, {0, 0});
 }
 
+void
+Canvas::CopyTransformed(PixelRect dest_rect,
+                        const Canvas &src, PixelRect src_rect,
+                        PixelPoint origin,
+                        PixelPoint step_x, PixelPoint step_y) noexcept
+{
+  /* clip the destination rectangle to this canvas */
+  if (dest_rect.left < 0) {
+    origin.x -= dest_rect.left * step_x.x;
+    origin.y -= dest_rect.left * step_x.y;
+    dest_rect.left = 0;
+  }
+
+  if (dest_rect.top < 0) {
+    origin.x -= dest_rect.top * step_y.x;
+    origin.y -= dest_rect.top * step_y.y;
+    dest_rect.top = 0;
+  }
+
+  dest_rect.right = std::min(dest_rect.right, int(GetWidth()));
+  dest_rect.bottom = std::min(dest_rect.bottom, int(GetHeight()));
+
+  src_rect.left = std::max(src_rect.left, 0);
+  src_rect.top = std::max(src_rect.top, 0);
+  src_rect.right = std::min(src_rect.right, int(src.GetWidth()));
+  src_rect.bottom = std::min(src_rect.bottom, int(src.GetHeight()));
+
+  for (int y = dest_rect.top; y < dest_rect.bottom; ++y) {
+    int sx = origin.x, sy = origin.y;
+    origin.x += step_y.x;
+    origin.y += step_y.y;
+
+    auto *dest = buffer.At(dest_rect.left, y);
+    for (int x = dest_rect.left; x < dest_rect.right;
+         ++x, ++dest, sx += step_x.x, sy += step_x.y) {
+      /* arithmetic shift rounds towards negative infinity */
+      const int px = sx >> 16, py = sy >> 16;
+      if (px >= src_rect.left && px < src_rect.right &&
+          py >= src_rect.top && py < src_rect.bottom)
+        *dest = *src.buffer.At(px, py);
+    }
+  }
+}
+
 void
 Canvas::Copy(PixelPoint dest_position, PixelSize dest_size,
              const Bitmap &src, PixelPoint src_position) noexcept
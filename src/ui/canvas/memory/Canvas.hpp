@@ -326,6 +326,18 @@ public:
   void Copy(const Canvas &src, PixelPoint src_position) noexcept;
   void Copy(const Canvas &src);
 
+  /**
+   * Copy pixels from another canvas with an affine transformation
+   * (nearest neighbour).  The source position of the pixel at
+   * dest_rect.left+x, dest_rect.top+y is origin + x * step_x + y *
+   * step_y; all these vectors are 16.16 fixed point.  Pixels whose
+   * source position is outside #src_rect are left unchanged.
+   */
+  void CopyTransformed(PixelRect dest_rect,
+                       const Canvas &src, PixelRect src_rect,
+                       PixelPoint origin,
+                       PixelPoint step_x, PixelPoint step_y) noexcept;
+
   void Copy(PixelPoint dest_position, PixelSize dest_size,
             const Bitmap &src, PixelPoint src_position) noexcept;
   void Copy(const Bitmap &src);
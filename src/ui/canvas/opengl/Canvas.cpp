@@ -32,6 +32,7 @@ Copyright_License {
 #include "VertexPointer.hpp"
 #include "ExactPixelPoint.hpp"
 #include "ui/canvas/custom/Cache.hpp"
+#include "ui/canvas/Font.hpp"
 #include "ui/canvas/Bitmap.hpp"
 #include "ui/canvas/Util.hpp"
 #include "ui/opengl/Features.hpp"
@@ -44,6 +45,10 @@ Copyright_License {
 #include "Shaders.hpp"
 #include "Program.hpp"
 
+#ifdef USE_FREETYPE
+#include "ui/canvas/freetype/GlyphAtlas.hpp"
+#endif
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -55,6 +60,8 @@ Copyright_License {
 #include "util/UTF8.hpp"
 #endif
 
+#include <algorithm>
+
 #include <cassert>
 
 AllocatedArray<BulkPixelPoint> Canvas::vertex_buffer;
@@ -558,6 +565,118 @@ PrepareColoredAlphaTexture(Color color)
   color.Bind();
 }
 
+#ifdef USE_FREETYPE
+
+static AllocatedArray<GlyphQuad> glyph_quads;
+
+/**
+ * Lay out the string with glyphs from the font's #GlyphAtlas into
+ * #glyph_quads.
+ *
+ * @return the number of quads or -1 if the atlas cannot render this
+ * string and the #TextCache shall be used instead
+ */
+static int
+LayoutGlyphs(const Font &font, StringView text) noexcept
+{
+  /* each glyph consumes at least one byte */
+  glyph_quads.GrowDiscard(text.size);
+
+  int n = font.LayoutGlyphs(text, glyph_quads.data(), text.size);
+  if (n < 0)
+    GlyphAtlas::CountFallback();
+  return n;
+}
+
+/**
+ * Draw the glyphs in #glyph_quads (obtained by LayoutGlyphs()) with
+ * one draw call.  The caller is responsible for selecting the shader
+ * and enabling alpha blending.
+ *
+ * @param clip the glyphs are clipped to this rectangle (absolute
+ * coordinates)
+ */
+static void
+DrawGlyphs(const Font &font, PixelPoint p, unsigned n,
+           const PixelRect clip) noexcept
+{
+  static AllocatedArray<BulkPixelPoint> vertices;
+  static AllocatedArray<GLfloat> coords;
+
+  vertices.GrowDiscard(n * 6);
+  coords.GrowDiscard(n * 12);
+
+  GLTexture &texture = font.GetGlyphAtlas().GetTexture();
+  const PixelSize allocated = texture.GetAllocatedSize();
+
+  BulkPixelPoint *v = vertices.data();
+  GLfloat *c = coords.data();
+
+  for (unsigned i = 0; i < n; ++i) {
+    const GlyphQuad &quad = glyph_quads[i];
+    PixelRect dest = quad.dest, src = quad.src;
+    dest.Offset(p.x, p.y);
+
+    if (dest.left < clip.left) {
+      src.left += clip.left - dest.left;
+      dest.left = clip.left;
+    }
+
+    if (dest.top < clip.top) {
+      src.top += clip.top - dest.top;
+      dest.top = clip.top;
+    }
+
+    if (dest.right > clip.right) {
+      src.right -= dest.right - clip.right;
+      dest.right = clip.right;
+    }
+
+    if (dest.bottom > clip.bottom) {
+      src.bottom -= dest.bottom - clip.bottom;
+      dest.bottom = clip.bottom;
+    }
+
+    if (dest.left >= dest.right || dest.top >= dest.bottom)
+      continue;
+
+    const GLfloat x0 = (GLfloat)src.left / allocated.width;
+    const GLfloat y0 = (GLfloat)src.top / allocated.height;
+    const GLfloat x1 = (GLfloat)src.right / allocated.width;
+    const GLfloat y1 = (GLfloat)src.bottom / allocated.height;
+
+    /* two triangles per glyph */
+    *v++ = dest.GetTopLeft();
+    *v++ = dest.GetTopRight();
+    *v++ = dest.GetBottomLeft();
+    *v++ = dest.GetTopRight();
+    *v++ = dest.GetBottomRight();
+    *v++ = dest.GetBottomLeft();
+
+    const GLfloat tc[] = {
+      x0, y0, x1, y0, x0, y1,
+      x1, y0, x1, y1, x0, y1,
+    };
+    c = std::copy_n(tc, ARRAY_SIZE(tc), c);
+  }
+
+  const GLsizei count = v - vertices.data();
+  if (count == 0)
+    return;
+
+  const ScopeVertexPointer vp(vertices.data());
+
+  glEnableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+  glVertexAttribPointer(OpenGL::Attribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE,
+                        0, coords.data());
+
+  glDrawArrays(GL_TRIANGLES, 0, count);
+
+  glDisableVertexAttribArray(OpenGL::Attribute::TEXCOORD);
+}
+
+#endif
+
 void
 Canvas::DrawText(PixelPoint p, BasicStringView<TCHAR> text) noexcept
 {
@@ -580,6 +699,21 @@ Canvas::DrawText(PixelPoint p, BasicStringView<TCHAR> text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  if (const int n = LayoutGlyphs(*font, text3); n >= 0) {
+    const PixelRect rc{p, font->TextSize(text3)};
+
+    if (background_mode == OPAQUE)
+      DrawFilledRectangle(rc, background_color);
+
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+    DrawGlyphs(*font, p, n, rc);
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -617,6 +751,16 @@ Canvas::DrawTransparentText(PixelPoint p, BasicStringView<TCHAR> text) noexcept
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  if (const int n = LayoutGlyphs(*font, text3); n >= 0) {
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+    DrawGlyphs(*font, p, n, {p, font->TextSize(text3)});
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -652,6 +796,22 @@ Canvas::DrawClippedText(PixelPoint p, PixelSize size,
   if (text3.empty())
     return;
 
+#ifdef USE_FREETYPE
+  if (const int n = LayoutGlyphs(*font, text3); n >= 0) {
+    const PixelSize text_size = font->TextSize(text3);
+    if (text_size.height < size.height)
+      size.height = text_size.height;
+    if (text_size.width < size.width)
+      size.width = text_size.width;
+
+    PrepareColoredAlphaTexture(text_color);
+
+    const ScopeAlphaBlend alpha_blend;
+    DrawGlyphs(*font, p, n, {p, size});
+    return;
+  }
+#endif
+
   GLTexture *texture = TextCache::Get(*font, text3);
   if (texture == nullptr)
     return;
@@ -131,10 +131,31 @@ MD5::Append(uint8_t ch)
 void
 MD5::Append(const void *data, size_t length)
 {
-  const uint8_t *i = (const uint8_t *)data, *const end = i + length;
+  const uint8_t *i = (const uint8_t *)data;
 
-  while (i != end)
-    Append(*i++);
+  unsigned position = unsigned(message_length) % ARRAY_SIZE(buff512bits);
+  message_length += length;
+
+  if (position > 0) {
+    /* fill up the partial block first */
+    const size_t n = std::min(length, ARRAY_SIZE(buff512bits) - position);
+    std::copy_n(i, n, buff512bits + position);
+    i += n;
+    length -= n;
+    position += n;
+
+    if (position < ARRAY_SIZE(buff512bits))
+      return;
+
+    Process512(buff512bits);
+  }
+
+  /* process whole blocks directly from the input */
+  for (; length >= ARRAY_SIZE(buff512bits);
+       i += ARRAY_SIZE(buff512bits), length -= ARRAY_SIZE(buff512bits))
+    Process512(i);
+
+  std::copy_n(i, length, buff512bits);
 }
 
 /**
@@ -196,9 +217,9 @@ MD5::Process512(const uint8_t *s512in)
 
   // copy the 64 chars into the 16 uint32_ts
   uint32_t w[16];
-  const uint32_t *s512_32 = (const uint32_t *)(const void *)s512in;
+  std::copy_n(s512in, sizeof(w), (uint8_t *)w);
   for (int j = 0; j < 16; j++)
-    w[j] = ToLE32(s512_32[j]);
+    w[j] = ToLE32(w[j]);
 
   // Initialize hash value for this chunk:
   uint32_t a = state.a, b = state.b, c = state.c, d = state.d;
@@ -0,0 +1,120 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRIPLE_BUFFER_HPP
+#define XCSOAR_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * A lock-free channel which passes the most recent value of a
+ * (small) object from exactly one producer thread to exactly one
+ * consumer thread.  Neither side ever blocks: the producer
+ * overwrites values the consumer has not seen yet, and the consumer
+ * keeps the previous value until a new one has been published.
+ *
+ * There are three instances of the object: one owned by the
+ * producer, one owned by the consumer, and one in the middle which
+ * is exchanged atomically.
+ */
+template<typename T>
+class TripleBuffer {
+  static constexpr unsigned INDEX_MASK = 0x3;
+
+  /**
+   * This flag is set in #middle when it contains a value which the
+   * consumer has not seen yet.
+   */
+  static constexpr unsigned NEW_FLAG = 0x4;
+
+  T buffers[3];
+
+  std::atomic<unsigned> middle{1};
+
+  /**
+   * Only accessed by the producer.
+   */
+  unsigned back = 0;
+
+  /**
+   * Only accessed by the consumer.
+   */
+  unsigned front = 2;
+
+public:
+  TripleBuffer() = default;
+
+  explicit TripleBuffer(const T &initial) noexcept
+    :buffers{initial, initial, initial} {}
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * Producer: returns the object to be filled.  Its contents are
+   * undefined (an old value).
+   */
+  T &GetBack() noexcept {
+    return buffers[back];
+  }
+
+  /**
+   * Producer: make the object returned by GetBack() available to
+   * the consumer.
+   */
+  void Publish() noexcept {
+    back = middle.exchange(back | NEW_FLAG, std::memory_order_acq_rel)
+      & INDEX_MASK;
+  }
+
+  /**
+   * Producer: shortcut for GetBack() and Publish().
+   */
+  void Publish(const T &value) noexcept {
+    GetBack() = value;
+    Publish();
+  }
+
+  /**
+   * Consumer: obtain the most recently published value, if there is
+   * a new one.
+   *
+   * @return true if GetFront() returns a new value now
+   */
+  bool Update() noexcept {
+    if ((middle.load(std::memory_order_relaxed) & NEW_FLAG) == 0)
+      return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * Consumer: returns the value obtained by the last Update() call.
+   */
+  const T &GetFront() const noexcept {
+    return buffers[front];
+  }
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the CPU time of the vario tone synthesiser and of the PCM
+ * mixer kernels, i.e. the work done in the audio callback.
+ *
+ * Usage: BenchmarkAudio [PERIOD_FRAMES]
+ *
+ * PERIOD_FRAMES is the size of each buffer request (the ALSA period
+ * size); it defaults to 256.
+ */
+
+#include "Audio/VarioSynthesiser.hpp"
+#include "Audio/AudioAlgorithms.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr unsigned SAMPLE_RATE = 44100;
+
+/**
+ * The number of seconds of audio generated per run.
+ */
+static constexpr unsigned DURATION = 600;
+
+static void
+Report(const char *name, Clock::duration duration, long sum)
+{
+  const double seconds = std::chrono::duration<double>(duration).count();
+  const double n_frames = double(SAMPLE_RATE) * DURATION;
+  printf("%-24s %7.2f ns/frame, %6.3f%% of real time [%ld]\n",
+         name, seconds * 1e9 / n_frames,
+         seconds * 100 / DURATION, sum);
+}
+
+static void
+BenchmarkVario(size_t period, double vario, const char *name)
+{
+  VarioSynthesiser synthesiser(SAMPLE_RATE);
+  synthesiser.SetVario(vario);
+
+  std::vector<int16_t> buffer(period);
+  long sum = 0;
+
+  const size_t n_periods = size_t(SAMPLE_RATE) * DURATION / period;
+  const auto start = Clock::now();
+  for (size_t i = 0; i < n_periods; ++i) {
+    synthesiser.Synthesise(buffer.data(), period);
+    sum += buffer[i % period];
+  }
+
+  Report(name, Clock::now() - start, sum);
+}
+
+template<typename F>
+static void
+BenchmarkKernel(size_t period, const char *name, F &&f)
+{
+  std::vector<int16_t> dest(period), src(period);
+  for (size_t i = 0; i < period; ++i)
+    src[i] = int16_t(i * 7919);
+
+  long sum = 0;
+
+  const size_t n_periods = size_t(SAMPLE_RATE) * DURATION / period;
+  const auto start = Clock::now();
+  for (size_t i = 0; i < n_periods; ++i) {
+    std::copy(src.begin(), src.end(), dest.begin());
+    f(dest.data(), src.data(), period);
+    sum += dest[i % period];
+  }
+
+  Report(name, Clock::now() - start, sum);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[PERIOD_FRAMES]");
+  const size_t period = args.IsEmpty() ? 256 : atoi(args.GetNext());
+  args.ExpectEnd();
+
+  if (period == 0) {
+    fprintf(stderr, "Invalid PERIOD_FRAMES value\n");
+    return EXIT_FAILURE;
+  }
+
+  BenchmarkVario(period, -2, "vario sink");
+  BenchmarkVario(period, 2.5, "vario climb");
+
+  BenchmarkKernel(period, "LowerVolume",
+                  [](int16_t *dest, const int16_t *, size_t n){
+                    LowerVolume(dest, n, 70);
+                  });
+  BenchmarkKernel(period, "MixPCM",
+                  [](int16_t *dest, const int16_t *src, size_t n){
+                    MixPCM(dest, src, n, 70);
+                  });
+  BenchmarkKernel(period, "ByteSwapAndMixPCM",
+                  [](int16_t *dest, const int16_t *src, size_t n){
+                    ByteSwapAndMixPCM(dest, src, n, 70);
+                  });
+  BenchmarkKernel(period, "MixPCM (portable)",
+                  [](int16_t *dest, const int16_t *src, size_t n){
+                    ApplyGainPCMPortable<false, true>(dest, src, n,
+                                                      VolumeToGain(70));
+                  });
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
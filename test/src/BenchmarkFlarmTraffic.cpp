@@ -0,0 +1,259 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the FLARM traffic pipeline with a large simulated gaggle
+ * (see #FlarmTrafficGenerator), stage by stage: generating the NMEA
+ * data, parsing it, merging the device data, FlarmComputer, and the
+ * per-target work which the FLARM radar (FlarmTrafficWindow) and the
+ * map (MapWindowTraffic) do before drawing.
+ *
+ * Usage: BenchmarkFlarmTraffic [GLIDERS] [SECONDS] [MERGES_PER_SECOND]
+ */
+
+#include "FlarmTrafficGenerator.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "FLARM/FlarmComputer.hpp"
+#include "FLARM/Friends.hpp"
+#include "FLARM/Global.hpp"
+#include "FLARM/TrafficDatabases.hpp"
+#include "Projection/WindowProjection.hpp"
+#include "system/Args.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+enum Stage {
+  GENERATE,
+  PARSE,
+  MERGE,
+  COMPUTER,
+  RADAR,
+  MAP,
+  N_STAGES
+};
+
+static constexpr const char *stage_names[N_STAGES] = {
+  "generate",
+  "parse",
+  "merge",
+  "FlarmComputer",
+  "radar",
+  "map",
+};
+
+static Clock::duration stage_durations[N_STAGES];
+
+template<typename F>
+static void
+Measure(Stage stage, F &&f)
+{
+  const auto start = Clock::now();
+  f();
+  stage_durations[stage] += Clock::now() - start;
+}
+
+/**
+ * A checksum to prevent the compiler from optimising the work away.
+ */
+static unsigned long sum;
+
+/**
+ * What FlarmTrafficWindow does with each new TrafficList.
+ */
+static void
+Radar(const TrafficList &new_data, FlarmId selection_id)
+{
+  TrafficList data = new_data;
+
+  const FlarmTraffic *alert = data.FindMaximumAlert();
+  if (alert != nullptr)
+    sum += data.TrafficIndex(alert);
+
+  const FlarmTraffic *selection = data.FindTraffic(selection_id);
+  if (selection != nullptr)
+    sum += data.TrafficIndex(selection);
+
+  for (const auto &traffic : data.list) {
+    sum += (unsigned)FlarmFriends::GetFriendColor(traffic.id);
+    sum += (unsigned)traffic.Bearing().Degrees();
+    sum += (unsigned)traffic.distance;
+  }
+}
+
+/**
+ * What MapWindowTraffic does with the TrafficList, except drawing.
+ */
+static void
+Map(const TrafficList &data, const WindowProjection &projection)
+{
+  for (const auto &traffic : data.list) {
+    if (!traffic.location_available)
+      continue;
+
+    if (auto p = projection.GeoToScreenIfVisible(traffic.location)) {
+      sum += p->x + p->y;
+      sum += (unsigned)FlarmFriends::GetFriendColor(traffic.id);
+    }
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[GLIDERS] [SECONDS] [MERGES_PER_SECOND]");
+
+  FlarmTrafficGenerator::Config config;
+  if (!args.IsEmpty())
+    config.n_gliders = atoi(args.GetNext());
+
+  const unsigned n_seconds = args.IsEmpty() ? 600 : atoi(args.GetNext());
+  const unsigned merges_per_second =
+    args.IsEmpty() ? 10 : atoi(args.GetNext());
+  args.ExpectEnd();
+
+  if (n_seconds == 0 || merges_per_second == 0) {
+    fprintf(stderr, "Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+
+  FlarmTrafficGenerator generator(config);
+
+  /* give some of the targets names and colors, which are looked up
+     by FlarmComputer and the renderers */
+  traffic_databases = new TrafficDatabases();
+  for (unsigned i = 0; i < config.n_gliders; i += 3) {
+    char id_buffer[16];
+    snprintf(id_buffer, sizeof(id_buffer), "%06X", generator.GetTargetId(i));
+    const FlarmId id = FlarmId::Parse(id_buffer, nullptr);
+
+    TCHAR name[16];
+    _stprintf(name, _T("G%u"), i);
+    traffic_databases->flarm_names.Set(id, name);
+
+    if (i % 9 == 0)
+      traffic_databases->flarm_colors.Set(id, FlarmColor::GREEN);
+  }
+
+  NMEAParser parser;
+  NMEAInfo device;
+  device.Reset();
+
+  NMEAInfo basic;
+  basic.Reset();
+
+  FlarmComputer computer;
+
+  WindowProjection projection;
+  projection.SetScreenSize({640, 480});
+  projection.SetScreenOrigin(320, 240);
+  projection.SetScaleFromRadius(5000);
+
+  std::vector<std::string> lines;
+  unsigned long n_sentences = 0, n_reported = 0, n_listed = 0;
+
+  for (unsigned second = 0; second < n_seconds; ++second) {
+    const double clock = 1000 + second;
+
+    unsigned n_traffic;
+    Measure(GENERATE, [&](){
+      generator.Advance(1);
+      lines.clear();
+      n_traffic = generator.Generate(lines);
+    });
+
+    n_sentences += lines.size();
+    n_reported += n_traffic;
+
+    Measure(PARSE, [&](){
+      device.clock = clock;
+      for (const auto &line : lines)
+        if (parser.ParseLine(line.c_str(), device))
+          device.alive.Update(clock);
+    });
+
+    /* the MergeThread runs several times per second, but only the
+       first merge sees new FLARM data */
+    for (unsigned merge = 0; merge < merges_per_second; ++merge) {
+      Measure(MERGE, [&](){
+        device.flarm.Expire(clock);
+        basic.Reset();
+        basic.Complement(device);
+      });
+
+      Measure(COMPUTER, [&](){
+        computer.Process(basic.flarm, basic);
+      });
+
+      const TrafficList &traffic = basic.flarm.traffic;
+
+      Measure(RADAR, [&](){
+        Radar(traffic, traffic.IsEmpty()
+              ? FlarmId::Undefined()
+              : traffic.list.front().id);
+      });
+
+      Measure(MAP, [&](){
+        projection.SetGeoLocation(basic.location);
+        projection.UpdateScreenBounds();
+        Map(traffic, projection);
+      });
+    }
+
+    n_listed += basic.flarm.traffic.GetActiveTrafficCount();
+  }
+
+  printf("%u gliders, %u s, %u merges/s\n",
+         config.n_gliders, n_seconds, merges_per_second);
+  printf("%.1f sentences/s, %.1f targets reported/s, "
+         "%.1f in TrafficList (max %u)\n",
+         (double)n_sentences / n_seconds, (double)n_reported / n_seconds,
+         (double)n_listed / n_seconds, (unsigned)TrafficList::MAX_COUNT);
+
+  Clock::duration total{};
+  for (unsigned i = 0; i < N_STAGES; ++i)
+    total += stage_durations[i];
+
+  for (unsigned i = 0; i < N_STAGES; ++i) {
+    const double us = std::chrono::duration<double, std::micro>(stage_durations[i]).count()
+      / n_seconds;
+    printf("%-14s %9.1f us per second of flight, %5.3f%% of real time\n",
+           stage_names[i], us, us / 1e4);
+  }
+
+  const double us = std::chrono::duration<double, std::micro>(total).count()
+    / n_seconds;
+  printf("%-14s %9.1f us per second of flight, %5.3f%% of real time\n",
+         "total", us, us / 1e4);
+
+  delete traffic_databases;
+
+  return sum == 42 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
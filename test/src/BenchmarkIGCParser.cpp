@@ -0,0 +1,156 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compare the line based IGC parser with #IGCFixReader.
+ *
+ * Usage: BenchmarkIGCParser FILE.igc [REPEAT]
+ *
+ * Use a file of a few megabytes (i.e. a long flight with one second
+ * interval) to get meaningful numbers.
+ */
+
+#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFixReader.hpp"
+#include "IGC/IGCFix.hpp"
+#include "IGC/IGCExtensions.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/FileMapping.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <chrono>
+#include <iterator>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+  unsigned n_fixes = 0;
+
+  /**
+   * A checksum of all fixes to prevent the compiler from optimising
+   * the loops away, and to compare both parsers.
+   */
+  long sum = 0;
+
+  void Add(const IGCFix &fix) noexcept {
+    ++n_fixes;
+    sum += fix.time.GetSecondOfDay() + fix.gps_altitude +
+      fix.pressure_altitude + fix.enl + fix.gsp +
+      long(fix.location.latitude.Degrees() * 1000000);
+  }
+};
+
+static Result
+ParseLines(Path path)
+{
+  Result result;
+
+  FileLineReaderA reader(path);
+
+  IGCExtensions extensions;
+  extensions.clear();
+
+  IGCFix fix;
+  char *line;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (line[0] == 'B') {
+      if (IGCParseFix(line, extensions, fix))
+        result.Add(fix);
+    } else if (line[0] == 'I')
+      IGCParseExtensions(line, extensions);
+  }
+
+  return result;
+}
+
+static Result
+ParseMapped(Path path)
+{
+  Result result;
+
+  FileMapping mapping(path);
+  IGCFixReader reader({mapping.data(), mapping.size()});
+
+  IGCFix fixes[256];
+  unsigned n;
+  while ((n = reader.Read(fixes, std::size(fixes))) > 0)
+    for (unsigned i = 0; i < n; ++i)
+      result.Add(fixes[i]);
+
+  return result;
+}
+
+template<typename F>
+static Result
+Benchmark(const char *name, unsigned repeat, size_t size, F &&f)
+{
+  Result result;
+
+  const auto start = Clock::now();
+  for (unsigned i = 0; i < repeat; ++i)
+    result = f();
+  const std::chrono::duration<double> duration = Clock::now() - start;
+
+  const double seconds = duration.count() / repeat;
+  printf("%-12s %u fixes in %.3f ms (%.1f MB/s, %.1f ns/fix)\n",
+         name, result.n_fixes, seconds * 1000,
+         size / seconds / (1024 * 1024),
+         result.n_fixes > 0 ? seconds * 1e9 / result.n_fixes : 0.);
+
+  return result;
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "FILE.igc [REPEAT]");
+  const auto path = args.ExpectNextPath();
+  const unsigned repeat = args.IsEmpty() ? 10 : atoi(args.GetNext());
+  args.ExpectEnd();
+
+  if (repeat == 0) {
+    fprintf(stderr, "Invalid REPEAT value\n");
+    return EXIT_FAILURE;
+  }
+
+  const size_t size = FileMapping(path).size();
+
+  const auto lines = Benchmark("lines", repeat, size,
+                               [&path]{ return ParseLines(path); });
+  const auto mapped = Benchmark("mapped", repeat, size,
+                                [&path]{ return ParseMapped(path); });
+
+  if (lines.n_fixes != mapped.n_fixes || lines.sum != mapped.sum) {
+    fprintf(stderr, "Results differ\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
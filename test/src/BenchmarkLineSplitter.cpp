@@ -0,0 +1,169 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the throughput of #PortLineSplitter, the first stage of the
+ * device receive path.
+ *
+ * Usage: BenchmarkLineSplitter [FILE.nmea] [REPEAT]
+ *
+ * Without a file, synthetic FLARM/GPS data is used.  The input is fed
+ * in chunks of several sizes, which simulates the reads of a serial
+ * port (small chunks) and a TCP/UDP port (large chunks).
+ */
+
+#include "Device/Util/LineSplitter.hpp"
+#include "NMEA/Checksum.hpp"
+#include "system/FileMapping.hpp"
+#include "system/Args.hpp"
+#include "util/PrintException.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using Clock = std::chrono::steady_clock;
+
+class CountingSplitter final : public PortLineSplitter {
+public:
+  unsigned n_lines = 0;
+
+  /**
+   * A checksum to prevent the compiler from optimising the work
+   * away.
+   */
+  unsigned long sum = 0;
+
+protected:
+  bool LineReceived(const char *line) noexcept override {
+    ++n_lines;
+    sum += (unsigned char)line[0] + strlen(line);
+    return true;
+  }
+};
+
+static void
+AppendSentence(std::string &dest, const char *sentence)
+{
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "$%s*%02X\r\n",
+           sentence, NMEAChecksum(sentence));
+  dest.append(buffer);
+}
+
+/**
+ * Generate data similar to what a FLARM with a few targets sends
+ * (the kind of input FeedNMEA would replay).
+ */
+static std::string
+GenerateInput(unsigned n_seconds)
+{
+  std::string result;
+
+  for (unsigned t = 0; t < n_seconds; ++t) {
+    char sentence[100];
+
+    snprintf(sentence, sizeof(sentence),
+             "GPRMC,%02u%02u%02u,A,5103.117,N,00742.367,E,45.2,%03u.0,120621,,,A",
+             12 + t / 3600, (t / 60) % 60, t % 60, t % 360);
+    AppendSentence(result, sentence);
+
+    snprintf(sentence, sizeof(sentence),
+             "GPGGA,%02u%02u%02u,5103.117,N,00742.367,E,1,08,1.0,%u,M,47.0,M,,",
+             12 + t / 3600, (t / 60) % 60, t % 60, 1000 + t % 500);
+    AppendSentence(result, sentence);
+
+    AppendSentence(result, "PGRMZ,3281,f,3");
+
+    for (unsigned i = 0; i < 5; ++i) {
+      snprintf(sentence, sizeof(sentence),
+               "PFLAA,0,%d,%d,%d,2,DD%04X,%u,,%u,%d.%u,1",
+               int(t % 1000) - 500 + int(i) * 100, 300 - int(i) * 50,
+               int(i) * 20 - 40, 0x1000 + i, (t + i * 30) % 360,
+               20 + i, int(i) - 2, t % 10);
+      AppendSentence(result, sentence);
+    }
+
+    AppendSentence(result, "PFLAU,5,1,2,1,0,,0,,");
+  }
+
+  return result;
+}
+
+static void
+Benchmark(const std::string &input, size_t chunk_size, unsigned repeat)
+{
+  CountingSplitter splitter;
+
+  const auto start = Clock::now();
+  for (unsigned i = 0; i < repeat; ++i) {
+    const char *p = input.data(), *const end = p + input.size();
+    while (p < end) {
+      const size_t n = std::min(chunk_size, size_t(end - p));
+      splitter.DataReceived(p, n);
+      p += n;
+    }
+  }
+  const std::chrono::duration<double> duration = Clock::now() - start;
+
+  const double seconds = duration.count() / repeat;
+  const unsigned n_lines = splitter.n_lines / repeat;
+  printf("chunk=%-6zu %u lines in %.3f ms (%.1f MB/s, %.1f ns/line) [%lu]\n",
+         chunk_size, n_lines, seconds * 1000,
+         input.size() / seconds / (1024 * 1024),
+         n_lines > 0 ? seconds * 1e9 / n_lines : 0.,
+         splitter.sum);
+}
+
+int
+main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[FILE.nmea] [REPEAT]");
+
+  std::string input;
+  if (!args.IsEmpty()) {
+    const FileMapping mapping(args.ExpectNextPath());
+    input.assign((const char *)mapping.data(), mapping.size());
+  } else
+    input = GenerateInput(3600);
+
+  const unsigned repeat = args.IsEmpty() ? 20 : atoi(args.GetNext());
+  args.ExpectEnd();
+
+  if (repeat == 0) {
+    fprintf(stderr, "Invalid REPEAT value\n");
+    return EXIT_FAILURE;
+  }
+
+  for (size_t chunk_size : {1, 16, 64, 512, 4096, 65536})
+    Benchmark(input, chunk_size, repeat);
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,379 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Randomised task engine stress and performance benchmark.
+ *
+ * For each task factory type (RT, AAT, FAI, MAT) and a range of task
+ * sizes, random tasks are generated with the test_task harness and
+ * flown with the AircraftSim autopilot.  On every simulator tick the
+ * cost of TaskManager::Update() and TaskManager::UpdateIdle() is
+ * measured, followed by the individual solvers run on a shadow copy
+ * of the ordered task (synchronised to the active task point):
+ * TaskDijkstraMin, TaskDijkstraMax, TaskOptTarget (AAT points only)
+ * and TaskMacCreadyRemaining/TaskMacCreadyTotal.
+ *
+ * The output is one fixed-width line per (type, size) cell.  The
+ * left columns depend only on the seed and the arguments, so two runs
+ * can be diffed; the right columns are the mean cost per tick in
+ * microseconds.
+ *
+ * Usage: BenchmarkTaskEngine [TASKS_PER_CELL] [MAX_POINTS] [SEED] [MAX_TICKS]
+ */
+
+#include "harness_task.hpp"
+#include "harness_waypoints.hpp"
+#include "harness_wind.hpp"
+#include "test_debug.hpp"
+#include "Task/TaskManager.hpp"
+#include "Task/Factory/AbstractTaskFactory.hpp"
+#include "Task/Factory/Constraints.hpp"
+#include "Task/Ordered/OrderedTask.hpp"
+#include "Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Task/Ordered/Points/AATPoint.hpp"
+#include "Task/Ordered/Points/StartPoint.hpp"
+#include "Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Task/Solvers/TaskOptTarget.hpp"
+#include "Task/Solvers/TaskMacCreadyRemaining.hpp"
+#include "Task/Solvers/TaskMacCreadyTotal.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Replay/TaskAccessor.hpp"
+#include "Replay/TaskAutoPilot.hpp"
+#include "Replay/AircraftSim.hpp"
+#include "Geo/SearchPoint.hpp"
+#include "util/DereferenceIterator.hxx"
+
+#include <chrono>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+enum Stage {
+  UPDATE,
+  UPDATE_IDLE,
+  DIJKSTRA_MIN,
+  DIJKSTRA_MAX,
+  OPT_TARGET,
+  MACCREADY,
+  N_STAGES
+};
+
+static constexpr const char *stage_names[N_STAGES] = {
+  "Update", "Idle", "DijMin", "DijMax", "OptTgt", "MC",
+};
+
+static constexpr struct {
+  TaskFactoryType type;
+  const char *name;
+} factory_types[] = {
+  { TaskFactoryType::RACING, "RT" },
+  { TaskFactoryType::AAT, "AAT" },
+  { TaskFactoryType::FAI_GENERAL, "FAI" },
+  { TaskFactoryType::MAT, "MAT" },
+};
+
+static constexpr unsigned task_sizes[] = { 2, 3, 4, 5, 7, 10, 13, 20, 30 };
+
+/** how many attempts per requested task before the cell gives up */
+static constexpr unsigned MAX_ATTEMPTS = 20;
+
+struct Cell {
+  unsigned tasks = 0, rejected = 0, finished = 0;
+  unsigned long ticks = 0;
+  double nominal_distance = 0;
+  Clock::duration duration[N_STAGES]{};
+
+  void Add(const Cell &other) noexcept {
+    tasks += other.tasks;
+    rejected += other.rejected;
+    finished += other.finished;
+    ticks += other.ticks;
+    nominal_distance += other.nominal_distance;
+    for (unsigned i = 0; i < N_STAGES; ++i)
+      duration[i] += other.duration[i];
+  }
+
+  void Print(const char *type, const char *size) const noexcept {
+    printf("%-4s %4s %5u %5u %5u %9lu %10.1f |",
+           type, size, tasks, rejected, finished, ticks,
+           tasks > 0 ? nominal_distance / tasks / 1000. : 0.);
+
+    for (unsigned i = 0; i < N_STAGES; ++i) {
+      const double us = ticks > 0
+        ? std::chrono::duration<double, std::micro>(duration[i]).count() / ticks
+        : 0.;
+      printf(" %8.2f", us);
+    }
+
+    printf("\n");
+  }
+};
+
+template<typename F>
+static inline void
+Measure(Clock::duration &d, F &&f)
+{
+  const auto start = Clock::now();
+  f();
+  d += Clock::now() - start;
+}
+
+/**
+ * Run the path and glide solvers on the shadow task, the same way
+ * #OrderedTask does internally.
+ */
+static void
+RunSolvers(OrderedTask &shadow, const AircraftState &state,
+           const TaskBehaviour &task_behaviour, const GlidePolar &glide_polar,
+           TaskDijkstraMin &dijkstra_min, TaskDijkstraMax &dijkstra_max,
+           Cell &cell)
+{
+  const unsigned task_size = shadow.TaskSize();
+  const unsigned active = shadow.GetActiveIndex();
+  const FlatProjection &projection = shadow.GetTaskProjection();
+
+  std::vector<OrderedTaskPoint *> points;
+  points.reserve(task_size);
+  for (unsigned i = 0; i < task_size; ++i)
+    points.push_back(&shadow.GetPoint(i));
+
+  Measure(cell.duration[DIJKSTRA_MIN], [&]{
+    dijkstra_min.SetTaskSize(task_size - active);
+    for (unsigned i = active; i < task_size; ++i)
+      dijkstra_min.SetBoundary(i - active, points[i]->GetSearchPoints());
+
+    dijkstra_min.DistanceMin(SearchPoint(state.location, projection));
+  });
+
+  Measure(cell.duration[DIJKSTRA_MAX], [&]{
+    dijkstra_max.SetTaskSize(task_size);
+    for (unsigned i = 0; i < task_size; ++i)
+      dijkstra_max.SetBoundary(i, i == active
+                               ? points[i]->GetBoundaryPoints()
+                               : points[i]->GetSearchPoints());
+
+    dijkstra_max.DistanceMax();
+  });
+
+  DereferenceContainerAdapter<std::vector<OrderedTaskPoint *>,
+                              OrderedTaskPoint> tps(points);
+
+  if (points[active]->GetType() == TaskPointType::AAT)
+    Measure(cell.duration[OPT_TARGET], [&]{
+      TaskOptTarget tot(tps, active, state,
+                        task_behaviour.glide, glide_polar,
+                        (AATPoint &)*points[active], projection,
+                        (StartPoint &)*points.front());
+      tot.search(0.5);
+    });
+
+  Measure(cell.duration[MACCREADY], [&]{
+    TaskMacCreadyRemaining remaining(tps.begin(), tps.end(), active,
+                                     task_behaviour.glide, glide_polar);
+    remaining.glide_solution(state);
+
+    TaskMacCreadyTotal total(tps.begin(), tps.end(), active,
+                             task_behaviour.glide, glide_polar);
+    total.glide_solution(state);
+  });
+}
+
+/**
+ * Fly the task currently loaded in the #TaskManager with the
+ * autopilot, measuring each tick.
+ */
+static void
+FlyTask(TaskManager &task_manager, unsigned max_ticks, Cell &cell)
+{
+  const TaskBehaviour &task_behaviour = task_manager.GetTaskBehaviour();
+  const GlidePolar &glide_polar = task_manager.GetGlidePolar();
+
+  const auto shadow = task_manager.GetOrderedTask().Clone(task_behaviour);
+  shadow->UpdateGeometry();
+
+  TaskDijkstraMin dijkstra_min;
+  TaskDijkstraMax dijkstra_max;
+
+  TaskAccessor ta(task_manager, 300);
+  TaskAutoPilot autopilot(autopilot_parms);
+  AircraftSim aircraft;
+
+  autopilot.SetDefaultLocation(GeoPoint(Angle::Degrees(1), Angle::Degrees(0)));
+
+  const unsigned n_wind = rand() % NUM_WIND;
+  if (n_wind)
+    aircraft.SetWind(wind_to_mag(n_wind), wind_to_dir(n_wind));
+
+  autopilot.Start(ta);
+  aircraft.Start(autopilot.location_start, autopilot.location_previous,
+                 autopilot_parms.start_alt);
+
+  task_manager.GetFactory().UpdateGeometry();
+
+  unsigned ticks = 0;
+  bool running;
+  do {
+    autopilot.UpdateState(ta, aircraft.GetState());
+    aircraft.Update(autopilot.heading);
+
+    const AircraftState state = aircraft.GetState();
+    const AircraftState state_last = aircraft.GetLastState();
+
+    Measure(cell.duration[UPDATE], [&]{
+      task_manager.Update(state, state_last);
+    });
+
+    Measure(cell.duration[UPDATE_IDLE], [&]{
+      task_manager.UpdateIdle(state);
+      task_manager.UpdateAutoMC(state, 0);
+    });
+
+    const unsigned active = task_manager.GetActiveTaskPointIndex();
+    if (active != shadow->GetActiveIndex())
+      shadow->SetActiveTaskPoint(active);
+
+    RunSolvers(*shadow, state, task_behaviour, glide_polar,
+               dijkstra_min, dijkstra_max, cell);
+
+    ++ticks;
+    running = autopilot.UpdateAutopilot(ta, aircraft.GetState());
+  } while (running && ticks < max_ticks);
+
+  cell.ticks += ticks;
+  if (!running)
+    ++cell.finished;
+}
+
+static bool
+IsLegalSize(TaskFactoryType type, unsigned n_points)
+{
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  Waypoints waypoints;
+  TaskManager task_manager(task_behaviour, waypoints);
+  task_manager.SetFactory(type);
+
+  const TaskFactoryConstraints &constraints =
+    task_manager.GetOrderedTask().GetFactoryConstraints();
+  return n_points >= constraints.min_points &&
+    n_points <= constraints.max_points;
+}
+
+static Cell
+RunCell(const Waypoints &waypoints, TaskFactoryType type, unsigned n_points,
+        unsigned n_tasks, unsigned max_ticks)
+{
+  Cell cell;
+
+  GlidePolar glide_polar(2);
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  task_behaviour.calc_glide_required = false;
+
+  for (unsigned attempts = 0;
+       cell.tasks < n_tasks && attempts < n_tasks * MAX_ATTEMPTS;
+       ++attempts) {
+    TaskManager task_manager(task_behaviour, waypoints);
+    task_manager.SetGlidePolar(glide_polar);
+
+    OrderedTaskSettings otb =
+      task_manager.GetOrderedTask().GetOrderedTaskSettings();
+    otb.aat_min_time = type == TaskFactoryType::AAT ? 3600 : 0;
+    task_manager.SetOrderedTaskSettings(otb);
+
+    if (!test_task_random_type(task_manager, waypoints, type, n_points) ||
+        !task_manager.CheckOrderedTask()) {
+      ++cell.rejected;
+      continue;
+    }
+
+    ++cell.tasks;
+    FlyTask(task_manager, max_ticks, cell);
+
+    cell.nominal_distance +=
+      task_manager.GetOrderedTask().GetStats().distance_nominal;
+  }
+
+  return cell;
+}
+
+int
+main(int argc, char **argv)
+{
+  const unsigned n_tasks = argc > 1 ? atoi(argv[1]) : 3;
+  const unsigned max_points = argc > 2 ? atoi(argv[2]) : 10;
+  const unsigned seed = argc > 3 ? atoi(argv[3]) : 1;
+  const unsigned max_ticks = argc > 4 ? atoi(argv[4]) : 10000;
+
+  if (n_tasks == 0 || max_points < 2 || max_ticks == 0) {
+    fprintf(stderr,
+            "Usage: %s [TASKS_PER_CELL] [MAX_POINTS] [SEED] [MAX_TICKS]\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  srand(seed);
+  autopilot_parms.SetIdeal();
+
+  Waypoints waypoints;
+  if (!SetupWaypoints(waypoints)) {
+    fprintf(stderr, "Failed to set up waypoints\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("# seed=%u tasks/cell=%u max_points=%u max_ticks=%u\n",
+         seed, n_tasks, max_points, max_ticks);
+  printf("%-4s %4s %5s %5s %5s %9s %10s |",
+         "type", "pts", "tasks", "rej", "fin", "ticks", "nom_km");
+  for (unsigned i = 0; i < N_STAGES; ++i)
+    printf(" %8s", stage_names[i]);
+  printf("   (us/tick)\n");
+
+  Cell total;
+
+  for (const auto &t : factory_types) {
+    for (const unsigned n_points : task_sizes) {
+      if (n_points > max_points || !IsLegalSize(t.type, n_points))
+        continue;
+
+      const Cell cell = RunCell(waypoints, t.type, n_points,
+                                n_tasks, max_ticks);
+
+      char size[16];
+      snprintf(size, sizeof(size), "%u", n_points);
+      cell.Print(t.name, size);
+      fflush(stdout);
+
+      total.Add(cell);
+    }
+  }
+
+  total.Print("ALL", "-");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compare the two ways of reading XML into a #ConstDataNode: the
+ * XMLNode tree built by XML::ParseString(), and the
+ * XML::FlatDocument built by the streaming XML::PullParser.  The
+ * bare PullParser (no tree at all) is measured, too.
+ *
+ * Two documents are generated: a large task, and a large flat
+ * key/value document resembling a settings file.  Additional XML
+ * files may be given on the command line.
+ *
+ * Usage: BenchmarkXMLParser [TASK_POINTS] [FILE ...]
+ */
+
+#include "XML/Parser.hpp"
+#include "XML/Node.hpp"
+#include "XML/DataNodeXML.hpp"
+#include "XML/PullParser.hpp"
+#include "XML/FlatDocument.hpp"
+#include "XML/DataNodeFlat.hpp"
+#include "system/Args.hpp"
+#include "system/Path.hpp"
+#include "util/PrintException.hxx"
+#include "util/StaticString.hxx"
+#include "util/tstring.hpp"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using Clock = std::chrono::steady_clock;
+
+static tstring
+GenerateTask(unsigned n_points)
+{
+  tstring xml(_T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<Task type=\"AAT\" task_scored=\"1\" aat_min_time=\"10800\" "
+                 "start_max_speed=\"0\" start_max_height=\"0\" "
+                 "start_max_height_ref=\"0\" finish_min_height=\"0\" "
+                 "fai_finish=\"0\" min_points=\"2\" max_points=\"13\" "
+                 "homogeneous_tps=\"0\" is_closed=\"0\">\n"));
+
+  for (unsigned i = 0; i < n_points; ++i) {
+    const TCHAR *type = i == 0 ? _T("Start")
+      : (i == n_points - 1 ? _T("Finish") : _T("Area"));
+
+    StaticString<1024> point;
+    point.Format(_T("\t<Point type=\"%s\">\n"
+                    "\t\t<Waypoint name=\"TP %u &amp; Co\" id=\"%u\" "
+                    "comment=\"&lt;%u&gt; 123.450\" altitude=\"%u\">\n"
+                    "\t\t\t<Location longitude=\"%.5f\" latitude=\"%.5f\"/>\n"
+                    "\t\t</Waypoint>\n"
+                    "\t\t<ObservationZone type=\"Cylinder\" radius=\"%u\"/>\n"
+                    "\t</Point>\n"),
+                 type, i, 1000 + i, i, 100 + i % 900,
+                 6.0 + i * 0.001, 51.0 + i * 0.0007, 500 + i % 20000);
+    xml.append(point.c_str());
+  }
+
+  xml.append(_T("</Task>\n"));
+  return xml;
+}
+
+static tstring
+GenerateSettings(unsigned n_sections, unsigned n_settings)
+{
+  tstring xml(_T("<?xml version=\"1.0\"?>\n<Settings>\n"));
+
+  for (unsigned i = 0; i < n_sections; ++i) {
+    StaticString<256> line;
+    line.Format(_T("\t<Device name=\"Device %u\" driver=\"Driver%u\">\n"),
+                i, i % 7);
+    xml.append(line.c_str());
+
+    for (unsigned j = 0; j < n_settings; ++j) {
+      line.Format(_T("\t\t<Setting name=\"setting_%u\" value=\"%u\" "
+                     "unit=\"m/s\"/>\n"), j, i * 31 + j);
+      xml.append(line.c_str());
+    }
+
+    xml.append(_T("\t</Device>\n"));
+  }
+
+  xml.append(_T("</Settings>\n"));
+  return xml;
+}
+
+/**
+ * Visit all nodes and look up a few attributes, like a deserialiser
+ * would.
+ */
+static unsigned
+Walk(const ConstDataNode &node)
+{
+  unsigned n = 1;
+  if (node.GetAttribute(_T("name")) != nullptr)
+    ++n;
+  if (node.GetAttribute(_T("type")) != nullptr)
+    ++n;
+
+  for (const auto &child : node.ListChildren())
+    n += Walk(*child);
+
+  return n;
+}
+
+static unsigned
+RunTree(const tstring &xml)
+{
+  const XMLNode root = XML::ParseString(xml.c_str());
+  return Walk(ConstDataNodeXML(root));
+}
+
+static unsigned
+RunFlat(const tstring &xml)
+{
+  const XML::FlatDocument document({xml.data(), xml.size()});
+  return Walk(ConstDataNodeFlat(document, document.GetRoot()));
+}
+
+static unsigned
+RunPull(const tstring &xml)
+{
+  XML::PullParser parser({xml.data(), xml.size()});
+
+  unsigned n = 0;
+  XML::PullParser::Event event;
+  while ((event = parser.Next()) != XML::PullParser::Event::END)
+    if (event == XML::PullParser::Event::START_ELEMENT)
+      n += 1 + parser.GetAttributes().size();
+
+  return n;
+}
+
+/**
+ * Run the function repeatedly for at least 200 ms.
+ *
+ * @return the average duration of one call in microseconds
+ */
+template<typename F>
+static double
+Measure(F &&f, const tstring &xml)
+{
+  using namespace std::chrono;
+
+  unsigned n = 0;
+  const auto start = Clock::now();
+  Clock::duration elapsed;
+
+  do {
+    f(xml);
+    ++n;
+    elapsed = Clock::now() - start;
+  } while (elapsed < milliseconds(200));
+
+  return duration<double, std::micro>(elapsed).count() / n;
+}
+
+static void
+Benchmark(const char *name, const tstring &xml)
+{
+  const double tree = Measure(RunTree, xml);
+  const double flat = Measure(RunFlat, xml);
+  const double pull = Measure(RunPull, xml);
+
+  /* make sure both readers see the same document */
+  const bool same = RunTree(xml) == RunFlat(xml);
+
+  printf("%s: %lu bytes%s\n", name, (unsigned long)(xml.size() * sizeof(TCHAR)),
+         same ? "" : " (MISMATCH)");
+  printf("  %-14s %10.1f us\n", "XMLNode tree", tree);
+  printf("  %-14s %10.1f us  %4.1fx\n", "FlatDocument", flat, tree / flat);
+  printf("  %-14s %10.1f us  %4.1fx\n", "PullParser", pull, tree / pull);
+}
+
+int main(int argc, char **argv)
+try {
+  Args args(argc, argv, "[TASK_POINTS] [FILE ...]");
+
+  unsigned n_points = 500;
+  if (!args.IsEmpty()) {
+    n_points = atoi(args.GetNext());
+    if (n_points < 2) {
+      fprintf(stderr, "Invalid arguments\n");
+      return EXIT_FAILURE;
+    }
+  }
+
+  Benchmark("generated task", GenerateTask(n_points));
+  Benchmark("generated settings", GenerateSettings(32, 64));
+
+  while (!args.IsEmpty()) {
+    const auto path = args.ExpectNextPath();
+    Benchmark(path.ToUTF8().c_str(), XML::ReadFile(path));
+  }
+
+  return EXIT_SUCCESS;
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
@@ -22,17 +22,21 @@ Copyright_License {
 */
 
 #include "DebugReplayIGC.hpp"
-#include "io/FileLineReader.hpp"
-#include "IGC/IGCParser.hpp"
-#include "IGC/IGCFix.hpp"
 #include "Units/System.hpp"
 #include "system/Path.hpp"
 
+#include <iterator>
+
+DebugReplayIGC::DebugReplayIGC(Path input_file)
+  :mapping(input_file),
+   reader({mapping.data(), mapping.size()})
+{
+}
+
 DebugReplay*
 DebugReplayIGC::Create(Path input_file)
 {
-  FileLineReaderA *reader = new FileLineReaderA(input_file);
-  return new DebugReplayIGC(reader);
+  return new DebugReplayIGC(input_file);
 }
 
 bool
@@ -40,32 +44,30 @@ DebugReplayIGC::Next()
 {
   last_basic = computed_basic;
 
-  const char *line;
-  while ((line = reader->ReadLine()) != NULL) {
-    if (line[0] == 'B') {
-      IGCFix fix;
-      if (IGCParseFix(line, extensions, fix)) {
-        CopyFromFix(fix);
-
-        Compute();
-        return true;
-      }
-    } else if (line[0] == 'H') {
-      BrokenDate date;
-      if (memcmp(line, "HFDTE", 5) == 0 &&
-          IGCParseDateRecord(line, date)) {
-        (BrokenDate &)raw_basic.date_time_utc = date;
-        raw_basic.time_available.Clear();
-      }
-    } else if (line[0] == 'I') {
-      IGCParseExtensions(line, extensions);
+  if (current_fix == n_fixes) {
+    n_fixes = reader.Read(fixes, std::size(fixes));
+    current_fix = 0;
+
+    if (n_fixes == 0) {
+      if (computed_basic.time_available)
+        flying_computer.Finish(calculated.flight, computed_basic.time);
+
+      return false;
     }
-  }
 
-  if (computed_basic.time_available)
-    flying_computer.Finish(calculated.flight, computed_basic.time);
+    /* a batch never spans a "HFDTE" record, so its date applies to
+       all of these fixes */
+    const BrokenDate &new_date = reader.GetDate();
+    if (new_date.IsPlausible() && !(new_date == date)) {
+      date = new_date;
+      (BrokenDate &)raw_basic.date_time_utc = date;
+      raw_basic.time_available.Clear();
+    }
+  }
 
-  return false;
+  CopyFromFix(fixes[current_fix++]);
+  Compute();
+  return true;
 }
 
 void
@@ -24,22 +24,38 @@ Copyright_License {
 #ifndef XCSOAR_DEBUG_REPLAY_IGC_HPP
 #define XCSOAR_DEBUG_REPLAY_IGC_HPP
 
-#include "DebugReplayFile.hpp"
-#include "IGC/IGCExtensions.hpp"
-#include "io/FileLineReader.hpp"
+#include "DebugReplay.hpp"
+#include "IGC/IGCFixReader.hpp"
+#include "IGC/IGCFix.hpp"
+#include "system/FileMapping.hpp"
 
-struct IGCFix;
+class DebugReplayIGC : public DebugReplay {
+  FileMapping mapping;
+  IGCFixReader reader;
 
-class DebugReplayIGC : public DebugReplayFile {
-  IGCExtensions extensions;
+  /**
+   * The current batch of fixes obtained from #reader.
+   */
+  IGCFix fixes[256];
+  unsigned n_fixes = 0, current_fix = 0;
+
+  /**
+   * The last "HFDTE" date which was applied to #raw_basic.
+   */
+  BrokenDate date = BrokenDate::Invalid();
 
 private:
-  DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
-    extensions.clear();
-  }
+  explicit DebugReplayIGC(Path input_file);
 
 public:
+  long Size() const {
+    return mapping.size();
+  }
+
+  long Tell() const {
+    return mapping.size() - reader.GetRemaining();
+  }
+
   virtual bool Next();
 
   static DebugReplay *Create(Path input_file);
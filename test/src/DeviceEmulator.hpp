@@ -33,6 +33,12 @@ struct Emulator {
   OperationEnvironment *env;
 
   virtual ~Emulator() {}
+
+  /**
+   * Called by the main loop once per second, e.g. to send periodic
+   * data.
+   */
+  virtual void Tick() {}
 };
 
 #endif
@@ -26,6 +26,9 @@ Copyright_License {
  * NMEA data read from stdin to it.  It is useful to feed WINE with
  * it: symlink ~/.wine/dosdevices/com1 to /tmp/nmea, and configure
  * "COM1" in XCSoar.
+ *
+ * The driver "FLARM:N" emulates a FLARM in a gaggle of N simulated
+ * gliders, sending their traffic once per second (stress test).
  */
 
 #include "FLARMEmulator.hpp"
@@ -51,7 +54,17 @@ LoadEmulator(Args &args)
     return new VegaEmulator();
   else if (strcmp(driver, "FLARM") == 0)
     return new FLARMEmulator();
-  else {
+  else if (strncmp(driver, "FLARM:", 6) == 0) {
+    const unsigned n_gliders = atoi(driver + 6);
+    if (n_gliders == 0) {
+      fprintf(stderr, "Invalid number of gliders: %s\n", driver + 6);
+      exit(EXIT_FAILURE);
+    }
+
+    auto *emulator = new FLARMEmulator();
+    emulator->EnableTraffic(n_gliders);
+    return emulator;
+  } else {
     fprintf(stderr, "No such emulator driver: %s\n", driver);
     exit(EXIT_FAILURE);
   }
@@ -87,8 +100,10 @@ try {
     return EXIT_FAILURE;
   }
 
-  while (port->GetState() != PortState::FAILED)
+  while (port->GetState() != PortState::FAILED) {
     Sleep(1000);
+    emulator->Tick();
+  }
 
   delete emulator;
   return EXIT_SUCCESS;
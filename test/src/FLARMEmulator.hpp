@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_FLARM_EMULATOR_HPP
 
 #include "DeviceEmulator.hpp"
+#include "FlarmTrafficGenerator.hpp"
 #include "Device/Util/LineSplitter.hpp"
 #include "Device/Driver/FLARM/BinaryProtocol.hpp"
 #include "Device/Util/NMEAWriter.hpp"
@@ -33,24 +34,73 @@ Copyright_License {
 #include "util/Macros.hpp"
 #include "util/StaticFifoBuffer.hxx"
 #include "util/StaticString.hxx"
+#include "thread/Mutex.hxx"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <map>
+#include <vector>
 #include <stdio.h>
 #include <string.h>
 
 class FLARMEmulator : public Emulator, PortLineSplitter {
   std::map<std::string, std::string> settings;
 
-  bool binary;
+  std::atomic<bool> binary;
   StaticFifoBuffer<char, 256u> binary_buffer;
 
+  /**
+   * Serialises NMEA output from the receive thread (responses) and
+   * from Tick() (traffic).
+   */
+  Mutex write_mutex;
+
+  /**
+   * If set, a large gaggle is simulated, and its traffic is sent
+   * once per second.
+   */
+  std::unique_ptr<FlarmTrafficGenerator> traffic;
+
+  std::vector<std::string> traffic_lines;
+
 public:
   FLARMEmulator():binary(false) {
     handler = this;
   }
 
+  /**
+   * Enable the traffic stress mode with the specified number of
+   * simulated gliders.
+   */
+  void EnableTraffic(unsigned n_gliders) {
+    FlarmTrafficGenerator::Config config;
+    config.n_gliders = n_gliders;
+    traffic = std::make_unique<FlarmTrafficGenerator>(config);
+  }
+
+  void Tick() override {
+    if (traffic == nullptr || binary)
+      return;
+
+    traffic->Advance(1);
+    traffic_lines.clear();
+    traffic->Generate(traffic_lines);
+
+    const std::lock_guard<Mutex> lock(write_mutex);
+    for (const auto &line : traffic_lines)
+      if (!port->FullWrite(line.data(), line.length(), *env,
+                           std::chrono::seconds(1)) ||
+          !port->FullWrite("\r\n", 2, *env, std::chrono::seconds(1)))
+        break;
+  }
+
 private:
+  void WriteNMEA(const char *line) {
+    const std::lock_guard<Mutex> lock(write_mutex);
+    PortWriteNMEA(*port, line, *env);
+  }
+
   void PFLAC_S(NMEAInputLine &line) {
     char name[64];
     line.Read(name, ARRAY_SIZE(name));
@@ -64,7 +114,7 @@ private:
     char buffer[512];
     snprintf(buffer, ARRAY_SIZE(buffer), "PFLAC,A,%s,%s", name,
              value_buffer.c_str());
-    PortWriteNMEA(*port, buffer, *env);
+    WriteNMEA(buffer);
   }
 
   void PFLAC_R(NMEAInputLine &line) {
@@ -79,7 +129,7 @@ private:
 
     char buffer[512];
     snprintf(buffer, ARRAY_SIZE(buffer), "PFLAC,A,%s,%s", name, value);
-    PortWriteNMEA(*port, buffer, *env);
+    WriteNMEA(buffer);
   }
 
   void PFLAC(NMEAInputLine &line) {
@@ -0,0 +1,237 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FlarmTrafficGenerator.hpp"
+#include "NMEA/Checksum.hpp"
+#include "Geo/FAISphere.hpp"
+#include "Math/Util.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+#include <stdio.h>
+
+static constexpr double CLOUD_BASE = 2000;
+
+/**
+ * Circling radius [m].
+ */
+static constexpr double MIN_RADIUS = 70, MAX_RADIUS = 120;
+
+/**
+ * Sink rate while cruising [m/s].
+ */
+static constexpr double CRUISE_SINK = 1.2;
+
+FlarmTrafficGenerator::FlarmTrafficGenerator(const Config &_config)
+  :config(_config), rng(config.seed)
+{
+  std::uniform_real_distribution<double> unit(0, 1);
+
+  thermals.reserve(std::max(config.n_thermals, 1u));
+  for (unsigned i = 0; i < std::max(config.n_thermals, 1u); ++i) {
+    const double r = config.area_radius * sqrt(unit(rng));
+    const double a = 2 * M_PI * unit(rng);
+    thermals.push_back({r * sin(a), r * cos(a), 1 + 3 * unit(rng)});
+  }
+
+  gliders.reserve(config.n_gliders + 1);
+  for (unsigned i = 0; i <= config.n_gliders; ++i) {
+    Glider glider;
+    glider.id = 0xD00000 + i * 0x0101;
+    glider.thermal = i % thermals.size();
+    glider.altitude = 800 + 1000 * unit(rng);
+    glider.speed = 22 + 6 * unit(rng);
+    glider.heading = 2 * M_PI * unit(rng);
+
+    const Thermal &thermal = thermals[glider.thermal];
+    glider.x = thermal.x;
+    glider.y = thermal.y;
+
+    /* the own aircraft (index 0) always circles */
+    if (i > 0 && unit(rng) < config.cruise_fraction) {
+      const double a = 2 * M_PI * unit(rng);
+      glider.x += config.area_radius * sin(a);
+      glider.y += config.area_radius * cos(a);
+      StartCruising(glider);
+    } else {
+      StartCircling(glider);
+
+      /* place the glider on its circle */
+      const double radius = glider.speed / fabs(glider.turn_rate);
+      const double side = glider.turn_rate > 0 ? M_PI_2 : -M_PI_2;
+      glider.x -= radius * sin(glider.heading + side);
+      glider.y -= radius * cos(glider.heading + side);
+    }
+
+    gliders.push_back(glider);
+  }
+}
+
+void
+FlarmTrafficGenerator::StartCircling(Glider &glider)
+{
+  std::uniform_real_distribution<double> unit(0, 1);
+
+  const double radius = MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * unit(rng);
+  const double direction = unit(rng) < 0.5 ? -1 : 1;
+  glider.turn_rate = direction * glider.speed / radius;
+  glider.climb_rate = thermals[glider.thermal].strength;
+}
+
+void
+FlarmTrafficGenerator::StartCruising(Glider &glider)
+{
+  if (thermals.size() > 1) {
+    std::uniform_int_distribution<unsigned> pick(0, thermals.size() - 2);
+    unsigned next = pick(rng);
+    if (next >= glider.thermal)
+      ++next;
+    glider.thermal = next;
+  }
+
+  const Thermal &thermal = thermals[glider.thermal];
+  glider.heading = atan2(thermal.x - glider.x, thermal.y - glider.y);
+  glider.turn_rate = 0;
+  glider.climb_rate = -CRUISE_SINK;
+}
+
+void
+FlarmTrafficGenerator::Advance(double dt)
+{
+  time += dt;
+
+  for (auto &glider : gliders) {
+    glider.heading = fmod(glider.heading + glider.turn_rate * dt, 2 * M_PI);
+    if (glider.heading < 0)
+      glider.heading += 2 * M_PI;
+
+    glider.x += glider.speed * sin(glider.heading) * dt;
+    glider.y += glider.speed * cos(glider.heading) * dt;
+    glider.altitude += glider.climb_rate * dt;
+
+    if (glider.turn_rate != 0) {
+      if (glider.altitude >= CLOUD_BASE && &glider != &gliders.front())
+        StartCruising(glider);
+      else if (glider.altitude >= CLOUD_BASE)
+        glider.climb_rate = 0;
+    } else {
+      const Thermal &thermal = thermals[glider.thermal];
+      if (Square(thermal.x - glider.x) + Square(thermal.y - glider.y) <
+          Square(MAX_RADIUS))
+        StartCircling(glider);
+    }
+  }
+}
+
+GeoPoint
+FlarmTrafficGenerator::ToGeoPoint(double x, double y) const
+{
+  const double lat = config.origin.latitude.Degrees()
+    + y / FAISphere::REARTH * 180 / M_PI;
+  const double lon = config.origin.longitude.Degrees()
+    + x / (FAISphere::REARTH * config.origin.latitude.cos()) * 180 / M_PI;
+  return GeoPoint(Angle::Degrees(lon), Angle::Degrees(lat));
+}
+
+static void
+AppendSentence(std::vector<std::string> &lines, const char *sentence)
+{
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "$%s*%02X",
+           sentence, NMEAChecksum(sentence));
+  lines.emplace_back(buffer);
+}
+
+/**
+ * Format an angle as NMEA "ddmm.mmmm" (or "dddmm.mmmm").
+ */
+static void
+FormatNMEAAngle(char *buffer, size_t size, Angle angle, bool longitude)
+{
+  const double value = fabs(angle.Degrees());
+  const unsigned degrees = (unsigned)value;
+  const double minutes = (value - degrees) * 60;
+  const bool negative = angle.Native() < 0;
+  snprintf(buffer, size, longitude ? "%03u%07.4f,%c" : "%02u%07.4f,%c",
+           degrees, minutes,
+           longitude
+           ? (negative ? 'W' : 'E')
+           : (negative ? 'S' : 'N'));
+}
+
+unsigned
+FlarmTrafficGenerator::Generate(std::vector<std::string> &lines) const
+{
+  const Glider &own = gliders.front();
+  const GeoPoint location = ToGeoPoint(own.x, own.y);
+
+  const unsigned t = (unsigned)time % (24 * 3600);
+  const unsigned hour = t / 3600, minute = (t / 60) % 60, second = t % 60;
+
+  char latitude[32], longitude[32];
+  FormatNMEAAngle(latitude, sizeof(latitude), location.latitude, false);
+  FormatNMEAAngle(longitude, sizeof(longitude), location.longitude, true);
+
+  char sentence[200];
+  snprintf(sentence, sizeof(sentence),
+           "GPRMC,%02u%02u%02u,A,%s,%s,%.1f,%.1f,120621,,,A",
+           hour, minute, second, latitude, longitude,
+           own.speed * 3600 / 1852, own.heading * 180 / M_PI);
+  AppendSentence(lines, sentence);
+
+  snprintf(sentence, sizeof(sentence),
+           "GPGGA,%02u%02u%02u,%s,%s,1,08,1.0,%.1f,M,47.0,M,,",
+           hour, minute, second, latitude, longitude, own.altitude);
+  AppendSentence(lines, sentence);
+
+  unsigned n_traffic = 0, max_alarm = 0;
+  for (auto i = std::next(gliders.begin()); i != gliders.end(); ++i) {
+    const Glider &glider = *i;
+
+    const double north = glider.y - own.y, east = glider.x - own.x;
+    const double vertical = glider.altitude - own.altitude;
+    const double distance = hypot(north, east);
+    if (distance > config.range)
+      continue;
+
+    unsigned alarm = 0;
+    if (fabs(vertical) < 50)
+      alarm = distance < 50 ? 3 : distance < 100 ? 2 : distance < 150 ? 1 : 0;
+    max_alarm = std::max(max_alarm, alarm);
+
+    snprintf(sentence, sizeof(sentence),
+             "PFLAA,%u,%.0f,%.0f,%.0f,2,%06X,%.0f,%.0f,%.0f,%.1f,1",
+             alarm, north, east, vertical, (unsigned)glider.id,
+             glider.heading * 180 / M_PI, glider.turn_rate * 180 / M_PI,
+             glider.speed, glider.climb_rate);
+    AppendSentence(lines, sentence);
+    ++n_traffic;
+  }
+
+  snprintf(sentence, sizeof(sentence), "PFLAU,%u,1,2,1,%u,,0,,",
+           std::min(n_traffic, 99u), max_alarm);
+  AppendSentence(lines, sentence);
+
+  return n_traffic;
+}
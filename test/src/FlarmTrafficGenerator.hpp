@@ -0,0 +1,171 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_GENERATOR_HPP
+#define XCSOAR_FLARM_TRAFFIC_GENERATOR_HPP
+
+#include "Geo/GeoPoint.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Simulates a large gaggle: many gliders circling in a few shared
+ * thermals, climbing to cloud base and then cruising to another
+ * thermal.  Generates the NMEA output a FLARM in one of these
+ * gliders would send: GPRMC, GPGGA, one PFLAA per target within
+ * range, and PFLAU.
+ *
+ * The simulation is deterministic for a given seed.
+ */
+class FlarmTrafficGenerator {
+public:
+  struct Config {
+    GeoPoint origin = GeoPoint(Angle::Degrees(7.7061111111111114),
+                               Angle::Degrees(51.051944444444445));
+
+    /**
+     * The number of gliders, not including the own one.
+     */
+    unsigned n_gliders = 200;
+
+    unsigned n_thermals = 5;
+
+    /**
+     * Thermals are placed within this radius around #origin [m].
+     */
+    double area_radius = 3000;
+
+    /**
+     * Targets further away than this are not reported [m].
+     */
+    double range = 10000;
+
+    /**
+     * The fraction of gliders which are cruising initially.
+     */
+    double cruise_fraction = 0.2;
+
+    unsigned seed = 1;
+  };
+
+private:
+  struct Thermal {
+    /**
+     * Position relative to the origin [m].
+     */
+    double x, y;
+
+    /**
+     * Climb rate [m/s].
+     */
+    double strength;
+  };
+
+  struct Glider {
+    uint32_t id;
+
+    /**
+     * Position relative to the origin [m].
+     */
+    double x, y;
+
+    double altitude;
+
+    /**
+     * Heading [rad], clockwise from north.
+     */
+    double heading;
+
+    /**
+     * [m/s]
+     */
+    double speed;
+
+    /**
+     * [rad/s]; zero while cruising.
+     */
+    double turn_rate;
+
+    /**
+     * [m/s]
+     */
+    double climb_rate;
+
+    /**
+     * The thermal this glider is circling in, or heading to.
+     */
+    unsigned thermal;
+  };
+
+  const Config config;
+
+  std::mt19937 rng;
+
+  std::vector<Thermal> thermals;
+
+  /**
+   * The gliders; the first one is the own aircraft.
+   */
+  std::vector<Glider> gliders;
+
+  /**
+   * Seconds of the day.
+   */
+  double time = 12 * 3600;
+
+public:
+  explicit FlarmTrafficGenerator(const Config &config);
+
+  /**
+   * Move all gliders.
+   *
+   * @param dt the time step [s]
+   */
+  void Advance(double dt);
+
+  /**
+   * Append the NMEA sentences describing the current state, each one
+   * complete with leading '$' and checksum, but without line end.
+   *
+   * @return the number of PFLAA sentences
+   */
+  unsigned Generate(std::vector<std::string> &lines) const;
+
+  /**
+   * The ids of the simulated targets (not including the own
+   * aircraft), as hexadecimal FLARM id numbers.
+   */
+  uint32_t GetTargetId(unsigned i) const {
+    return gliders[i + 1].id;
+  }
+
+private:
+  void StartCircling(Glider &glider);
+  void StartCruising(Glider &glider);
+
+  GeoPoint ToGeoPoint(double x, double y) const;
+};
+
+#endif
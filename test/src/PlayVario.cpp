@@ -21,8 +21,16 @@ Copyright_License {
 }
 */
 
+/*
+ * Plays the vario sound of a replayed flight, and reports the
+ * latency between parsing a vario value and the moment the
+ * according samples are produced (plus, with ALSA, the time until
+ * they leave the speaker).
+ */
+
 #include "Audio/PCMPlayer.hpp"
 #include "Audio/PCMPlayerFactory.hpp"
+#include "Audio/PCMDataSource.hpp"
 #include "Audio/VarioSynthesiser.hpp"
 #include "ui/window/Init.hpp"
 #include "system/Args.hpp"
@@ -30,22 +38,122 @@ Copyright_License {
 #include "event/FineTimerEvent.hxx"
 #include "DebugReplay.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 #include <stdio.h>
 #include <stdlib.h>
 
-#include <memory>
+using Clock = std::chrono::steady_clock;
+
+/**
+ * A #PCMDataSource wrapping the #VarioSynthesiser which measures how
+ * long it takes for a vario value to reach the audio thread.
+ */
+class LatencyProbe final : public PCMDataSource {
+  VarioSynthesiser &synthesiser;
+
+#if defined(ENABLE_ALSA) && !defined(ENABLE_SDL)
+  const ALSAPCMPlayer *alsa_player = nullptr;
+#endif
+
+  /**
+   * The time stamp of the most recent vario value which has not yet
+   * been seen by GetData() [Clock ticks], or 0.
+   */
+  std::atomic<Clock::rep> pending{0};
+
+  /* the following attributes are only accessed by GetData() while
+     the player is running */
+
+  unsigned n = 0;
+  Clock::duration sum{}, min = Clock::duration::max(), max{};
+
+public:
+  explicit LatencyProbe(VarioSynthesiser &_synthesiser) noexcept
+    :synthesiser(_synthesiser) {}
+
+#if defined(ENABLE_ALSA) && !defined(ENABLE_SDL)
+  void SetALSAPlayer(const ALSAPCMPlayer &player) noexcept {
+    alsa_player = &player;
+  }
+#endif
+
+  /**
+   * Pass a new vario value to the synthesiser.
+   */
+  void SetVario(double vario) noexcept {
+    const auto now = Clock::now();
+    synthesiser.SetVario(vario);
+    pending.store(now.time_since_epoch().count(), std::memory_order_release);
+  }
+
+  void PrintReport() const noexcept {
+    using std::chrono::duration;
+    using ms = duration<double, std::milli>;
+
+    if (n == 0) {
+      printf("no latency samples\n");
+      return;
+    }
+
+    printf("latency: n=%u min=%.2f avg=%.2f max=%.2f ms\n", n,
+           ms(min).count(), ms(sum / n).count(), ms(max).count());
+
+#if defined(ENABLE_ALSA) && !defined(ENABLE_SDL)
+    if (alsa_player != nullptr)
+      printf("ALSA buffer underruns: %u\n", alsa_player->GetXrunCount());
+#endif
+  }
+
+  /* virtual methods from class PCMDataSource */
+  bool IsBigEndian() const override {
+    return synthesiser.IsBigEndian();
+  }
+
+  unsigned GetSampleRate() const override {
+    return synthesiser.GetSampleRate();
+  }
+
+  size_t GetData(int16_t *buffer, size_t size) override {
+    const Clock::rep t = pending.exchange(0, std::memory_order_acquire);
+    const size_t result = synthesiser.GetData(buffer, size);
+
+    if (t != 0) {
+      Clock::duration latency = Clock::now() - Clock::time_point(Clock::duration(t));
+
+#if defined(ENABLE_ALSA) && !defined(ENABLE_SDL)
+      /* the new samples will be played after the ones which are
+         already queued in the device */
+      if (alsa_player != nullptr)
+        latency += std::chrono::duration_cast<Clock::duration>
+          (std::chrono::duration<double>((double)alsa_player->GetDelayFrames()
+                                         / GetSampleRate()));
+#endif
+
+      ++n;
+      sum += latency;
+      min = std::min(min, latency);
+      max = std::max(max, latency);
+    }
+
+    return result;
+  }
+};
 
 class ReplayTimer {
   FineTimerEvent timer;
   DebugReplay &replay;
-  VarioSynthesiser &synthesiser;
+  LatencyProbe &probe;
 
 public:
   ReplayTimer(EventLoop &event_loop,
               DebugReplay &_replay,
-              VarioSynthesiser &_synthesiser)
+              LatencyProbe &_probe)
     :timer(event_loop, BIND_THIS_METHOD(OnTimer)),
-     replay(_replay), synthesiser(_synthesiser) {}
+     replay(_replay), probe(_probe) {}
 
   ~ReplayTimer() {
     timer.Cancel();
@@ -67,8 +175,8 @@ private:
     }
 
     auto vario = replay.Basic().brutto_vario;
+    probe.SetVario(vario);
     printf("%2.1f\n", (double)vario);
-    synthesiser.SetVario(vario);
 
     timer.Schedule(std::chrono::seconds(1));
   }
@@ -94,16 +202,24 @@ main(int argc, char **argv)
   const unsigned sample_rate = 44100;
 
   VarioSynthesiser synthesiser(sample_rate);
+  LatencyProbe probe(synthesiser);
 
-  if (!player->Start(synthesiser)) {
+#if defined(ENABLE_ALSA) && !defined(ENABLE_SDL)
+  probe.SetALSAPlayer(static_cast<const ALSAPCMPlayer &>(*player));
+#endif
+
+  if (!player->Start(probe)) {
     fprintf(stderr, "Failed to start PCMPlayer\n");
     return EXIT_FAILURE;
   }
 
-  ReplayTimer timer(event_loop, *replay, synthesiser);
+  ReplayTimer timer(event_loop, *replay, probe);
   timer.Start();
 
   event_loop.Run();
 
+  player->Stop();
+  probe.PrintReport();
+
   return EXIT_SUCCESS;
 }
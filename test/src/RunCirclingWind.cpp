@@ -28,9 +28,12 @@ Copyright_License {
 #include "Formatter/TimeFormatter.hpp"
 #include "Computer/Settings.hpp"
 
+#include <chrono>
 #include <stdio.h>
 #include <memory>
 
+using Clock = std::chrono::steady_clock;
+
 int main(int argc, char **argv)
 {
   Args args(argc, argv, "DRIVER FILE");
@@ -51,6 +54,9 @@ int main(int argc, char **argv)
   CirclingWind circling_wind;
   circling_wind.Reset();
 
+  Clock::duration elapsed{};
+  unsigned n_samples = 0;
+
   while (replay->Next()) {
     circling_computer.TurnRate(replay->SetCalculated(),
                                replay->Basic(),
@@ -60,8 +66,12 @@ int main(int argc, char **argv)
                               replay->Calculated().flight,
                               circling_settings);
 
+    const auto start = Clock::now();
     CirclingWind::Result result = circling_wind.NewSample(replay->Basic(),
                                                           replay->Calculated());
+    elapsed += Clock::now() - start;
+    ++n_samples;
+
     if (result.quality > 0) {
       TCHAR time_buffer[32];
       FormatTime(time_buffer, replay->Basic().time);
@@ -72,5 +82,10 @@ int main(int argc, char **argv)
                (double)result.wind.norm);
     }
   }
+
+  const std::chrono::duration<double, std::micro> us = elapsed;
+  fprintf(stderr, "# %u samples, %.0f us, %.3f us per sample\n",
+          n_samples, us.count(),
+          n_samples > 0 ? us.count() / n_samples : 0.);
 }
 
@@ -28,8 +28,11 @@ Copyright_License {
 #include "system/Args.hpp"
 #include "DebugReplay.hpp"
 
+#include <chrono>
 #include <stdio.h>
 
+using Clock = std::chrono::steady_clock;
+
 int main(int argc, char **argv)
 {
   Args args(argc, argv, "DRIVER FILE");
@@ -50,6 +53,9 @@ int main(int argc, char **argv)
   WindEKFGlue wind_ekf;
   wind_ekf.Reset();
 
+  Clock::duration elapsed{};
+  unsigned n_samples = 0;
+
   while (replay->Next()) {
     const MoreData &data = replay->Basic();
     const DerivedInfo &calculated = replay->Calculated();
@@ -57,8 +63,12 @@ int main(int argc, char **argv)
     circling_computer.TurnRate(replay->SetCalculated(),
                                data, calculated.flight);
 
+    const auto start = Clock::now();
     WindEKFGlue::Result result =
       wind_ekf.Update(data, replay->Calculated());
+    elapsed += Clock::now() - start;
+    ++n_samples;
+
     if (result.quality > 0) {
       TCHAR time_buffer[32];
       FormatTime(time_buffer, data.time);
@@ -72,5 +82,10 @@ int main(int argc, char **argv)
     }
   }
 
+  const std::chrono::duration<double, std::micro> us = elapsed;
+  fprintf(stderr, "# %u samples, %.0f us, %.3f us per sample\n",
+          n_samples, us.count(),
+          n_samples > 0 ? us.count() / n_samples : 0.);
+
   delete replay;
 }
@@ -0,0 +1,116 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/AdaptiveSchedule.hpp"
+#include "TestUtil.hpp"
+
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+static AdaptiveSchedule::Stamp
+At(unsigned ms)
+{
+  return AdaptiveSchedule::Stamp(milliseconds(1000000 + ms));
+}
+
+static void
+TestCheap()
+{
+  AdaptiveSchedule s(milliseconds(500), seconds(5), 20, 2);
+
+  ok1(s.IsDue(At(0), false));
+  ok1(!s.Record(At(0), At(1)));
+  ok1(s.GetPeriod(false) == milliseconds(500));
+  ok1(!s.IsDue(At(499), false));
+  ok1(s.IsDue(At(500), false));
+
+  /* the minimum period is not stretched while circling */
+  ok1(s.GetPeriod(true) == milliseconds(500));
+  ok1(s.GetMissedDeadlines() == 0);
+}
+
+static void
+TestExpensive()
+{
+  AdaptiveSchedule s(milliseconds(500), seconds(5), 20, 2);
+
+  /* 200 ms at a 20% budget: one run per second */
+  s.Record(At(0), At(200));
+  ok1(s.GetCost() == milliseconds(200));
+  ok1(s.GetPeriod(false) == seconds(1));
+  ok1(s.GetPeriod(true) == seconds(2));
+  ok1(!s.IsDue(At(999), false));
+  ok1(s.IsDue(At(1000), false));
+  ok1(!s.IsDue(At(1999), true));
+
+  /* cost decays slowly after the calculation became cheap again */
+  s.Record(At(1000), At(1000));
+  ok1(s.GetCost() == milliseconds(175));
+
+  /* ... but follows an increase quickly */
+  s.Record(At(2000), At(2625));
+  ok1(s.GetCost() == milliseconds(400));
+  ok1(s.GetPeriod(false) == seconds(2));
+  ok1(s.GetMissedDeadlines() == 0);
+}
+
+static void
+TestMissed()
+{
+  AdaptiveSchedule s(milliseconds(500), seconds(5), 20);
+
+  /* 1.5 s would need a period of 7.5 s */
+  ok1(s.Record(At(0), At(1500)));
+  ok1(s.GetPeriod(false) == seconds(5));
+  ok1(s.GetMissedDeadlines() == 1);
+
+  s.Reset();
+  ok1(s.GetMissedDeadlines() == 0);
+  ok1(s.IsDue(At(0), false));
+}
+
+static void
+TestMaxPeriod()
+{
+  AdaptiveSchedule s(milliseconds(500), seconds(5), 20, 2);
+
+  /* 1.5 s would need a period of 7.5 s; the maximum period is only
+     stretched while circling */
+  ok1(s.Record(At(0), At(1500)));
+  ok1(s.GetPeriod(false) == seconds(5));
+  ok1(s.GetPeriod(true) == seconds(10));
+  ok1(s.IsDue(At(5000), false));
+  ok1(!s.IsDue(At(9999), true));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(27);
+
+  TestCheap();
+  TestExpensive();
+  TestMissed();
+  TestMaxPeriod();
+
+  return exit_status();
+}
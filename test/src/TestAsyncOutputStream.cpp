@@ -0,0 +1,94 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Logger/AsyncOutputStream.hpp"
+#include "io/FileOutputStream.hxx"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+#include "util/PrintException.hxx"
+
+#include <string>
+
+#include <stdio.h>
+#include <tchar.h>
+
+static std::string
+ReadFile(const char *path)
+{
+  std::string result;
+
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return result;
+
+  char buffer[4096];
+  size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    result.append(buffer, nbytes);
+
+  fclose(file);
+  return result;
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(5);
+
+  const Path path(_T("output/test/async.txt"));
+
+  std::string expected;
+
+  FileOutputStream file(path, FileOutputStream::Mode::CREATE_VISIBLE);
+
+  /* use the smallest possible ring buffer to exercise wrap-around
+     and the overflow buffer */
+  AsyncOutputStream async(file, AsyncOutputStream::BLOCK_SIZE);
+
+  for (unsigned i = 0; i < 20000; ++i) {
+    char line[64];
+    int length = snprintf(line, sizeof(line),
+                          "$GPRMC,%u,A,5103.117,N,00742.367,E*%02X\n",
+                          i, i % 256);
+    async.Write(line, length);
+    expected.append(line, length);
+  }
+
+  async.Close();
+  file.Commit();
+
+  /* calling Close() again is allowed */
+  async.Close();
+
+  const auto stats = async.GetStats();
+  ok1(stats.n_discarded == 0);
+  ok1(stats.max_queued <= AsyncOutputStream::BLOCK_SIZE);
+  ok1(stats.n_writes > 0);
+  ok1(stats.n_syncs > 0);
+
+  ok1(ReadFile("output/test/async.txt") == expected);
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
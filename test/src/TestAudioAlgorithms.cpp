@@ -0,0 +1,237 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Audio/AudioAlgorithms.hpp"
+#include "Audio/ToneSynthesiser.hpp"
+#include "Audio/VarioSynthesiser.hpp"
+#include "util/ByteOrder.hxx"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <math.h>
+
+/**
+ * The straightforward formula which all kernels must match.
+ */
+static int16_t
+Reference(int16_t dest, int16_t src, bool byte_swap, bool mix,
+          unsigned vol_percent)
+{
+  int32_t value = byte_swap ? (int16_t)GenericByteSwap16(src) : src;
+  value = value * VolumeToGain(vol_percent) >> 15;
+  if (mix)
+    value += dest;
+  return Clip(value);
+}
+
+static bool
+CheckKernel(bool byte_swap, bool mix, unsigned vol_percent, size_t n)
+{
+  std::mt19937 rng(n * 101 + vol_percent);
+  std::uniform_int_distribution<int> dist(-32768, 32767);
+
+  std::vector<int16_t> src(n), dest(n);
+  for (size_t i = 0; i < n; ++i) {
+    src[i] = dist(rng);
+    dest[i] = dist(rng);
+  }
+
+  /* a few extreme values to exercise the clipping */
+  if (n > 3) {
+    src[0] = src[1] = 32767;
+    dest[0] = 32767;
+    src[2] = dest[2] = -32768;
+  }
+
+  std::vector<int16_t> expected(n);
+  for (size_t i = 0; i < n; ++i)
+    expected[i] = vol_percent == 0
+      ? 0
+      : Reference(dest[i], src[i], byte_swap, mix, vol_percent);
+
+  if (mix) {
+    if (byte_swap)
+      ByteSwapAndMixPCM(dest.data(), src.data(), n, vol_percent);
+    else
+      MixPCM(dest.data(), src.data(), n, vol_percent);
+  } else {
+    /* in-place */
+    dest = src;
+    if (byte_swap)
+      ByteSwapAndLowerVolume(dest.data(), n, vol_percent);
+    else
+      LowerVolume(dest.data(), n, vol_percent);
+  }
+
+  return dest == expected;
+}
+
+static void
+TestKernels()
+{
+  static constexpr unsigned volumes[] = { 0, 1, 37, 50, 99, 100 };
+
+  for (unsigned flags = 0; flags < 4; ++flags) {
+    const bool byte_swap = flags & 1, mix = flags & 2;
+
+    bool success = true;
+    for (unsigned vol_percent : volumes)
+      for (size_t n : { 0, 1, 7, 8, 9, 1023 })
+        success = CheckKernel(byte_swap, mix, vol_percent, n) && success;
+
+    ok(success, "kernel byte_swap=%d mix=%d", byte_swap, mix);
+  }
+}
+
+static void
+TestClipping()
+{
+  int16_t dest[16], src[16];
+  std::fill_n(dest, 16, 30000);
+  std::fill_n(src, 16, 10000);
+  MixPCM(dest, src, 16, 100);
+  ok1(std::all_of(dest, dest + 16, [](int16_t i){ return i == 32767; }));
+
+  std::fill_n(dest, 16, -30000);
+  std::fill_n(src, 16, -10000);
+  MixPCM(dest, src, 16, 100);
+  ok1(std::all_of(dest, dest + 16, [](int16_t i){ return i == -32768; }));
+
+  /* negative big-endian samples must remain negative */
+  std::fill_n(src, 16, (int16_t)GenericByteSwap16((uint16_t)-1000));
+  std::fill_n(dest, 16, 0);
+  ByteSwapAndMixPCM(dest, src, 16, 100);
+  ok1(std::all_of(dest, dest + 16, [](int16_t i){ return i == -1000; }));
+}
+
+static void
+TestTone(unsigned sample_rate, unsigned tone_hz)
+{
+  ToneSynthesiser synthesiser(sample_rate);
+  synthesiser.SetTone(tone_hz);
+
+  /* ten seconds */
+  std::vector<int16_t> buffer(sample_rate * 10);
+  synthesiser.Synthesise(buffer.data(), buffer.size() / 2);
+  synthesiser.Synthesise(buffer.data() + buffer.size() / 2,
+                         buffer.size() - buffer.size() / 2);
+
+  /* count the rising zero crossings to measure the frequency */
+  unsigned n_crossings = 0;
+  for (size_t i = 1; i < buffer.size(); ++i)
+    if (buffer[i - 1] < 0 && buffer[i] >= 0)
+      ++n_crossings;
+
+  ok(fabs(n_crossings / 10. - tone_hz) < 0.2,
+     "frequency %u Hz: %.1f", tone_hz, n_crossings / 10.);
+
+  /* compare the first second with an ideal sine wave */
+  double signal = 0, noise = 0;
+  for (size_t i = 0; i < sample_rate; ++i) {
+    const double ideal = 32767 * sin(2 * M_PI * tone_hz * i / sample_rate);
+    signal += ideal * ideal;
+    noise += (buffer[i] - ideal) * (buffer[i] - ideal);
+  }
+
+  const double snr = 10 * log10(signal / noise);
+  ok(snr > 80, "SNR %u Hz: %.1f dB", tone_hz, snr);
+}
+
+static void
+TestVolume()
+{
+  ToneSynthesiser synthesiser(44100);
+  synthesiser.SetTone(1000);
+  synthesiser.SetVolume(50);
+
+  int16_t buffer[4410];
+  synthesiser.Synthesise(buffer, 4410);
+
+  const auto minmax = std::minmax_element(buffer, buffer + 4410);
+  ok1(*minmax.second > 16300 && *minmax.second <= 16384);
+  ok1(*minmax.first < -16300 && *minmax.first >= -16384);
+}
+
+gcc_pure
+static int16_t
+Peak(const int16_t *buffer, size_t n)
+{
+  int16_t peak = 0;
+  for (size_t i = 0; i < n; ++i)
+    peak = std::max<int16_t>(peak, std::abs(buffer[i]));
+  return peak;
+}
+
+static void
+TestVarioSynthesiser()
+{
+  VarioSynthesiser synthesiser(44100);
+
+  int16_t buffer[4410];
+
+  /* silent until the first value arrives */
+  synthesiser.Synthesise(buffer, 4410);
+  ok1(Peak(buffer, 4410) == 0);
+
+  /* sinking: continuous tone */
+  synthesiser.SetVario(-1);
+  synthesiser.Synthesise(buffer, 4410);
+  ok1(Peak(buffer, 4410) > 32000);
+
+  /* settings are applied by the next Synthesise() call */
+  synthesiser.SetVolume(50);
+  synthesiser.Synthesise(buffer, 4410);
+  const int16_t peak = Peak(buffer + 100, 4310);
+  ok1(peak > 16300 && peak <= 16384);
+
+  /* silence finishes the current wave, then stays silent */
+  synthesiser.SetSilence();
+  synthesiser.Synthesise(buffer, 4410);
+  ok1(Peak(buffer + 2205, 2205) == 0);
+
+  /* dead band */
+  synthesiser.SetDeadBand(true);
+  synthesiser.SetVario(0);
+  synthesiser.Synthesise(buffer, 4410);
+  ok1(Peak(buffer, 4410) == 0);
+}
+
+int
+main()
+{
+  plan_tests(4 + 3 + 4 * 2 + 2 + 5);
+
+  TestKernels();
+  TestClipping();
+  TestTone(44100, 440);
+  TestTone(44100, 1723);
+  TestTone(48000, 500);
+  TestTone(22050, 1200);
+  TestVolume();
+  TestVarioSynthesiser();
+
+  return exit_status();
+}
@@ -0,0 +1,157 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/TrafficStore.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned value)
+{
+  char buffer[16];
+  sprintf(buffer, "%06X", value);
+  return FlarmId::Parse(buffer, nullptr);
+}
+
+static void
+TestBasic()
+{
+  FlarmTrafficStore store;
+  ok1(store.IsEmpty());
+  ok1(store.Find(MakeId(0xDD1234)) == nullptr);
+
+  auto &a = store.Insert(MakeId(0xDD1234), 10);
+  ok1(store.GetSize() == 1);
+  ok1(a.traffic.id == MakeId(0xDD1234));
+  ok1(!a.traffic.valid);
+  ok1(a.last_update == 10);
+
+  a.traffic.relative_north = 42;
+  ok1(&store.Insert(MakeId(0xDD1234), 20) == &a);
+  ok1(store.GetSize() == 1);
+  ok1(store.Find(MakeId(0xDD1234))->traffic.relative_north == 42);
+
+  ok1(!store.Remove(MakeId(0x123456)));
+  ok1(store.Remove(MakeId(0xDD1234)));
+  ok1(store.IsEmpty());
+  ok1(store.Find(MakeId(0xDD1234)) == nullptr);
+}
+
+/**
+ * Insert and remove many ids in random order, and compare with a
+ * simple reference.
+ */
+static void
+TestChurn()
+{
+  FlarmTrafficStore store;
+  bool present[4096] = {};
+  unsigned n_present = 0;
+
+  bool consistent = true;
+  unsigned seed = 1;
+  for (unsigned i = 0; i < 200000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const unsigned value = (seed >> 8) % 4096 + 1;
+    const FlarmId id = MakeId(value * 4099);
+
+    if (present[value - 1]) {
+      if (!store.Remove(id))
+        consistent = false;
+      present[value - 1] = false;
+      --n_present;
+    } else if (n_present < FlarmTrafficStore::MAX_SIZE) {
+      store.Insert(id, 0).traffic.relative_north = value;
+      present[value - 1] = true;
+      ++n_present;
+    }
+
+    if (store.GetSize() != n_present)
+      consistent = false;
+  }
+
+  for (unsigned value = 1; value <= 4096; ++value) {
+    const auto *entry = store.Find(MakeId(value * 4099));
+    if ((entry != nullptr) != present[value - 1] ||
+        (entry != nullptr && entry->traffic.relative_north != value))
+      consistent = false;
+  }
+
+  ok1(consistent);
+}
+
+static void
+TestExpire()
+{
+  FlarmTrafficStore store;
+
+  for (unsigned i = 1; i <= 40; ++i)
+    store.Insert(MakeId(i), i);
+
+  ok1(store.GetSize() == 40);
+
+  /* entries older than 60 seconds */
+  store.Expire(80, 60);
+  ok1(store.GetSize() == 21);
+  ok1(store.Find(MakeId(19)) == nullptr);
+  ok1(store.Find(MakeId(20)) != nullptr);
+  ok1(store.Find(MakeId(40)) != nullptr);
+
+  /* time warp */
+  store.Expire(30, 60);
+  ok1(store.GetSize() == 11);
+  ok1(store.Find(MakeId(30)) != nullptr);
+  ok1(store.Find(MakeId(31)) == nullptr);
+}
+
+static void
+TestEvict()
+{
+  FlarmTrafficStore store;
+
+  for (unsigned i = 1; i <= FlarmTrafficStore::MAX_SIZE; ++i)
+    store.Insert(MakeId(i), 100 + i);
+
+  ok1(store.GetSize() == FlarmTrafficStore::MAX_SIZE);
+
+  /* the least recently updated entry makes room for the new one */
+  store.Insert(MakeId(0xABCDEF), 1000);
+  ok1(store.GetSize() == FlarmTrafficStore::MAX_SIZE);
+  ok1(store.Find(MakeId(1)) == nullptr);
+  ok1(store.Find(MakeId(2)) != nullptr);
+  ok1(store.Find(MakeId(0xABCDEF)) != nullptr);
+}
+
+int
+main()
+{
+  plan_tests(13 + 1 + 8 + 5);
+
+  TestBasic();
+  TestChurn();
+  TestExpire();
+  TestEvict();
+
+  return exit_status();
+}
@@ -23,12 +23,17 @@
 #include "IGC/IGCParser.hpp"
 #include "IGC/IGCExtensions.hpp"
 #include "IGC/IGCFix.hpp"
+#include "IGC/IGCFixLayout.hpp"
+#include "IGC/IGCFixReader.hpp"
 #include "IGC/IGCHeader.hpp"
 #include "IGC/IGCDeclaration.hpp"
 #include "time/BrokenDate.hpp"
 #include "time/BrokenTime.hpp"
+#include "util/StringView.hxx"
 #include "TestUtil.hpp"
 
+#include <iterator>
+
 #include <string.h>
 
 static void
@@ -190,6 +195,107 @@ TestFix()
   ok1(fix.gps_altitude == 7);
 }
 
+static bool
+IsSameFix(const IGCFix &a, const IGCFix &b)
+{
+  return a.time == b.time &&
+    a.location.latitude.Native() == b.location.latitude.Native() &&
+    a.location.longitude.Native() == b.location.longitude.Native() &&
+    a.gps_valid == b.gps_valid &&
+    a.gps_altitude == b.gps_altitude &&
+    a.pressure_altitude == b.pressure_altitude &&
+    a.enl == b.enl && a.rpm == b.rpm && a.hdm == b.hdm && a.hdt == b.hdt &&
+    a.trm == b.trm && a.trt == b.trt && a.gsp == b.gsp && a.ias == b.ias &&
+    a.tas == b.tas && a.siu == b.siu;
+}
+
+static void
+TestFixLayout()
+{
+  IGCExtensions extensions;
+  ok1(IGCParseExtensions("I043638FXA3941ENL4246GSP4749TRT", extensions));
+
+  IGCFixLayout layout;
+  IGCCompileFixLayout(extensions, layout);
+  ok1(layout.fields.size() == 3);
+
+  static constexpr const char *bad_lines[] = {
+    "",
+    "B1122385103117N00742367EA",
+    "B1122385103117X00742367EA0049000487",
+    "B1122385103117N00742367XA0049000487",
+    "B1122389003117N00742367EA0049000487",
+    "B1122385103117N18042367EA0049000487",
+    "B1122385163117N00742367EA0049000487",
+    "B1122385103117N00762367EA0049000487",
+    "B1122385103117N00742367EX0049000487",
+  };
+
+  IGCFix fix;
+  for (const char *line : bad_lines)
+    ok1(!IGCParseFix(StringView(line), layout, fix));
+
+  /* both parsers must return the same results */
+  static constexpr const char *good_lines[] = {
+    "B1122385103117N00742367EA0049000487",
+    "B1122385103117N00742367EV0049000487",
+    "B1122535103117S00742367WA104900000700000",
+    "B1122535103117S00742367WA104900000700012309512270",
+    "B1122535103117S00742367WA-001200007000123095122700",
+    "B1122535103117S00742367WA104900000700012309512",
+    "B1122535103117S00742367WA1049000007000X2309512270",
+  };
+
+  IGCFix expected, fixes[std::size(good_lines)];
+  for (unsigned i = 0; i < std::size(good_lines); ++i) {
+    ok1(IGCParseFix(good_lines[i], extensions, expected));
+    ok1(IGCParseFix(StringView(good_lines[i]), layout, fixes[i]));
+    ok1(IsSameFix(expected, fixes[i]));
+  }
+
+  ok1(fixes[3].enl == 123);
+  ok1(fixes[3].gsp == 95);
+  ok1(fixes[3].trt == 270);
+  ok1(fixes[4].pressure_altitude == -12);
+  ok1(fixes[5].gsp == 95 && fixes[5].trt == -1);
+  ok1(fixes[6].enl == -1 && fixes[6].gsp == 95);
+}
+
+static void
+TestFixReader()
+{
+  static constexpr char data[] =
+    "AXCSFLIGHT:1\r\n"
+    "HFDTE040910\r\n"
+    "I023638ENL3941GSP\r\n"
+    "B1122385103117N00742367EA0049000487123095\r\n"
+    "B1122395103117N00742367EV0049000487\r\n"
+    "B11224garbage\r\n"
+    "\r\n"
+    "HFDTE050910\r\n"
+    "B1122405103117N00742367EA0049000487";
+
+  IGCFixReader reader(ConstBuffer<void>(data, sizeof(data) - 1));
+
+  IGCFix fixes[8];
+  ok1(reader.Read(fixes, std::size(fixes)) == 2);
+  ok1(reader.GetDate() == BrokenDate(2010, 9, 4));
+  ok1(fixes[0].time == BrokenTime(11, 22, 38));
+  ok1(fixes[0].gps_valid);
+  ok1(fixes[0].enl == 123);
+  ok1(fixes[0].gsp == 95);
+  ok1(fixes[1].time == BrokenTime(11, 22, 39));
+  ok1(!fixes[1].gps_valid);
+  ok1(fixes[1].enl == -1);
+
+  ok1(reader.Read(fixes, std::size(fixes)) == 1);
+  ok1(reader.GetDate() == BrokenDate(2010, 9, 5));
+  ok1(fixes[0].time == BrokenTime(11, 22, 40));
+  ok1(reader.GetRemaining() == 0);
+
+  ok1(reader.Read(fixes, std::size(fixes)) == 0);
+}
+
 static void
 TestFixTime()
 {
@@ -270,13 +376,15 @@ TestDeclarationTurnpoint()
 
 int main(int argc, char **argv)
 {
-  plan_tests(148);
+  plan_tests(200);
 
   TestHeader();
   TestDate();
   TestLocation();
   TestExtensions();
   TestFix();
+  TestFixLayout();
+  TestFixReader();
   TestFixTime();
   TestDeclarationHeader();
   TestDeclarationTurnpoint();
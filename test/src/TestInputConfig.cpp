@@ -0,0 +1,202 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Input/InputConfig.hpp"
+#include "Input/InputParser.hpp"
+#include "Input/InputLookup.hpp"
+#include "io/LineReader.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <memory>
+#include <vector>
+
+static void
+DummyEvent(const TCHAR *)
+{
+}
+
+pt2Event
+InputEvents::findEvent(const TCHAR *data)
+{
+  return StringIsEqual(data, _T("Dummy")) ? DummyEvent : nullptr;
+}
+
+int
+InputEvents::findGCE(const TCHAR *data)
+{
+  return -1;
+}
+
+int
+InputEvents::findNE(const TCHAR *data)
+{
+  return -1;
+}
+
+class StringArrayLineReader final : public TLineReader {
+  const TCHAR *const*lines;
+  TCHAR buffer[256];
+
+public:
+  explicit StringArrayLineReader(const TCHAR *const*_lines) noexcept
+    :lines(_lines) {}
+
+  TCHAR *ReadLine() override {
+    if (*lines == nullptr)
+      return nullptr;
+
+    CopyString(buffer, *lines++, 256);
+    return buffer;
+  }
+};
+
+static void
+TestShortGestureIndex()
+{
+  static constexpr TCHAR directions[] = _T("UDRL");
+
+  std::vector<bool> seen(InputConfig::N_SHORT_GESTURES, false);
+  unsigned count = 0;
+  bool all_valid = true;
+
+  for (unsigned length = 1; length <= InputConfig::MAX_SHORT_GESTURE;
+       ++length) {
+    unsigned total = 1;
+    for (unsigned i = 0; i < length; ++i)
+      total *= 4;
+
+    for (unsigned value = 0; value < total; ++value) {
+      TCHAR gesture[InputConfig::MAX_SHORT_GESTURE + 1];
+      for (unsigned i = 0, v = value; i < length; ++i, v /= 4)
+        gesture[length - 1 - i] = directions[v % 4];
+      gesture[length] = _T('\0');
+
+      const int index = InputConfig::GetShortGestureIndex(gesture);
+      if (index < 0 || unsigned(index) >= seen.size() || seen[index]) {
+        all_valid = false;
+        continue;
+      }
+
+      seen[index] = true;
+      ++count;
+    }
+  }
+
+  ok1(all_valid);
+  ok1(count == InputConfig::N_SHORT_GESTURES);
+
+  ok1(InputConfig::GetShortGestureIndex(_T("")) == -1);
+  ok1(InputConfig::GetShortGestureIndex(_T("UX")) == -1);
+  ok1(InputConfig::GetShortGestureIndex(_T("u")) == -1);
+  ok1(InputConfig::GetShortGestureIndex(_T("UDUDUDU")) == -1);
+  ok1(InputConfig::GetShortGestureIndex(_T("U")) == 0);
+  ok1(InputConfig::GetShortGestureIndex(_T("LLLLLL")) ==
+      int(InputConfig::N_SHORT_GESTURES - 1));
+}
+
+static void
+TestGestureEvents(InputConfig &config)
+{
+  config.SetDefaults();
+
+  ok1(config.GetGestureEvent(_T("U")) == 0);
+  ok1(config.GetGestureEvent(_T("UDLRUDL")) == 0);
+
+  config.SetGestureEvent(_T("U"), 1);
+  config.SetGestureEvent(_T("UD"), 2);
+  config.SetGestureEvent(_T("UDLRUDL"), 3);
+  config.SetGestureEvent(_T("UDLRUDLR"), 4);
+
+  ok1(config.GetGestureEvent(_T("U")) == 1);
+  ok1(config.GetGestureEvent(_T("UD")) == 2);
+  ok1(config.GetGestureEvent(_T("DU")) == 0);
+  ok1(config.GetGestureEvent(_T("UDLRUDL")) == 3);
+  ok1(config.GetGestureEvent(_T("UDLRUDLR")) == 4);
+  ok1(config.GetGestureEvent(_T("UDLRUD")) == 0);
+
+  /* one entry per gesture: the last one wins */
+  config.SetGestureEvent(_T("UD"), 5);
+  config.SetGestureEvent(_T("UDLRUDL"), 6);
+  ok1(config.GetGestureEvent(_T("UD")) == 5);
+  ok1(config.GetGestureEvent(_T("UDLRUDL")) == 6);
+
+  config.SetDefaults();
+  ok1(config.GetGestureEvent(_T("UD")) == 0);
+  ok1(config.GetGestureEvent(_T("UDLRUDL")) == 0);
+}
+
+static void
+TestParser(InputConfig &config)
+{
+  static constexpr const TCHAR *lines[] = {
+    _T("mode=default"),
+    _T("type=gesture"),
+    _T("data=RL"),
+    _T("event=Dummy first"),
+    _T(""),
+    _T("mode=default"),
+    _T("type=gesture"),
+    _T("data=RLRLRLRL"),
+    _T("event=Dummy second"),
+    _T(""),
+    _T("mode=default"),
+    _T("type=gesture"),
+    _T("data=RX"),
+    _T("event=Dummy invalid"),
+    _T(""),
+    nullptr
+  };
+
+  config.SetDefaults();
+
+  StringArrayLineReader reader(lines);
+  ParseInputFile(config, reader);
+
+  const unsigned short_event = config.GetGestureEvent(_T("RL"));
+  const unsigned long_event = config.GetGestureEvent(_T("RLRLRLRL"));
+  ok1(short_event > 0);
+  ok1(long_event > 0);
+  ok1(short_event != long_event);
+  ok1(config.GetGestureEvent(_T("RX")) == 0);
+
+  ok1(short_event < config.events.size() &&
+      config.events[short_event].event == DummyEvent &&
+      StringIsEqual(config.events[short_event].misc, _T("first")));
+  ok1(long_event < config.events.size() &&
+      StringIsEqual(config.events[long_event].misc, _T("second")));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(8 + 12 + 6);
+
+  /* too large for the stack */
+  auto config = std::make_unique<InputConfig>();
+
+  TestShortGestureIndex();
+  TestGestureEvents(*config);
+  TestParser(*config);
+
+  return exit_status();
+}
@@ -21,6 +21,7 @@
 */
 
 #include "Math/LeastSquares.hpp"
+#include "Math/ConvexFilter.hpp"
 #include "TestUtil.hpp"
 
 #include <stdio.h>
@@ -82,12 +83,155 @@ LSTest1(double w)
   return true;
 }
 
+/**
+ * Feed a 10 hour flight sampled once per second; the slots must be
+ * decimated instead of dropping the tail of the data set.
+ */
+static void
+TestDecimate()
+{
+  LeastSquares ls;
+  ls.Reset();
+
+  constexpr unsigned n = 36000;
+  for (unsigned i = 0; i < n; ++i)
+    ls.Update(i / 3600., 1000. + i % 100);
+
+  const auto slots = ls.GetSlots();
+  ok1(ls.GetCount() == n);
+  ok1(slots.size <= 1000);
+  ok1(slots.size > 500);
+
+  /* the slots still span the whole flight */
+  ok1(slots.front().x < 0.01);
+  ok1(slots.back().x > 9.9);
+
+  unsigned total = 0;
+  bool ordered = true;
+  double last_x = -1;
+  for (const auto &i : slots) {
+    total += i.n;
+    ordered = ordered && i.x > last_x;
+    last_x = i.x;
+  }
+
+  ok1(total == n);
+  ok1(ordered);
+
+  /* merged slots hold the mean of their samples */
+  ok1(equals(slots.front().y, 1000. + (slots.front().n - 1) / 2.));
+  ok1(equals(ls.GetAverageY(), 1049.5));
+  ok1(equals(ls.GetMaxX(), (n - 1) / 3600.));
+}
+
+/**
+ * Exposes LeastSquares::Remove(), which is only used by ConvexFilter.
+ */
+class RemovableLeastSquares : public LeastSquares {
+public:
+  using LeastSquares::Remove;
+};
+
+static constexpr double
+SampleX(unsigned i)
+{
+  return i / 100.;
+}
+
+static constexpr double
+SampleY(unsigned i)
+{
+  return 50 + 0.3 * SampleX(i) + (i % 7);
+}
+
+static constexpr double
+SampleWeight(unsigned i)
+{
+  return 1 + i % 3;
+}
+
+/**
+ * Removing a merged slot from a decimated store must give the same
+ * fit as a fresh store which never saw those samples.
+ */
+static void
+TestRemoveDecimated()
+{
+  constexpr unsigned n = 3000;
+
+  RemovableLeastSquares ls;
+  ls.Reset();
+  for (unsigned i = 0; i < n; ++i)
+    ls.Update(SampleX(i), SampleY(i), SampleWeight(i));
+
+  const auto slots = ls.GetSlots();
+  ok1(slots.front().n > 1);
+
+  /* merged slots hold the weighted mean of their samples */
+  double sum_w = 0, sum_xw = 0;
+  for (unsigned i = 0; i < slots.front().n; ++i) {
+    sum_w += SampleWeight(i);
+    sum_xw += SampleX(i) * SampleWeight(i);
+  }
+  ok1(equals(slots.front().x, sum_xw / sum_w));
+
+  /* locate the samples of the slot to be removed */
+  const unsigned remove = slots.size / 2;
+  unsigned first = 0;
+  for (unsigned i = 0; i < remove; ++i)
+    first += slots[i].n;
+  const unsigned last = first + slots[remove].n;
+
+  ls.Remove(remove);
+
+  LeastSquares fresh;
+  fresh.Reset();
+  for (unsigned i = 0; i < n; ++i)
+    if (i < first || i >= last)
+      fresh.Update(SampleX(i), SampleY(i), SampleWeight(i));
+
+  ok1(ls.GetCount() == fresh.GetCount());
+  ok1(equals(ls.GetGradient(), fresh.GetGradient()));
+  ok1(equals(ls.GetYAt(0), fresh.GetYAt(0)));
+  ok1(equals(ls.GetAverageY(), fresh.GetAverageY()));
+}
+
+/**
+ * A convex hull with more vertices than slots must not merge
+ * vertices; the oldest ones are dropped instead.
+ */
+static void
+TestConvexFull()
+{
+  ConvexFilter filter;
+  filter.Reset();
+
+  /* a concave curve: every point is a vertex of the upper hull */
+  constexpr unsigned n = 2500;
+  for (unsigned i = 1; i <= n; ++i)
+    filter.UpdateConvexPositive(i, sqrt(double(i)));
+
+  const auto slots = filter.GetSlots();
+  ok1(slots.size > 900);
+
+  bool single = true;
+  for (const auto &i : slots)
+    single = single && i.n == 1;
+  ok1(single);
+
+  ok1(equals(slots.back().x, double(n)));
+  ok1(equals(filter.GetLastY(), sqrt(double(n))));
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(2);
+  plan_tests(22);
 
   ok1(LSTest1(1));
   ok1(LSTest1(2));
+  TestDecimate();
+  TestRemoveDecimated();
+  TestConvexFull();
 
   return exit_status();
 }
@@ -0,0 +1,252 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/LiftMap.hpp"
+#include "Computer/LiftMapFile.hpp"
+#include "Computer/LiftMapComputer.hpp"
+#include "NMEA/MoreData.hpp"
+#include "NMEA/FlyingState.hpp"
+#include "Geo/Math.hpp"
+#include "io/LineReader.hpp"
+#include "io/OutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+/* 2020-06-01 12:00 UTC */
+static constexpr int64_t T0 = 1591012800;
+
+static const GeoPoint base(Angle::Degrees(7.7), Angle::Degrees(51.4));
+
+class StringOutputStream final : public OutputStream {
+public:
+  std::string value;
+
+  void Write(const void *data, size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+class StringLineReader final : public NLineReader {
+  std::string buffer;
+  std::string::size_type position = 0;
+
+public:
+  explicit StringLineReader(std::string _buffer)
+    :buffer(std::move(_buffer)) {}
+
+  char *ReadLine() override {
+    if (position >= buffer.size())
+      return nullptr;
+
+    char *line = &buffer[position];
+    const auto eol = buffer.find('\n', position);
+    if (eol == std::string::npos) {
+      position = buffer.size();
+    } else {
+      buffer[eol] = '\0';
+      position = eol + 1;
+    }
+
+    return line;
+  }
+};
+
+static void
+TestMerge()
+{
+  LiftMap map;
+  ok1(map.IsEmpty());
+
+  /* samples a few metres apart end up in the same cell */
+  map.Add(base, 2, T0);
+  map.Add(FindLatitudeLongitude(base, Angle::Degrees(90), 20), 4, T0 + 1);
+  map.Add(FindLatitudeLongitude(base, Angle::Degrees(0), 20), 3, T0 + 2);
+  ok1(map.size() == 1);
+
+  const auto *cell = map.FindNearest(base, 500, 0);
+  ok1(cell != nullptr);
+  ok1(cell->n == 3);
+  ok1(equals(cell->lift, 3));
+  ok1(cell->time == T0 + 2);
+  ok1(cell->location.DistanceS(base) < 20);
+
+  /* a sample far away gets a new cell */
+  map.Add(FindLatitudeLongitude(base, Angle::Degrees(180), 2000), -1, T0 + 3);
+  ok1(map.size() == 2);
+}
+
+static void
+TestFindNearest()
+{
+  LiftMap map;
+
+  const GeoPoint weak = FindLatitudeLongitude(base, Angle::Degrees(0), 1000);
+  const GeoPoint strong = FindLatitudeLongitude(base, Angle::Degrees(90), 3000);
+  const GeoPoint old = FindLatitudeLongitude(base, Angle::Degrees(270), 2000);
+  map.Add(weak, 0.5, T0);
+  map.Add(strong, 2.5, T0);
+  map.Add(old, 3, T0 - 3600);
+
+  auto *cell = map.FindNearest(base, 5000, 0);
+  ok1(cell != nullptr && cell->location.DistanceS(weak) < 1);
+
+  cell = map.FindNearest(base, 5000, 1);
+  ok1(cell != nullptr && cell->location.DistanceS(old) < 1);
+
+  cell = map.FindNearest(base, 5000, 1, T0 - 60);
+  ok1(cell != nullptr && cell->location.DistanceS(strong) < 1);
+
+  ok1(map.FindNearest(base, 500, 0) == nullptr);
+  ok1(map.FindNearest(base, 5000, 5) == nullptr);
+
+  unsigned n = 0;
+  map.VisitWithinRange(base, 2500, [&n](const LiftMap::Cell &){ ++n; });
+  ok1(n == 2);
+}
+
+static void
+TestBounded()
+{
+  LiftMap map;
+
+  /* a row of cells, one sample each; the oldest ones should be
+     discarded first */
+  const unsigned total = LiftMap::MAX_CELLS + LiftMap::MAX_CELLS / 2;
+  for (unsigned i = 0; i < total; ++i)
+    map.Add(FindLatitudeLongitude(base, Angle::Degrees(90),
+                                  i * 2 * LiftMap::CELL_SIZE),
+            1, T0 + i * 60);
+
+  ok1(map.size() <= LiftMap::MAX_CELLS);
+  ok1(map.size() > LiftMap::MAX_CELLS / 2);
+
+  /* the most recent sample survives, the first one does not */
+  ok1(map.FindNearest(FindLatitudeLongitude(base, Angle::Degrees(90),
+                                            (total - 1) * 2 * LiftMap::CELL_SIZE),
+                      50, 0) != nullptr);
+  ok1(map.FindNearest(base, 50, 0) == nullptr);
+
+  map.Clear();
+  ok1(map.IsEmpty());
+  map.Add(base, 1, T0);
+  ok1(map.size() == 1);
+}
+
+static void
+TestFile()
+{
+  LiftMap map;
+  for (unsigned i = 0; i < 100; ++i)
+    map.Add(FindLatitudeLongitude(base, Angle::Degrees(i * 3.6),
+                                  500 + i * 50),
+            i * 0.05, T0 + i);
+
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  SaveLiftMapFile(bos, map);
+  bos.Flush();
+
+  /* append garbage which must be ignored */
+  sos.value += "garbage\n1 2 3\n91 7 1 1 0\n";
+
+  StringLineReader reader(std::move(sos.value));
+  LiftMap loaded;
+  LoadLiftMapFile(reader, loaded);
+  ok1(loaded.size() == map.size());
+
+  bool match = true;
+  map.VisitAll([&](const LiftMap::Cell &cell){
+    const auto *other = loaded.FindNearest(cell.location, 1, -10);
+    if (other == nullptr || other->x != cell.x || other->y != cell.y ||
+        other->n != cell.n || other->time != cell.time ||
+        fabs(other->lift - cell.lift) > 0.01)
+      match = false;
+  });
+  ok1(match);
+}
+
+/**
+ * Only the pilot's own flights go into the persistent map, not
+ * replayed or simulated ones.
+ */
+static void
+TestComputer()
+{
+  MoreData basic;
+  basic.Reset();
+  basic.clock = 1;
+  basic.time_available.Update(basic.clock);
+  basic.time = 12 * 3600;
+  basic.date_time_utc = BrokenDateTime(2020, 6, 1, 12, 0, 0);
+  basic.location = base;
+  basic.location_available.Update(basic.clock);
+  basic.brutto_vario = 2;
+
+  FlyingState flight;
+  flight.Reset();
+  flight.flying = true;
+
+  LiftMap map;
+  LiftMapComputer computer;
+  computer.Reset();
+
+  ok1(!computer.Update(map, basic, flight, false));
+
+  /* the first call only starts the clock */
+  computer.Update(map, basic, flight, true);
+  basic.time += 1;
+  ok1(computer.Update(map, basic, flight, true));
+  ok1(map.size() == 1);
+
+  /* at most one sample per second */
+  ok1(!computer.Update(map, basic, flight, true));
+
+  basic.time += 1;
+  basic.gps.replay = true;
+  ok1(!computer.Update(map, basic, flight, true));
+
+  basic.time += 1;
+  basic.gps.replay = false;
+  basic.gps.simulator = true;
+  ok1(!computer.Update(map, basic, flight, true));
+
+  const auto *cell = map.FindNearest(base, 500, 0);
+  ok1(cell != nullptr && cell->n == 1);
+}
+
+int
+main()
+{
+  plan_tests(29);
+
+  TestMerge();
+  TestFindNearest();
+  TestBounded();
+  TestFile();
+  TestComputer();
+
+  return exit_status();
+}
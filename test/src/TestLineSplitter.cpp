@@ -0,0 +1,127 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/Util/LineSplitter.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <vector>
+
+#include <string.h>
+
+class Collector : public PortLineSplitter {
+public:
+  std::vector<std::string> lines;
+
+  void Feed(const char *data) noexcept {
+    DataReceived(data, strlen(data));
+  }
+
+  void Feed(const char *data, size_t length) noexcept {
+    DataReceived(data, length);
+  }
+
+protected:
+  bool LineReceived(const char *line) noexcept override {
+    lines.emplace_back(line);
+    return true;
+  }
+};
+
+static void
+TestBasic()
+{
+  Collector c;
+  c.Feed("$GPRMC,1*00\r\n$GPGGA,2*00\n");
+  ok1(c.lines.size() == 2);
+  ok1(c.lines.size() == 2 && c.lines[0] == "$GPRMC,1*00");
+  ok1(c.lines.size() == 2 && c.lines[1] == "$GPGGA,2*00");
+}
+
+static void
+TestSplit()
+{
+  /* feed one byte at a time */
+  Collector c;
+  const char *data = "$PFLAU,3,1,2*00\r\n$PGRMZ,1234,f*00\r\n";
+  for (const char *p = data; *p != 0; ++p)
+    c.Feed(p, 1);
+
+  ok1(c.lines.size() == 2);
+  ok1(c.lines.size() == 2 && c.lines[0] == "$PFLAU,3,1,2*00");
+  ok1(c.lines.size() == 2 && c.lines[1] == "$PGRMZ,1234,f*00");
+}
+
+static void
+TestSanitise()
+{
+  Collector c;
+
+  /* control characters become spaces, trailing whitespace is
+     removed */
+  c.Feed("a\tb\x01" "c \x02\r\n");
+  ok1(c.lines.size() == 1 && c.lines[0] == "a b c");
+
+  /* binary garbage before a NUL byte is skipped */
+  static constexpr char binary[] = "\x07\xff\x00\x12$GPRMC\n";
+  c.lines.clear();
+  c.Feed(binary, sizeof(binary) - 1);
+  ok1(c.lines.size() == 1 && c.lines[0] == " $GPRMC");
+
+  /* empty lines */
+  c.lines.clear();
+  c.Feed("\r\n\n");
+  ok1(c.lines.size() == 2 && c.lines[0].empty() && c.lines[1].empty());
+}
+
+static void
+TestOverflow()
+{
+  Collector c;
+
+  const std::string long_line(1000, 'x');
+  c.Feed(long_line.data(), long_line.size());
+  c.Feed("yyy\n$GPRMC\n");
+
+  /* the long line is discarded completely */
+  ok1(c.lines.size() == 1 && c.lines[0] == "$GPRMC");
+
+  /* the longest allowed line */
+  c.lines.clear();
+  const std::string max_line(255, 'z');
+  c.Feed(max_line.data(), max_line.size());
+  c.Feed("\n");
+  ok1(c.lines.size() == 1 && c.lines[0] == max_line);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(11);
+
+  TestBasic();
+  TestSplit();
+  TestSanitise();
+  TestOverflow();
+
+  return exit_status();
+}
@@ -21,6 +21,7 @@
 */
 
 #include "Profile/Profile.hpp"
+#include "Profile/Map.hpp"
 #include "io/FileLineReader.hpp"
 #include "system/Path.hpp"
 #include "TestUtil.hpp"
@@ -59,6 +60,11 @@ TestMap()
     Profile::Set("key3", -42);
     ok1(Profile::Get("key3", value));
     ok1(value == -42u);
+
+    /* above INT_MAX */
+    Profile::Set("key3", 3000000000u);
+    ok1(Profile::Get("key3", value));
+    ok1(value == 3000000000u);
   }
 
   {
@@ -81,6 +87,48 @@ TestMap()
   }
 }
 
+static void
+TestChanges()
+{
+  ProfileMap map;
+  map.Set("key1", "1");
+  map.Set("key2", "abc");
+
+  {
+    int value;
+    ok1(map.Get("key1", value));
+    ok1(value == 1);
+    ok1(!map.Get("key2", value));
+
+    /* the parsed value follows modifications */
+    map.Set("key2", "0x10");
+    ok1(map.Get("key2", value));
+    ok1(value == 16);
+  }
+
+  map.SetModified(false);
+  const unsigned serial = map.GetSerial();
+
+  /* setting the same value again is not a modification */
+  map.Set("key1", "1");
+  ok1(!map.IsModified());
+  ok1(map.GetSerial() == serial);
+  ok1(!map.IsModifiedSince("key1", serial));
+
+  map.Set("key1", "2");
+  map.Set("key3", "3");
+  ok1(map.IsModified());
+  ok1(map.IsModifiedSince("key1", serial));
+  ok1(!map.IsModifiedSince("key2", serial));
+  ok1(map.IsModifiedSince("key3", serial));
+
+  const unsigned serial2 = map.GetSerial();
+  map.Remove("key3");
+  ok1(!map.Exists("key3"));
+  ok1(map.GetSerial() != serial2);
+  ok1(!map.IsModifiedSince("key1", serial2));
+}
+
 static void
 TestWriter()
 {
@@ -140,9 +188,10 @@ TestReader()
 
 int main(int argc, char **argv)
 try {
-  plan_tests(31);
+  plan_tests(48);
 
   TestMap();
+  TestChanges();
   TestWriter();
   TestReader();
 
@@ -0,0 +1,157 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "io/ReadAheadReader.hpp"
+#include "io/FileLineReader.hpp"
+#include "system/Path.hpp"
+#include "TestUtil.hpp"
+#include "util/PrintException.hxx"
+
+#include <string>
+
+#include <stdio.h>
+#include <string.h>
+#include <tchar.h>
+
+static std::string
+MakeData(size_t size)
+{
+  std::string result;
+  result.reserve(size);
+
+  /* a simple LCG; lines of varying length */
+  unsigned x = 42;
+  while (result.size() < size) {
+    x = x * 1103515245 + 12345;
+    const unsigned length = (x >> 16) % 200;
+    for (unsigned i = 0; i < length; ++i)
+      result.push_back('a' + (x >> (i % 16)) % 26);
+    result.push_back('\n');
+  }
+
+  result.resize(size);
+  return result;
+}
+
+static bool
+WriteFile(const char *path, const std::string &data)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == nullptr)
+    return false;
+
+  bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
+  return fclose(file) == 0 && success;
+}
+
+static std::string
+ReadAll(ReadAheadReader &reader, size_t chunk_size)
+{
+  std::string result;
+  std::string buffer(chunk_size, 0);
+
+  size_t nbytes;
+  while ((nbytes = reader.Read(buffer.data(), chunk_size)) > 0)
+    result.append(buffer.data(), nbytes);
+
+  return result;
+}
+
+static void
+TestLarge()
+{
+  /* not a multiple of the request size */
+  const std::string data = MakeData(3 * 1024 * 1024 + 12345);
+  if (!WriteFile("output/test/readahead.txt", data)) {
+    skip(5, 0, "failed to write test file");
+    return;
+  }
+
+  ReadAheadReader reader(Path(_T("output/test/readahead.txt")));
+  ok1(reader.GetSize() == data.size());
+
+  ok1(ReadAll(reader, 1000) == data);
+  ok1(reader.GetPosition() == data.size());
+
+  reader.Rewind();
+  ok1(reader.GetPosition() == 0);
+  ok1(ReadAll(reader, 100000) == data);
+
+  if (reader.IsAsync())
+    diag("using io_uring");
+}
+
+static void
+TestSmall()
+{
+  const std::string data = MakeData(5000);
+  if (!WriteFile("output/test/readahead.txt", data)) {
+    skip(2, 0, "failed to write test file");
+    return;
+  }
+
+  ReadAheadReader reader(Path(_T("output/test/readahead.txt")));
+  ok1(!reader.IsAsync());
+  ok1(ReadAll(reader, 333) == data);
+}
+
+static void
+TestLines()
+{
+  const std::string data = MakeData(1024 * 1024);
+  if (!WriteFile("output/test/readahead.txt", data)) {
+    skip(2, 0, "failed to write test file");
+    return;
+  }
+
+  unsigned expected_lines = 0;
+  for (char ch : data)
+    if (ch == '\n')
+      ++expected_lines;
+
+  /* the last line has no line feed */
+  if (data.back() != '\n')
+    ++expected_lines;
+
+  FileLineReaderA reader(Path(_T("output/test/readahead.txt")));
+  unsigned n_lines = 0;
+  while (reader.ReadLine() != nullptr)
+    ++n_lines;
+
+  ok1(n_lines == expected_lines);
+  ok1(reader.Tell() == (long)data.size());
+}
+
+int main(int argc, char **argv)
+try {
+  plan_tests(9);
+
+  TestLarge();
+  TestSmall();
+  TestLines();
+
+  return exit_status();
+} catch (...) {
+  PrintException(std::current_exception());
+  return EXIT_FAILURE;
+}
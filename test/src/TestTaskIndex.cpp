@@ -0,0 +1,243 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Task/TaskIndex.hpp"
+#include "system/Path.hpp"
+#include "io/LineReader.hpp"
+#include "io/OutputStream.hxx"
+#include "io/BufferedOutputStream.hxx"
+#include "TestUtil.hpp"
+
+#include <string>
+
+class StringOutputStream final : public OutputStream {
+public:
+  std::string value;
+
+  void Write(const void *data, size_t size) override {
+    value.append((const char *)data, size);
+  }
+};
+
+class StringLineReader final : public NLineReader {
+  std::string buffer;
+  std::string::size_type position = 0;
+
+public:
+  explicit StringLineReader(std::string _buffer)
+    :buffer(std::move(_buffer)) {}
+
+  char *ReadLine() override {
+    if (position >= buffer.size())
+      return nullptr;
+
+    char *line = &buffer[position];
+    const auto eol = buffer.find('\n', position);
+    if (eol == std::string::npos) {
+      position = buffer.size();
+    } else {
+      buffer[eol] = '\0';
+      position = eol + 1;
+    }
+
+    return line;
+  }
+};
+
+static std::string
+Save(TaskIndex &index)
+{
+  StringOutputStream sos;
+  BufferedOutputStream bos(sos);
+  index.Save(bos);
+  bos.Flush();
+  return std::move(sos.value);
+}
+
+static void
+TestLookup()
+{
+  TaskIndex index;
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1, 2) == nullptr);
+  ok1(!index.IsModified());
+
+  index.Set(Path(_T("/a.tsk")), 1000, 200, {tstring()});
+  ok1(index.IsModified());
+  ok1(index.size() == 1);
+
+  const auto *entry = index.Lookup(Path(_T("/a.tsk")), 1000, 200);
+  ok1(entry != nullptr);
+  ok1(entry->names.size() == 1);
+  ok1(entry->names.front().empty());
+
+  /* modification time or size changed: stale */
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1001, 200) == nullptr);
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1000, 201) == nullptr);
+  ok1(index.Lookup(Path(_T("/b.tsk")), 1000, 200) == nullptr);
+}
+
+static void
+TestScan()
+{
+  TaskIndex index;
+  index.Set(Path(_T("/a.tsk")), 1, 1, {});
+  index.Set(Path(_T("/b.tsk")), 2, 2, {});
+  index.Set(Path(_T("/c.tsk")), 3, 3, {});
+  Save(index);
+  ok1(!index.IsModified());
+
+  /* "b" was deleted, "c" was modified */
+  index.BeginScan();
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1, 1) != nullptr);
+  ok1(index.Lookup(Path(_T("/c.tsk")), 4, 3) == nullptr);
+  index.EndScan({_T(".tsk")});
+
+  ok1(index.IsModified());
+  ok1(index.size() == 2);
+  ok1(index.Lookup(Path(_T("/b.tsk")), 2, 2) == nullptr);
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1, 1) != nullptr);
+
+  /* the stale entry survives until it gets replaced */
+  index.Set(Path(_T("/c.tsk")), 4, 3, {_T("x")});
+  ok1(index.Lookup(Path(_T("/c.tsk")), 4, 3) != nullptr);
+}
+
+static void
+TestScanExtensions()
+{
+  TaskIndex index;
+  index.Set(Path(_T("/a.tsk")), 1, 1, {});
+  index.Set(Path(_T("/b.cup")), 2, 2, {});
+  index.Set(Path(_T("/c.IGC")), 3, 3, {});
+
+  /* a scan which covered only task files must not expire the
+     others */
+  index.BeginScan();
+  index.EndScan({_T(".tsk")});
+  ok1(index.size() == 2);
+  ok1(index.Lookup(Path(_T("/a.tsk")), 1, 1) == nullptr);
+  ok1(index.Lookup(Path(_T("/b.cup")), 2, 2) != nullptr);
+  ok1(index.Lookup(Path(_T("/c.IGC")), 3, 3) != nullptr);
+
+  index.BeginScan();
+  ok1(index.Lookup(Path(_T("/b.cup")), 2, 2) != nullptr);
+  index.EndScan({_T(".tsk"), _T(".cup"), _T(".igc")});
+  ok1(index.size() == 1);
+  ok1(index.Lookup(Path(_T("/b.cup")), 2, 2) != nullptr);
+}
+
+static void
+TestRoundTrip()
+{
+  TaskIndex index;
+  index.Set(Path(_T("/data/tasks/one.tsk")), 1591012800, 1234, {tstring()});
+  index.Set(Path(_T("/data/contest.cup")), 1591012801, 99999,
+            {_T("Day 1"), _T("Day 2"), tstring(), _T("Day 4")});
+  index.Set(Path(_T("/data/empty.igc")), 5, 0, {});
+
+  const std::string data = Save(index);
+  ok1(data.compare(0, 23, "# XCSoar task index v1\n") == 0);
+
+  TaskIndex loaded;
+  StringLineReader reader(data);
+  loaded.Load(reader);
+  ok1(!loaded.IsModified());
+  ok1(loaded.size() == 3);
+
+  auto entry = loaded.Lookup(Path(_T("/data/tasks/one.tsk")), 1591012800, 1234);
+  ok1(entry != nullptr && entry->names.size() == 1 &&
+      entry->names.front().empty());
+
+  entry = loaded.Lookup(Path(_T("/data/contest.cup")), 1591012801, 99999);
+  ok1(entry != nullptr && entry->names.size() == 4);
+  ok1(entry != nullptr && entry->names[1] == _T("Day 2"));
+  ok1(entry != nullptr && entry->names[2].empty());
+
+  entry = loaded.Lookup(Path(_T("/data/empty.igc")), 5, 0);
+  ok1(entry != nullptr && entry->names.empty());
+
+  /* saving again yields the same file */
+  ok1(Save(loaded) == data);
+}
+
+static void
+TestMalformed()
+{
+  /* wrong version: ignored completely */
+  {
+    TaskIndex index;
+    StringLineReader reader("# XCSoar task index v0\n"
+                            "F 1 2 /a.tsk\n"
+                            "N \n");
+    index.Load(reader);
+    ok1(index.empty());
+  }
+
+  TaskIndex index;
+  StringLineReader reader("# XCSoar task index v1\n"
+                          "N orphan\n"
+                          "F 1 /b.tsk\n"
+                          "N skipped\n"
+                          "F x 2 /c.tsk\n"
+                          "F 1 2 \n"
+                          "garbage\n"
+                          "F 3 4 /d tsk/with spaces.tsk\n"
+                          "N first\n"
+                          "N second\n");
+  index.Load(reader);
+  ok1(index.size() == 1);
+
+  const auto *entry = index.Lookup(Path(_T("/d tsk/with spaces.tsk")), 3, 4);
+  ok1(entry != nullptr && entry->names.size() == 2);
+  ok1(entry != nullptr && entry->names[0] == _T("first"));
+}
+
+static void
+TestMultiLineName()
+{
+  TaskIndex index;
+  index.Set(Path(_T("/a.tsk")), 1, 1, {_T("good")});
+  index.Set(Path(_T("/b.tsk")), 1, 1, {_T("bad\nname")});
+
+  TaskIndex loaded;
+  StringLineReader reader(Save(index));
+  loaded.Load(reader);
+
+  /* the entry which cannot be represented is not saved */
+  ok1(loaded.size() == 1);
+  ok1(loaded.Lookup(Path(_T("/a.tsk")), 1, 1) != nullptr);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(40);
+
+  TestLookup();
+  TestScan();
+  TestScanExtensions();
+  TestRoundTrip();
+  TestMalformed();
+  TestMultiLineName();
+
+  return exit_status();
+}
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Computer/ThermalLocator.hpp"
+#include "NMEA/ThermalLocator.hpp"
+#include "Geo/Math.hpp"
+#include "Geo/SpeedVector.hpp"
+#include "Geo/Flat/FlatProjection.hpp"
+#include "Geo/Flat/FlatPoint.hpp"
+#include "Math/FastMath.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+
+/**
+ * The previous implementation, which drifts and projects each sample
+ * onto a flat plane; used as reference.
+ */
+class ReferenceLocator {
+  struct Point {
+    GeoPoint location;
+    FlatPoint loc_drift;
+    double t_0, w, lift_weight, recency_weight;
+  };
+
+  Point points[ThermalLocator::TLOCATOR_NMAX];
+  unsigned n_index = 0, n_points = 0;
+
+public:
+  void Process(double t, const GeoPoint &location, double w,
+               SpeedVector wind, ThermalLocatorInfo &therm) {
+    points[n_index].location = location;
+    points[n_index].t_0 = t;
+    points[n_index].w = std::max(w, -0.1);
+    n_index = (n_index + 1) % ThermalLocator::TLOCATOR_NMAX;
+    if (n_points < ThermalLocator::TLOCATOR_NMAX)
+      n_points++;
+
+    if (n_points < ThermalLocator::TLOCATOR_NMIN) {
+      therm.estimate_valid = false;
+      return;
+    }
+
+    GeoPoint dloc = FindLatitudeLongitude(location, wind.bearing, wind.norm);
+    const FlatProjection projection(location);
+    const GeoPoint traildrift = location - dloc;
+
+    FlatPoint av(0, 0);
+    double acc = 0;
+    for (unsigned i = 0; i < n_points; ++i) {
+      Point &p = points[i];
+      const auto dt = t - p.t_0;
+      p.recency_weight = thermal_recency_fn((unsigned)fabs(dt));
+      p.lift_weight = p.w * p.recency_weight;
+      p.loc_drift = projection.ProjectFloat(p.location + traildrift * dt);
+      av += p.loc_drift * p.recency_weight;
+      acc += p.recency_weight;
+    }
+
+    av = av * (1. / acc);
+
+    FlatPoint f0(0, 0);
+    acc = 0;
+    for (unsigned i = 0; i < n_points; ++i) {
+      f0 += (points[i].loc_drift - av) * points[i].lift_weight;
+      acc += points[i].lift_weight;
+    }
+
+    if (acc <= 0) {
+      therm.estimate_valid = false;
+      return;
+    }
+
+    therm.estimate_location = projection.Unproject(f0 * (1. / acc) + av);
+    therm.estimate_valid = true;
+  }
+};
+
+static void
+TestCircling(const GeoPoint center, const SpeedVector wind)
+{
+  ThermalLocator locator;
+  locator.Reset();
+  ReferenceLocator reference;
+
+  ThermalLocatorInfo a, b;
+  a.estimate_valid = b.estimate_valid = false;
+
+  bool equal = true, valid = true;
+  double max_distance = 0, core_distance = 0;
+
+  /* circle with a radius of 100 m around a point 50 m off the
+     thermal core, drifting with the wind; the estimate is pulled
+     towards the core */
+  const GeoPoint core_0 = center;
+  for (unsigned t = 1; t <= 200; ++t) {
+    const GeoPoint core = FindLatitudeLongitude(core_0, wind.bearing.Reciprocal(),
+                                                wind.norm * t);
+    const GeoPoint circle = FindLatitudeLongitude(core, Angle::Zero(), 50);
+    const GeoPoint location =
+      FindLatitudeLongitude(circle, Angle::Degrees(t * 18.), 100);
+    const double w = 2.5 - location.DistanceS(core) / 100;
+
+    locator.Process(true, t, location, w, wind, a);
+    reference.Process(t, location, w, wind, b);
+
+    if (a.estimate_valid != b.estimate_valid) {
+      equal = false;
+      continue;
+    }
+
+    if (!a.estimate_valid) {
+      valid = valid && t < ThermalLocator::TLOCATOR_NMIN;
+      continue;
+    }
+
+    max_distance = std::max(max_distance,
+                            a.estimate_location.DistanceS(b.estimate_location));
+    core_distance = a.estimate_location.DistanceS(core);
+  }
+
+  ok1(equal);
+  ok1(valid);
+  ok(max_distance < 0.01, "numerically equivalent (%g m)", max_distance);
+  ok1(core_distance < 40);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  TestCircling(GeoPoint(Angle::Degrees(7.7), Angle::Degrees(51.05)),
+               SpeedVector(Angle::Degrees(270), 5));
+  TestCircling(GeoPoint(Angle::Degrees(-179.999), Angle::Degrees(-45)),
+               SpeedVector(Angle::Degrees(90), 10));
+  TestCircling(GeoPoint(Angle::Degrees(146.35), Angle::Degrees(-35.9)),
+               SpeedVector(Angle::Zero(), 0));
+
+  return exit_status();
+}
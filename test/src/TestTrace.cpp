@@ -20,10 +20,9 @@
 }
 */
 
-#include "IGC/IGCParser.hpp"
+#include "IGC/IGCFixReader.hpp"
 #include "IGC/IGCFix.hpp"
-#include "IGC/IGCExtensions.hpp"
-#include "io/FileLineReader.hpp"
+#include "system/FileMapping.hpp"
 #include "system/ConvertPathName.hpp"
 #include "Engine/Trace/Trace.hpp"
 #include "Engine/Trace/Vector.hpp"
@@ -32,6 +31,7 @@
 #include "util/PrintException.hxx"
 
 #include <windef.h>
+#include <tchar.h>
 #include <cassert>
 #include <cstdio>
 
@@ -53,30 +53,31 @@ OnAdvance(Trace &trace, const GeoPoint &loc, const double alt, const double t)
 static bool
 TestTrace(Path filename, unsigned ntrace, bool output=false)
 {
-  FileLineReaderA reader(filename);
+  FileMapping mapping(filename);
+  IGCFixReader reader({mapping.data(), mapping.size()});
 
   printf("# %d", ntrace);  
   Trace trace(1000, ntrace);
 
-  IGCExtensions extensions;
-  extensions.clear();
-
-  char *line;
+  IGCFix fixes[256];
+  unsigned n;
   int i = 0;
-  for (; (line = reader.ReadLine()) != NULL; i++) {
-    if (output && (i % 500 == 0)) {
-      putchar('.');
-      fflush(stdout);
-    }
+  while ((n = reader.Read(fixes, 256)) > 0) {
+    for (unsigned j = 0; j < n; ++j, ++i) {
+      if (output && (i % 500 == 0)) {
+        putchar('.');
+        fflush(stdout);
+      }
 
-    IGCFix fix;
-    if (!IGCParseFix(line, extensions, fix) || !fix.gps_valid)
-      continue;
+      const IGCFix &fix = fixes[j];
+      if (!fix.gps_valid)
+        continue;
 
-    OnAdvance(trace,
-               fix.location,
-               fix.gps_altitude,
-               fix.time.GetSecondOfDay());
+      OnAdvance(trace,
+                fix.location,
+                fix.gps_altitude,
+                fix.time.GetSecondOfDay());
+    }
   }
   putchar('\n');
   printf("# samples %d\n", i);
@@ -0,0 +1,106 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "util/TripleBuffer.hxx"
+#include "TestUtil.hpp"
+
+#include <thread>
+
+struct Sample {
+  unsigned a, b, c;
+};
+
+static void
+TestSingleThread()
+{
+  TripleBuffer<Sample> buffer(Sample{0, 0, 0});
+
+  ok1(!buffer.Update());
+  ok1(buffer.GetFront().a == 0);
+
+  buffer.Publish({1, 2, 3});
+  ok1(buffer.Update());
+  ok1(buffer.GetFront().a == 1 && buffer.GetFront().c == 3);
+  ok1(!buffer.Update());
+  ok1(buffer.GetFront().a == 1);
+
+  /* only the latest value is seen */
+  buffer.Publish({4, 5, 6});
+  buffer.Publish({7, 8, 9});
+  ok1(buffer.Update());
+  ok1(buffer.GetFront().a == 7 && buffer.GetFront().b == 8);
+  ok1(!buffer.Update());
+
+  /* GetBack() + Publish() */
+  buffer.GetBack() = Sample{10, 11, 12};
+  buffer.Publish();
+  ok1(buffer.Update());
+  ok1(buffer.GetFront().a == 10);
+}
+
+static void
+TestThreads()
+{
+  static constexpr unsigned N = 1000000;
+
+  TripleBuffer<Sample> buffer(Sample{0, 0, 0});
+
+  std::thread producer([&buffer](){
+    for (unsigned i = 1; i <= N; ++i)
+      buffer.Publish({i, i * 3, ~i});
+  });
+
+  unsigned last = 0, n_updates = 0;
+  bool torn = false, backwards = false;
+  while (last < N) {
+    if (!buffer.Update())
+      continue;
+
+    const Sample &s = buffer.GetFront();
+    if (s.b != s.a * 3 || s.c != ~s.a)
+      torn = true;
+    if (s.a <= last)
+      backwards = true;
+
+    last = s.a;
+    ++n_updates;
+  }
+
+  producer.join();
+
+  ok1(!torn);
+  ok1(!backwards);
+  ok1(n_updates > 0);
+  ok1(!buffer.Update());
+}
+
+int
+main()
+{
+  plan_tests(11 + 4);
+
+  TestSingleThread();
+  TestThreads();
+
+  return exit_status();
+}
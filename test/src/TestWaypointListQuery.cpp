@@ -0,0 +1,208 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Waypoint/WaypointListQuery.hpp"
+#include "Waypoint/WaypointListBuilder.hpp"
+#include "Waypoint/WaypointList.hpp"
+#include "Waypoint/WaypointFilter.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "util/Macros.hpp"
+#include "TestUtil.hpp"
+
+static const GeoPoint location(Angle::Degrees(7), Angle::Degrees(51));
+
+static const TCHAR *const syllables[] = {
+  _T("Ab"), _T("ab"), _T("Ba"), _T("be"), _T("C-"), _T("ce"),
+  _T("A.b"), _T("x"), _T("1"), _T(" "),
+};
+
+static void
+AddWaypoints(Waypoints &waypoints, unsigned n)
+{
+  unsigned seed = 42;
+  auto next = [&seed](unsigned max){
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % max;
+  };
+
+  for (unsigned i = 0; i < n; ++i) {
+    const GeoPoint point(Angle::Degrees(6 + next(2000) / 1000.),
+                         Angle::Degrees(50 + next(2000) / 1000.));
+    Waypoint wp(point);
+
+    const unsigned length = 1 + next(5);
+    for (unsigned j = 0; j < length; ++j)
+      wp.name += syllables[next(ARRAY_SIZE(syllables))];
+
+    if (next(3) == 0)
+      wp.type = Waypoint::Type::AIRFIELD;
+    wp.flags.turn_point = next(2) == 0;
+
+    waypoints.Append(std::move(wp));
+  }
+
+  waypoints.Optimise();
+}
+
+static bool
+operator==(const WaypointList &a, const WaypointList &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (a[i].waypoint != b[i].waypoint)
+      return false;
+
+  return true;
+}
+
+/**
+ * Build the list from scratch, the way the waypoint list dialog used
+ * to do it.
+ */
+static WaypointList
+FullQuery(const Waypoints &waypoints, const WaypointFilter &filter)
+{
+  WaypointList list;
+  WaypointListBuilder builder(filter, location, list, nullptr, 0);
+  builder.Visit(waypoints);
+
+  if (filter.distance > 0 || !filter.direction.IsNegative())
+    list.SortByDistance(location);
+
+  return list;
+}
+
+static WaypointFilter
+MakeFilter(const TCHAR *name, double distance, Angle direction,
+           TypeFilter type=TypeFilter::ALL)
+{
+  WaypointFilter filter;
+  filter.Clear();
+  filter.name = name;
+  filter.distance = distance;
+  filter.direction = direction;
+  filter.type_index = type;
+  return filter;
+}
+
+/**
+ * Type the given name character by character, checking that each
+ * step after the first reuses the previous result and matches a full
+ * query.
+ */
+static void
+TestTyping(const Waypoints &waypoints, double distance, Angle direction,
+           TypeFilter type, const TCHAR *name)
+{
+  WaypointListQuery query(location, nullptr, 0);
+  WaypointList list;
+
+  const size_t length = _tcslen(name);
+  for (size_t i = 0; i <= length; ++i) {
+    StaticString<WaypointFilter::NAME_LENGTH + 1> prefix;
+    prefix.assign(name, i);
+
+    const auto filter = MakeFilter(prefix, distance, direction, type);
+    const bool reused = query.Update(waypoints, filter, list);
+    if (i > 0)
+      ok1(reused);
+    ok1(list == FullQuery(waypoints, filter));
+  }
+}
+
+static void
+TestRefinement()
+{
+  WaypointFilter a = MakeFilter(_T("ab"), 0, Angle::Native(-1));
+  ok1(a.IsRefinementOf(a));
+  ok1(MakeFilter(_T("ABc"), 0, Angle::Native(-1)).IsRefinementOf(a));
+  ok1(!MakeFilter(_T("a"), 0, Angle::Native(-1)).IsRefinementOf(a));
+  ok1(!MakeFilter(_T("ac"), 0, Angle::Native(-1)).IsRefinementOf(a));
+  ok1(!MakeFilter(_T("abc"), 10000, Angle::Native(-1)).IsRefinementOf(a));
+  ok1(!MakeFilter(_T("abc"), 0, Angle::Degrees(90)).IsRefinementOf(a));
+  ok1(!MakeFilter(_T("abc"), 0, Angle::Native(-1),
+                  TypeFilter::AIRPORT).IsRefinementOf(a));
+}
+
+static void
+TestInvalidation(Waypoints &waypoints)
+{
+  WaypointListQuery query(location, nullptr, 0);
+  WaypointList list;
+
+  const auto filter = MakeFilter(_T("a"), 0, Angle::Native(-1));
+  ok1(!query.Update(waypoints, filter, list));
+  ok1(query.Update(waypoints, filter, list));
+
+  /* shortening the name needs a new query */
+  const auto shorter = MakeFilter(_T(""), 0, Angle::Native(-1));
+  ok1(!query.Update(waypoints, shorter, list));
+  ok1(list == FullQuery(waypoints, shorter));
+
+  ok1(query.Update(waypoints, filter, list));
+  ok1(list == FullQuery(waypoints, filter));
+
+  query.Invalidate();
+  ok1(!query.Update(waypoints, filter, list));
+
+  /* modifying the database needs a new query */
+  Waypoint wp(location);
+  wp.name = _T("Abacus");
+  waypoints.Append(std::move(wp));
+  waypoints.Optimise();
+
+  const auto longer = MakeFilter(_T("ab"), 0, Angle::Native(-1));
+  ok1(!query.Update(waypoints, longer, list));
+  ok1(list == FullQuery(waypoints, longer));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(7 + 13 + 9 + 5 + 3 + 1 + 9);
+
+  Waypoints waypoints;
+  AddWaypoints(waypoints, 2000);
+
+  TestRefinement();
+
+  /* name tree lookup (normalised prefix) */
+  TestTyping(waypoints, 0, Angle::Native(-1), TypeFilter::ALL,
+             _T("a.B-ab"));
+  /* distance filter (case-insensitive prefix), sorted by distance */
+  TestTyping(waypoints, 100000, Angle::Native(-1), TypeFilter::ALL,
+             _T("Abab"));
+  /* direction filter, sorted by distance */
+  TestTyping(waypoints, 0, Angle::Degrees(200), TypeFilter::TURNPOINT,
+             _T("ba"));
+  TestTyping(waypoints, 50000, Angle::Degrees(20), TypeFilter::AIRPORT,
+             _T("c"));
+
+  ok1(FullQuery(waypoints, MakeFilter(_T("ab"), 0,
+                                      Angle::Native(-1))).size() > 10);
+
+  TestInvalidation(waypoints);
+
+  return exit_status();
+}
@@ -0,0 +1,245 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2021 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "XML/PullParser.hpp"
+#include "XML/FlatDocument.hpp"
+#include "XML/DataNodeFlat.hpp"
+#include "XML/DataNodeXML.hpp"
+#include "XML/Parser.hpp"
+#include "XML/Node.hpp"
+#include "util/StringAPI.hxx"
+#include "TestUtil.hpp"
+
+#include <stdexcept>
+
+using XML::PullParser;
+using Event = PullParser::Event;
+
+static bool
+Equals(TStringView a, const TCHAR *b)
+{
+  return a.Equals(b);
+}
+
+static void
+TestEvents()
+{
+  static constexpr TCHAR xml[] =
+    _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n")
+    _T("<!-- comment <with> markup -->\n")
+    _T("<Task type=\"AAT\" name='a &amp; b'>\n")
+    _T("  <Point type=\"Start\"/>\n")
+    _T("  <Note>some text</Note>\n")
+    _T("  <Raw><![CDATA[<&>]]></Raw>\n")
+    _T("</TASK>\n");
+
+  PullParser parser(xml);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(Equals(parser.GetName(), _T("Task")));
+  ok1(parser.GetAttributes().size() == 2);
+  ok1(Equals(parser.GetAttribute(_T("TYPE")), _T("AAT")));
+  ok1(Equals(parser.GetAttribute(_T("name")), _T("a &amp; b")));
+  ok1(parser.GetAttribute(_T("missing")).IsNull());
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(Equals(parser.GetName(), _T("Point")));
+  ok1(Equals(parser.GetAttribute(_T("type")), _T("Start")));
+  ok1(parser.Next() == Event::END_ELEMENT);
+  ok1(Equals(parser.GetName(), _T("Point")));
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.GetAttributes().empty());
+  ok1(parser.Next() == Event::TEXT);
+  ok1(Equals(parser.GetText(), _T("some text")));
+  ok1(parser.IsTextEscaped());
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.Next() == Event::TEXT);
+  ok1(Equals(parser.GetText(), _T("<&>")));
+  ok1(!parser.IsTextEscaped());
+  ok1(parser.Next() == Event::END_ELEMENT);
+
+  /* end tags are matched case-insensitively */
+  ok1(parser.Next() == Event::END_ELEMENT);
+  ok1(parser.Next() == Event::END);
+  ok1(parser.Next() == Event::END);
+}
+
+static void
+TestSkipElement()
+{
+  PullParser parser(_T("<a><b><c/><d>x</d></b><e/></a>"));
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(Equals(parser.GetName(), _T("b")));
+  parser.SkipElement();
+  ok1(parser.Next() == Event::START_ELEMENT);
+  ok1(Equals(parser.GetName(), _T("e")));
+}
+
+static bool
+Fails(const TCHAR *xml)
+try {
+  PullParser parser(xml);
+  while (parser.Next() != Event::END) {}
+  return false;
+} catch (const std::runtime_error &) {
+  return true;
+}
+
+static void
+TestErrors()
+{
+  ok1(!Fails(_T("<a b=\"c\"><d/></a>")));
+  ok1(Fails(_T("<a><b></a>")));
+  ok1(Fails(_T("<a></b>")));
+  ok1(Fails(_T("<a b=c/>")));
+  ok1(Fails(_T("<a b/>")));
+  ok1(Fails(_T("<a b=\"c/>")));
+  ok1(Fails(_T("<a>")));
+  ok1(Fails(_T("<a><!-- x</a>")));
+  ok1(Fails(_T("<a/ >")));
+}
+
+static bool
+UnescapeEquals(const TCHAR *src, const TCHAR *expected)
+{
+  TCHAR buffer[64];
+  TCHAR *end = XML::Unescape(src, buffer);
+  if (end == nullptr)
+    return expected == nullptr;
+
+  return expected != nullptr && TStringView(buffer, end).Equals(expected);
+}
+
+static void
+TestUnescape()
+{
+  ok1(UnescapeEquals(_T(""), _T("")));
+  ok1(UnescapeEquals(_T("plain"), _T("plain")));
+  ok1(UnescapeEquals(_T("&lt;&gt;&amp;&apos;&quot;"), _T("<>&'\"")));
+  ok1(UnescapeEquals(_T("&LT;x&Amp;"), _T("<x&")));
+  ok1(UnescapeEquals(_T("&#65;&#x42;&#X43;"), _T("ABC")));
+  ok1(UnescapeEquals(_T("a&#0;b"), _T("a b")));
+#ifndef _UNICODE
+  ok1(UnescapeEquals(_T("&#228;"), "\xc3\xa4"));
+#else
+  ok1(UnescapeEquals(_T("&#228;"), L"ä"));
+#endif
+  ok1(UnescapeEquals(_T("&foo;"), nullptr));
+  ok1(UnescapeEquals(_T("&amp"), nullptr));
+  ok1(UnescapeEquals(_T("&#;"), nullptr));
+  ok1(UnescapeEquals(_T("&#12a;"), nullptr));
+}
+
+static constexpr TCHAR task_xml[] =
+  _T("<?xml version=\"1.0\"?>\n")
+  _T("<Task type=\"RT\" aat_min_time=\"10800\">\n")
+  _T("\t<Point type=\"Start\">\n")
+  _T("\t\t<Waypoint name=\"A &amp; B\" comment=\"&lt;1&gt;\" altitude=\"74\">\n")
+  _T("\t\t\t<Location longitude=\"6.39361\" latitude=\"51.1011\"/>\n")
+  _T("\t\t</Waypoint>\n")
+  _T("\t\t<ObservationZone type=\"Cylinder\" radius=\"1000\"/>\n")
+  _T("\t</Point>\n")
+  _T("\t<Point type=\"Turn\"><Waypoint name=\"C\"/></Point>\n")
+  _T("\t<Other/>\n")
+  _T("\t<Point type=\"Finish\"><Waypoint name=\"D\"/></Point>\n")
+  _T("</Task>\n")
+  _T("<Trailing/>\n");
+
+/**
+ * Query the same information from both #ConstDataNode
+ * implementations.
+ */
+static void
+TestDataNode(const ConstDataNode &root)
+{
+  ok1(StringIsEqual(root.GetName(), _T("Task")));
+  ok1(StringIsEqual(root.GetAttribute(_T("type")), _T("RT")));
+
+  unsigned aat_min_time;
+  ok1(root.GetAttribute(_T("aat_min_time"), aat_min_time) &&
+      aat_min_time == 10800);
+
+  ok1(root.ListChildren().size() == 4);
+
+  const auto points = root.ListChildrenNamed(_T("point"));
+  ok1(points.size() == 3);
+  ok1(StringIsEqual(points.back()->GetAttribute(_T("type")), _T("Finish")));
+
+  const auto wp = points.front()->GetChildNamed(_T("Waypoint"));
+  ok1(wp != nullptr);
+  ok1(StringIsEqual(wp->GetAttribute(_T("name")), _T("A & B")));
+  ok1(StringIsEqual(wp->GetAttribute(_T("comment")), _T("<1>")));
+  ok1(wp->GetAttribute(_T("missing")) == nullptr);
+
+  const auto location = wp->GetChildNamed(_T("Location"));
+  double latitude;
+  ok1(location != nullptr &&
+      location->GetAttribute(_T("latitude"), latitude) &&
+      latitude > 51.1 && latitude < 51.102);
+
+  ok1(root.GetChildNamed(_T("Trailing")) == nullptr);
+  ok1(points.front()->GetChildNamed(_T("Missing")) == nullptr);
+}
+
+static void
+TestFlatDocument()
+{
+  const XMLNode xml_root = XML::ParseString(task_xml);
+  TestDataNode(ConstDataNodeXML(xml_root));
+
+  const XML::FlatDocument document(task_xml);
+  TestDataNode(ConstDataNodeFlat(document, document.GetRoot()));
+
+  bool failed = false;
+  try {
+    XML::FlatDocument empty(_T("<?xml version=\"1.0\"?>\n"));
+  } catch (const std::runtime_error &) {
+    failed = true;
+  }
+  ok1(failed);
+
+  failed = false;
+  try {
+    XML::FlatDocument bad(_T("<a b=\"&bad;\"/>"));
+  } catch (const std::runtime_error &) {
+    failed = true;
+  }
+  ok1(failed);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(78);
+
+  TestEvents();
+  TestSkipElement();
+  TestErrors();
+  TestUnescape();
+  TestFlatDocument();
+
+  return exit_status();
+}
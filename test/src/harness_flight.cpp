@@ -130,6 +130,8 @@ run_flight(TestFlightComponents components, TaskManager &task_manager,
   aircraft.Start(autopilot.location_start, autopilot.location_previous,
                  parms.start_alt);
 
+  task_manager.GetFactory().UpdateGeometry();
+
   AirspaceWarningManager *airspace_warnings;
   if (airspaces) {
     AirspaceWarningConfig airspace_warning_config;
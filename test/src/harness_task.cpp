@@ -894,43 +894,23 @@ bool test_task_random(TaskManager& task_manager,
   return true;
 }
 
-bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
-                      const Waypoints &waypoints,
-                      const unsigned _num_points)
+bool test_task_random_type(TaskManager& task_manager,
+                           const Waypoints &waypoints,
+                           const TaskFactoryType type,
+                           const unsigned num_points_total)
 {
   WaypointPtr wp;
 
-  char tmp[255];
-  char tskType[20];
-  tskType[0] = '\0';
-
-
-  switch (rand() %3) {
-  case 0:
-    task_manager.SetFactory(TaskFactoryType::AAT);
-    strcpy(tskType,"AAT");
-    test_note("# creating random AAT task\n");
-    break;
-  case 1:
-    task_manager.SetFactory(TaskFactoryType::RACING);
-    strcpy(tskType,"RT");
-    test_note("# creating random RT task\n");
-    break;
-  case 2:
-    task_manager.SetFactory(TaskFactoryType::FAI_GENERAL);
-    strcpy(tskType,"FAI");
-    test_note("# creating random FAI GENERAL\n");
-    break;
-  }
-
+  task_manager.SetFactory(type);
   AbstractTaskFactory &fact = task_manager.GetFactory();
 
-  //max points includes start & finish
   const TaskFactoryConstraints &constraints =
     task_manager.GetOrderedTask().GetFactoryConstraints();
-  const unsigned num_points_total =
-    std::max(constraints.min_points,
-             _num_points % constraints.max_points) + 1;
+  if (num_points_total < 2 ||
+      num_points_total < constraints.min_points ||
+      num_points_total > constraints.max_points)
+    return false;
+
   const unsigned num_int_points = num_points_total - 2;
 
   test_note("# adding start\n");
@@ -990,6 +970,49 @@ bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
       return false;
   }
   task_manager.Resume();
+  return true;
+}
+
+bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
+                      const Waypoints &waypoints,
+                      const unsigned _num_points)
+{
+  char tmp[255];
+  char tskType[20];
+  tskType[0] = '\0';
+
+  TaskFactoryType type = TaskFactoryType::RACING;
+
+  switch (rand() %3) {
+  case 0:
+    type = TaskFactoryType::AAT;
+    strcpy(tskType,"AAT");
+    test_note("# creating random AAT task\n");
+    break;
+  case 1:
+    type = TaskFactoryType::RACING;
+    strcpy(tskType,"RT");
+    test_note("# creating random RT task\n");
+    break;
+  case 2:
+    type = TaskFactoryType::FAI_GENERAL;
+    strcpy(tskType,"FAI");
+    test_note("# creating random FAI GENERAL\n");
+    break;
+  }
+
+  task_manager.SetFactory(type);
+
+  //max points includes start & finish
+  const TaskFactoryConstraints &constraints =
+    task_manager.GetOrderedTask().GetFactoryConstraints();
+  const unsigned num_points_total =
+    std::max(constraints.min_points,
+             _num_points % constraints.max_points) + 1;
+
+  if (!test_task_random_type(task_manager, waypoints, type, num_points_total))
+    return false;
+
   sprintf(tmp, "# SUCCESS CREATING %s task! task_size():%d..\n",
       tskType,
       task_manager.TaskSize());
@@ -70,6 +70,18 @@ bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
                       const Waypoints &waypoints,
                       const unsigned num_points);
 
+/**
+ * Generates a random task of the given factory type with exactly
+ * num_points_total points (including start and finish), using random
+ * waypoints and random legal start/intermediate/finish types.
+ * Returns false if the size is outside the factory's constraints or
+ * the resulting task fails validation.
+ */
+bool test_task_random_type(TaskManager& task_manager,
+                           const Waypoints &waypoints,
+                           TaskFactoryType type,
+                           unsigned num_points_total);
+
 bool test_task(TaskManager& task_manager,
                const Waypoints &waypoints,
                int test_num);
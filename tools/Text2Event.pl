@@ -3,7 +3,13 @@
 use strict;
 use warnings;
 
+# the output is sorted by name, because InputEvents::findEvent() does
+# a binary search
+my @names;
 while (<>) {
-    print qq'{ _T("$1"), &InputEvents::event$1 },\n'
-      if /^\s*void event([a-zA-Z0-9]+)/;
+    push @names, $1 if /^\s*void event([a-zA-Z0-9]+)/;
+}
+
+foreach my $name (sort @names) {
+    print qq'{ _T("$name"), &InputEvents::event$name },\n';
 }